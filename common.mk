@@ -297,6 +297,81 @@ $(VV)mkdir -p $(dir $(LDTIMEOBJ))
 $(call test_output_2,Adding timestamp ,echo 'const int _PROS_COMPILE_TIMESTAMP_INT = $(shell echo $$(($$(date +%s)+($$(date +%-z)/100*3600)))); char const * const _PROS_COMPILE_TIMESTAMP = __DATE__ " " __TIME__; char const * const _PROS_COMPILE_DIRECTORY = "$(wildcard $(shell pwd | tail -c 23))";' | $(CC) -c -x c $(CFLAGS) $(EXTRA_CFLAGS) -o $(LDTIMEOBJ) -,$(OK_STRING))
 endef
 
+# Host simulation target. Builds src/ together with the fake PROS kernel in host/ using
+# the native compiler, so routines can run against a virtual clock and a physics model
+# instead of a brain.
+HOSTDIR=$(ROOT)/host
+HOSTBINDIR=$(BINDIR)/host
+HOST_BIN:=$(HOSTBINDIR)/sim
+HOSTCXX?=g++
+HOSTCXXFLAGS=-O2 -g --std=$(CXX_STANDARD) -pthread -D_PROS_KERNEL_SUPPRESS_LLEMU_WARNING $(WARNFLAGS)
+HOSTINCLUDE=-I"$(HOSTDIR)/include" $(INCLUDE)
+HOSTSRC=$(call rwildcard, $(HOSTDIR)/src,*.cpp) $(call CXXSRC)
+HOSTOBJ=$(addprefix $(HOSTBINDIR)/,$(patsubst $(ROOT)/%,%.o,$(HOSTSRC))) $(addprefix $(HOSTBINDIR)/,$(addsuffix .o,$(ASSET_FILES)))
+HOSTLD?=ld
+HOSTOBJCOPY?=objcopy
+# the gain tuner drives LemLib's chassis in the simulation, like the benchmarks below
+TUNER_BIN:=$(HOSTBINDIR)/tuner
+TUNERSRC=$(call rwildcard, $(HOSTDIR)/tuner,*.cpp)
+TUNEROBJ=$(addprefix $(HOSTBINDIR)/,$(patsubst $(ROOT)/%,%.o,$(TUNERSRC)))
+# the trajectory generator only needs the asset format and LemLib's velocity planning
+TRAJGEN_BIN:=$(HOSTBINDIR)/trajgen
+TRAJGENSRC=$(call rwildcard, $(HOSTDIR)/trajgen,*.cpp) $(addprefix $(SRCDIR)/lemlib/,pose.cpp trajectoryGenerator.cpp)
+TRAJGENOBJ=$(addprefix $(HOSTBINDIR)/,$(patsubst $(ROOT)/%,%.o,$(TRAJGENSRC)))
+# every file in host/bench is its own benchmark, linked against the fake kernel and LemLib
+BENCHSRC=$(call rwildcard, $(HOSTDIR)/bench,*.cpp)
+BENCH_BINS=$(patsubst $(HOSTDIR)/bench/%.cpp,$(HOSTBINDIR)/bench/%,$(BENCHSRC))
+# plus the robot's own code that has no globals, so its benchmarks can link it
+BENCHLIBSRC=$(filter-out %/runner.cpp,$(call rwildcard, $(HOSTDIR)/src,*.cpp)) $(call rwildcard, $(SRCDIR)/lemlib,*.cpp) \
+            $(SRCDIR)/colorSorter.cpp
+BENCHLIBOBJ=$(addprefix $(HOSTBINDIR)/,$(patsubst $(ROOT)/%,%.o,$(BENCHLIBSRC)))
+
+.PHONY: host sim tune trajectory bench
+
+host: $(HOST_BIN) $(TUNER_BIN) $(TRAJGEN_BIN)
+
+# SIM_ARGS is passed to the runner, e.g. make sim SIM_ARGS="--routine right4Block --trace 100"
+sim: $(HOST_BIN)
+	$(HOST_BIN) $(SIM_ARGS)
+
+$(HOST_BIN): $(HOSTOBJ)
+	$(call test_output_2,Linking host simulation ,$(HOSTCXX) $(HOSTCXXFLAGS) -o $@ $^,$(OK_STRING))
+
+# TUNE_ARGS is passed to the tuner, e.g. make tune TUNE_ARGS="--motion angular --kd 5:20:0.5"
+tune: $(TUNER_BIN)
+	$(TUNER_BIN) $(TUNE_ARGS)
+
+$(TUNER_BIN): $(TUNEROBJ) $(BENCHLIBOBJ)
+	$(call test_output_2,Linking gain tuner ,$(HOSTCXX) $(HOSTCXXFLAGS) -o $@ $^,$(OK_STRING))
+
+# TRAJ_ARGS is passed to the generator, e.g. make trajectory TRAJ_ARGS="static/path.txt -o static/path.traj"
+trajectory: $(TRAJGEN_BIN)
+	$(TRAJGEN_BIN) $(TRAJ_ARGS)
+
+$(TRAJGEN_BIN): $(TRAJGENOBJ)
+	$(call test_output_2,Linking trajectory generator ,$(HOSTCXX) $(HOSTCXXFLAGS) -o $@ $^,$(OK_STRING))
+
+# runs every benchmark, BENCH=name runs just one
+bench: $(if $(BENCH),$(HOSTBINDIR)/bench/$(BENCH),$(BENCH_BINS))
+	$(VV)set -e; for benchmark in $^; do echo "== $$(basename $$benchmark)"; $$benchmark; done
+
+# keep each benchmark's object between runs. These are listed by name, since make drops the leading ./ of
+# BINDIR from targets and a pattern with it would never match
+.SECONDARY: $(patsubst $(ROOT)/%,$(HOSTBINDIR)/%.o,$(BENCHSRC))
+$(HOSTBINDIR)/bench/%: $(HOSTBINDIR)/host/bench/%.cpp.o $(BENCHLIBOBJ)
+	$(VV)mkdir -p $(dir $@)
+	$(call test_output_2,Linking benchmark $* ,$(HOSTCXX) $(HOSTCXXFLAGS) -o $@ $^,$(OK_STRING))
+
+$(HOSTBINDIR)/static/%.o: static/%
+	$(VV)mkdir -p $(dir $@)
+	$(call test_output_2,Creating asset $< for host ,$(HOSTLD) -r -z noexecstack -b binary -o $@ $< && $(HOSTOBJCOPY) --set-section-alignment .data=8 $@,$(OK_STRING))
+
+$(HOSTBINDIR)/%.o: %
+	$(VV)mkdir -p $(dir $@)
+	$(call test_output_2,Compiled $< for host ,$(HOSTCXX) -c $(HOSTINCLUDE) $(HOSTCXXFLAGS) -MMD -MP -o $@ $<,$(OK_STRING))
+
+-include $(HOSTOBJ:.o=.d) $(TUNEROBJ:.o=.d) $(TRAJGENOBJ:.o=.d) $(patsubst $(ROOT)/%,$(HOSTBINDIR)/%.d,$(BENCHSRC))
+
 # these rules are for build-compile-commands, which just print out sysroot information
 cc-sysroot:
 	@echo | $(CC) -c -x c $(CFLAGS) $(EXTRA_CFLAGS) --verbose -o /dev/null -
@@ -0,0 +1,254 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "colorSorter.hpp"
+
+/**
+ * Replays optical traces through ColorSorter and scores how many blocks it sorts right.
+ * Each trace row is one millisecond: the optical reading if the scheduler took one then, the
+ * measured indexer velocity, and the color of any block whose leading edge reached the ejector.
+ * The sorter runs every 5 ms like the color sort task, and an ejection catches a block if the
+ * ejector is in place before the block is an inch past it, and stays out until all but its last inch is.
+ *
+ * With no arguments, traces are generated at several indexer speeds: blocks of random colors and
+ * spacing, slipping a little on the rollers, read with hue and proximity noise. The predictive
+ * sorter is compared with firing a fixed delay after a block is seen, tuned for full speed.
+ * A block whose readings are split evenly between the colors is also checked to never be ejected.
+ * Pass a CSV of time_ms,hue,saturation,proximity,indexer_rpm,arrival rows to replay a recording
+ * instead, with hue -1 on rows without a reading and arrival 0 none, 1 red or 2 blue
+ */
+
+namespace {
+struct Row {
+        std::uint32_t time; // ms
+        bool hasReading;
+        lemlib::OpticalSample reading;
+        float rpm; // measured indexer velocity
+        BlockColor arrival; // block reaching the ejector now
+};
+
+// the robot, as src/colorSortTask.cpp sets it up
+const ColorSortSettings SETTINGS = {.distanceToEjector = 6, .rollerDiameter = 2, .slip = 0.9,
+                                    .ejectLatency = 20, .blockLength = 3, .nominalRpm = 600};
+constexpr float MAX_EJECT_TIME = 300; // ms
+constexpr float FIXED_EJECT_TIME = 150; // ms the fixed delay sorter holds the ejector out
+constexpr float BLOCK_LENGTH = 3; // inches
+constexpr float LATE_SLACK = 1; // inches a block can be past the ejector and still be caught
+constexpr BlockColor REJECT = BlockColor::BLUE;
+
+/**
+ * @brief Record a trace of blocks going up the intake with the indexer at some speed
+ */
+std::vector<Row> generate(float rpm, int blocks, std::uint32_t seed) {
+    std::mt19937 random(seed);
+    std::uniform_real_distribution<float> uniform(0, 1);
+    std::normal_distribution<float> normal(0, 1);
+    struct Block {
+            float front; // inches past the sensor, of the leading edge
+            float slip;
+            BlockColor color;
+            bool arrived = false;
+    };
+    std::vector<Block> queue;
+    float nextFront = 0;
+    for (int i = 0; i < blocks; i++) {
+        queue.push_back({nextFront, 0.85f + 0.1f * uniform(random),
+                         uniform(random) < 0.5 ? BlockColor::RED : BlockColor::BLUE});
+        nextFront -= BLOCK_LENGTH + 1 + 6 * uniform(random); // a gap of 1 to 7 inches
+    }
+    std::vector<Row> rows;
+    for (std::uint32_t time = 0; !queue.empty() && queue.back().front < 20; time++) {
+        // the rollers bog down and recover as blocks load them
+        const float actual = rpm * (1 + 0.08f * std::sin(time * 0.004f) + 0.03f * normal(random));
+        Row row {time, time % 5 == 0, {}, actual * (1 + 0.02f * normal(random)), BlockColor::NONE};
+        for (std::size_t i = 0; i < queue.size(); i++) {
+            Block& block = queue[i];
+            // blocks are fed up to the sensor evenly, then slip by different amounts on the indexer. One
+            // that slips less catches up and pushes against the one ahead, but can't pass it
+            const float slip = block.front < 0 ? SETTINGS.slip : block.slip;
+            block.front += actual / 60 * SETTINGS.rollerDiameter * M_PI * slip / 1000;
+            if (i > 0) block.front = std::min(block.front, queue[i - 1].front - BLOCK_LENGTH);
+            if (!block.arrived && block.front >= SETTINGS.distanceToEjector) {
+                block.arrived = true;
+                row.arrival = block.color;
+            }
+        }
+        if (row.hasReading) {
+            // how much of the sensor's view a block fills, ramping over half an inch at each edge
+            float cover = 0;
+            const Block* seen = nullptr;
+            for (const Block& block : queue) {
+                const float inside = std::min(block.front, BLOCK_LENGTH - block.front);
+                if (inside > -0.5f && std::clamp(inside / 0.5f + 1, 0.0f, 1.0f) > cover) {
+                    cover = std::clamp(inside / 0.5f + 1, 0.0f, 1.0f);
+                    seen = &block;
+                }
+            }
+            const float blockHue = seen == nullptr ? 0 : seen->color == BlockColor::RED ? 8 : 215;
+            const float hue = cover > 0.5f ? blockHue + 10 * normal(random) : 360 * uniform(random);
+            row.reading.hue = std::fmod(hue + 360, 360.0f);
+            row.reading.saturation = std::clamp(0.1f + 0.5f * cover + 0.08f * normal(random), 0.0f, 1.0f);
+            row.reading.proximity = std::clamp(int(25 + 200 * cover + 10 * normal(random)), 0, 255);
+        }
+        rows.push_back(row);
+    }
+    return rows;
+}
+
+/**
+ * @brief Read a recorded trace, see the comment at the top for the columns
+ */
+std::vector<Row> load(const char* path) {
+    std::vector<Row> rows;
+    std::FILE* file = std::fopen(path, "r");
+    if (file == nullptr) return rows;
+    unsigned time;
+    float hue, saturation, rpm;
+    int proximity, arrival;
+    while (std::fscanf(file, "%u,%f,%f,%d,%f,%d", &time, &hue, &saturation, &proximity, &rpm, &arrival) == 6) {
+        rows.push_back({time, hue >= 0, {hue, saturation, 0, proximity}, rpm, BlockColor(arrival)});
+    }
+    std::fclose(file);
+    return rows;
+}
+
+struct Score {
+        int rejected = 0, rejectedCaught = 0;
+        int kept = 0, keptCaught = 0;
+        double timingError = 0; // ms the ejector was in place from when each rejected block arrived, summed
+        double nanoseconds = 0; // per decision
+};
+
+/**
+ * @brief Replay a trace, firing for as long as decide says, and score the ejections against the arrivals
+ */
+template <typename Decide> Score replay(const std::vector<Row>& rows, float rpm, Decide decide) {
+    std::vector<std::pair<std::uint32_t, float>> fires; // time and how long the ejector stays out
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < rows.size(); i += 5) {
+        // the newest reading the task would see on this tick
+        const Row* reading = nullptr;
+        for (std::size_t j = i >= 4 ? i - 4 : 0; j <= i; j++)
+            if (rows[j].hasReading) reading = &rows[j];
+        const float duration = decide(reading != nullptr ? &reading->reading : nullptr, rows[i].rpm, rows[i].time);
+        if (duration > 0) fires.push_back({rows[i].time, duration});
+    }
+    const auto end = std::chrono::steady_clock::now();
+    Score score;
+    score.nanoseconds = std::chrono::duration<double, std::nano>(end - start).count() / (rows.size() / 5);
+
+    // a block is ejected if the ejector is out before its first inch is past, and until all but its last
+    // inch is. A block is lost to the ejector if it's out while the block's first inch passes
+    const float speed = rpm / 60 * SETTINGS.rollerDiameter * M_PI * SETTINGS.slip / 1000; // in/ms
+    for (const Row& row : rows) {
+        if (row.arrival == BlockColor::NONE) continue;
+        const float front = row.time + LATE_SLACK / speed;
+        const float back = row.time + (BLOCK_LENGTH - LATE_SLACK) / speed;
+        bool caught = false;
+        bool touched = false;
+        float error = 0;
+        for (const auto [fire, duration] : fires) {
+            const float inPlace = fire + SETTINGS.ejectLatency;
+            if (inPlace <= front && inPlace + duration >= back) {
+                caught = true;
+                error = inPlace - row.time;
+            }
+            touched = touched || (inPlace <= front && inPlace + duration >= row.time);
+        }
+        if (row.arrival == REJECT) {
+            score.rejected++;
+            score.rejectedCaught += caught;
+            score.timingError += std::fabs(error);
+        } else {
+            score.kept++;
+            score.keptCaught += touched;
+        }
+    }
+    return score;
+}
+
+void print(const char* label, float rpm, const Score& score) {
+    std::printf("%-12s %8.0f %8d %12.1f %12.1f %10.1f %12.1f %10.0f\n", label, rpm, score.rejected + score.kept,
+                100.0 * score.rejectedCaught / std::max(score.rejected, 1),
+                100.0 * score.keptCaught / std::max(score.kept, 1),
+                100.0 * (score.rejectedCaught + score.kept - score.keptCaught) /
+                    std::max(score.rejected + score.kept, 1),
+                score.timingError / std::max(score.rejectedCaught, 1), score.nanoseconds);
+}
+
+/**
+ * @brief Score the predictive sorter, and a fixed delay if there is a nominal speed to tune it for
+ */
+void evaluate(const std::vector<Row>& rows, float rpm, float nominalRpm) {
+    ColorSorter sorter(SETTINGS);
+    sorter.setReject(REJECT);
+    print("predictive", rpm, replay(rows, rpm, [&](const lemlib::OpticalSample* reading, float measured,
+                                                   std::uint32_t time) {
+              if (!sorter.update(reading, measured, time)) return 0.0f;
+              return std::min(sorter.getEjectTime(measured), MAX_EJECT_TIME);
+          }));
+    if (nominalRpm == 0) return;
+
+    // fire a fixed time after a block of the rejected color is first seen, right at nominal speed
+    const float travel = SETTINGS.distanceToEjector /
+                         (nominalRpm / 60 * SETTINGS.rollerDiameter * M_PI * SETTINGS.slip) * 1000;
+    std::vector<std::uint32_t> pending;
+    bool inView = false;
+    print("fixed delay", rpm, replay(rows, rpm, [&](const lemlib::OpticalSample* reading, float,
+                                                    std::uint32_t time) {
+              if (reading != nullptr) {
+                  const bool present = reading->proximity >= ColorModel().minProximity;
+                  if (present && !inView && classifyBlock(*reading) == REJECT)
+                      pending.push_back(time + travel - SETTINGS.ejectLatency);
+                  inView = present;
+              }
+              if (pending.empty() || pending.front() > time) return 0.0f;
+              pending.erase(pending.begin());
+              return FIXED_EJECT_TIME;
+          }));
+}
+
+/**
+ * @brief Check that a block read as red and blue equally often is kept, whichever color is rejected
+ */
+bool keepsTies() {
+    const lemlib::OpticalSample red {8, 0.8, 0, 200};
+    const lemlib::OpticalSample blue {215, 0.8, 0, 200};
+    const lemlib::OpticalSample empty {0, 0.1, 0, 20};
+    for (const BlockColor reject : {BlockColor::RED, BlockColor::BLUE}) {
+        ColorSorter sorter(SETTINGS);
+        sorter.setReject(reject);
+        bool fired = false;
+        // two readings of each color while the block is in front of the sensor, then nothing until it's gone
+        const lemlib::OpticalSample* readings[] = {&red, &blue, &red, &blue, &empty};
+        std::uint32_t time = 0;
+        for (const lemlib::OpticalSample* reading : readings) fired |= sorter.update(reading, 600, time += 5);
+        while (time < 1000) fired |= sorter.update(nullptr, 600, time += 5);
+        if (fired) return false;
+    }
+    return true;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    std::printf("%-12s %8s %8s %12s %12s %10s %12s %10s\n", "sorter", "rpm", "blocks", "ejected %", "lost %",
+                "right %", "timing ms", "ns/tick");
+    if (argc > 1) {
+        const std::vector<Row> rows = load(argv[1]);
+        if (rows.empty()) {
+            std::printf("couldn't read %s\n", argv[1]);
+            return 1;
+        }
+        float rpm = 0;
+        for (const Row& row : rows) rpm += row.rpm / rows.size();
+        evaluate(rows, rpm, 0);
+        return 0;
+    }
+    for (const float rpm : {600.0f, 450.0f, 300.0f, 150.0f}) evaluate(generate(rpm, 400, 1), rpm, 600);
+    const bool tie = keepsTies();
+    std::printf("tied block: %s\n", tie ? "kept" : "ejected");
+    return tie ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "lemlib/driveCurve.hpp"
+
+/**
+ * Compares ExpoDriveCurve against LookupDriveCurve with the table baked at compile time, and with
+ * the table sampled from the ExpoDriveCurve at runtime, for the throttle and steer curves of
+ * src/main.cpp. Every call goes through a DriveCurve pointer, like Chassis makes them. Reports the
+ * cost per call, and how many of the 255 joystick values come out different, both as the float
+ * tank() uses and truncated to the int arcade() and curvature() use
+ */
+
+namespace {
+// the curves of src/main.cpp, as tables built at compile time
+constexpr lemlib::CurveTable THROTTLE_TABLE = lemlib::expoCurveTable(5, 10, 1.02);
+constexpr lemlib::CurveTable STEER_TABLE = lemlib::expoCurveTable(5, 10, 1.015);
+static_assert(THROTTLE_TABLE[128] == 0 && THROTTLE_TABLE[128 + 5] == 0, "the deadband is 0");
+static_assert(THROTTLE_TABLE[128 + 127] > 126.99f && THROTTLE_TABLE[128 + 127] < 127.01f, "full stick is 127");
+
+struct Curve {
+        const char* name;
+        float deadband, minOutput, gain;
+        const lemlib::CurveTable& table;
+};
+
+const Curve CURVES[] = {{"throttle", 5, 10, 1.02, THROTTLE_TABLE}, {"steer", 5, 10, 1.015, STEER_TABLE}};
+
+/**
+ * @brief Joystick values like a driver produces: sweeps of the stick with jitter around them
+ */
+std::vector<float> joystickTrace() {
+    std::vector<float> trace;
+    std::uint32_t seed = 1;
+    for (int i = 0; i < 100000; i++) {
+        seed = seed * 1664525 + 1013904223;
+        const int jitter = int(seed >> 29) - 4;
+        const int value = int(127 * std::sin(i * 0.01)) + jitter;
+        trace.push_back(value < -127 ? -127 : value > 127 ? 127 : value);
+    }
+    return trace;
+}
+
+double nanosecondsPerCall(lemlib::DriveCurve* curve, const std::vector<float>& trace) {
+    constexpr int PASSES = 20;
+    volatile float sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int pass = 0; pass < PASSES; pass++)
+        for (float input : trace) sink = curve->curve(input);
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (PASSES * trace.size());
+}
+
+/**
+ * @brief Count the joystick values where two curves differ, and by how much at most
+ */
+void compare(lemlib::DriveCurve* reference, lemlib::DriveCurve* curve, int& floatMismatches, int& intMismatches,
+             float& maxError) {
+    floatMismatches = 0;
+    intMismatches = 0;
+    maxError = 0;
+    for (int input = -127; input <= 127; input++) {
+        const float expected = reference->curve(input);
+        const float actual = curve->curve(input);
+        floatMismatches += expected != actual;
+        intMismatches += int(expected) != int(actual);
+        maxError = std::fmax(maxError, std::fabs(expected - actual));
+    }
+}
+} // namespace
+
+int main() {
+    const std::vector<float> trace = joystickTrace();
+    std::printf("%-10s %-16s %10s %12s %12s %12s\n", "curve", "implementation", "ns/call", "float diffs",
+                "int diffs", "max error");
+    for (const Curve& config : CURVES) {
+        lemlib::ExpoDriveCurve expo(config.deadband, config.minOutput, config.gain);
+        lemlib::LookupDriveCurve baked(config.table);
+        lemlib::LookupDriveCurve sampled(expo);
+        for (const auto [curve, label] : {std::pair<lemlib::DriveCurve*, const char*>(&expo, "expo"),
+                                          std::pair<lemlib::DriveCurve*, const char*>(&baked, "lookup constexpr"),
+                                          std::pair<lemlib::DriveCurve*, const char*>(&sampled, "lookup runtime")}) {
+            int floatMismatches, intMismatches;
+            float maxError;
+            compare(&expo, curve, floatMismatches, intMismatches, maxError);
+            std::printf("%-10s %-16s %10.2f %12d %12d %12.2g\n", config.name, label, nanosecondsPerCall(curve, trace),
+                        floatMismatches, intMismatches, maxError);
+        }
+    }
+}
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "lemlib/chassis/ekf.hpp"
+#include "lemlib/field.hpp"
+#include "sim/diffDrive.hpp"
+
+/**
+ * Records a 60 second drive around the field on the drivetrain model, with slipping wheels, a
+ * drifting IMU, a noisy GPS and two distance sensors, then replays it through the EKF. Reports
+ * the time per filter update and the pose error against plain dead reckoning.
+ */
+
+namespace {
+constexpr int TICKS = 6000; // 60 s at 10 ms
+constexpr int GPS_PERIOD = 5; // the GPS reports every 50 ms
+constexpr std::uint32_t GPS_LATENCY = 20;
+constexpr std::uint32_t DISTANCE_LATENCY = 30;
+
+struct DistanceReading {
+        lemlib::Pose offset = lemlib::Pose(0, 0, 0);
+        float distance = NAN; // inches, NAN if out of range
+};
+
+struct Tick {
+        std::uint32_t time;
+        float localX, localY, deltaTheta; // odometry step
+        float imu; // rotation since the start, radians
+        bool hasGps;
+        float gpsX, gpsY, gpsHeading;
+        std::array<DistanceReading, 2> distances;
+        sim::Pose truth;
+};
+
+const std::array<lemlib::Pose, 2> DISTANCE_OFFSETS = {lemlib::Pose(-6, 0, -M_PI_2), lemlib::Pose(0, -7, M_PI)};
+
+/**
+ * @brief Drive squares around the field, recording what every sensor saw
+ */
+std::vector<Tick> record() {
+    std::mt19937 random(5225);
+    std::normal_distribution<float> unit(0, 1);
+    sim::DiffDrive model;
+    model.setPose({-30, -30, 0});
+    // history of true poses, to give late sensors old readings
+    std::vector<sim::Pose> poses = {model.getPose()};
+    std::vector<Tick> ticks;
+    float imuDrift = 0;
+    float imu = 0;
+    // one lap: 1.6 s forwards then a right turn
+    for (int i = 0; i < TICKS; i++) {
+        const int phase = i % 230;
+        const double left = phase < 160 ? 6000 : 4000;
+        const double right = phase < 160 ? 6000 : -4000;
+        const sim::Pose before = model.getPose();
+        for (int step = 0; step < 10; step++) model.step(left, right, 0.001);
+        const sim::Pose after = model.getPose();
+        poses.push_back(after);
+
+        Tick tick {.time = std::uint32_t(i + 1) * 10, .truth = after};
+        // invert the arc step to get what perfect wheels would have measured, then make them slip
+        const float deltaTheta = after.theta - before.theta;
+        const float avgHeading = before.theta + deltaTheta / 2;
+        const float dx = after.x - before.x;
+        const float dy = after.y - before.y;
+        tick.localY = (dx * std::sin(avgHeading) + dy * std::cos(avgHeading)) * (1.03f + 0.02f * unit(random));
+        tick.localX = -dx * std::cos(avgHeading) + dy * std::sin(avgHeading) + 0.01f * unit(random);
+        // the IMU drifts about a degree a minute, odometry takes its heading from it
+        imuDrift += 0.000003f + 0.00002f * unit(random);
+        const float newImu = after.theta + imuDrift + 0.002f * unit(random);
+        tick.deltaTheta = newImu - imu;
+        imu = tick.imu = newImu;
+
+        const sim::Pose late = poses[std::max<int>(0, poses.size() - 1 - GPS_LATENCY / 10)];
+        tick.hasGps = i % GPS_PERIOD == 0;
+        tick.gpsX = late.x + 1.0f * unit(random);
+        tick.gpsY = late.y + 1.0f * unit(random);
+        tick.gpsHeading = late.theta + 0.03f * unit(random);
+
+        const sim::Pose seen = poses[std::max<int>(0, poses.size() - 1 - DISTANCE_LATENCY / 10)];
+        for (std::size_t s = 0; s < DISTANCE_OFFSETS.size(); s++) {
+            const lemlib::Pose& offset = DISTANCE_OFFSETS[s];
+            const float x = seen.x + offset.x * std::cos(seen.theta) + offset.y * std::sin(seen.theta);
+            const float y = seen.y - offset.x * std::sin(seen.theta) + offset.y * std::cos(seen.theta);
+            const float distance = lemlib::rayCast(x, y, seen.theta + offset.theta, lemlib::FIELD_WALLS, 1000);
+            tick.distances[s] = {offset, distance > 78 ? NAN : distance * (1 + 0.02f * unit(random))};
+        }
+        ticks.push_back(tick);
+    }
+    return ticks;
+}
+
+float error(const lemlib::Pose& estimate, const sim::Pose& truth) {
+    return std::hypot(estimate.x - truth.x, estimate.y - truth.y);
+}
+} // namespace
+
+int main() {
+    const std::vector<Tick> ticks = record();
+
+    // dead reckoning, like odometry without the filter
+    lemlib::Pose odom(-30, -30, 0);
+    float odomSum = 0;
+    for (const Tick& tick : ticks) {
+        const float avgHeading = odom.theta + tick.deltaTheta / 2;
+        odom.x += tick.localY * std::sin(avgHeading) - tick.localX * std::cos(avgHeading);
+        odom.y += tick.localY * std::cos(avgHeading) + tick.localX * std::sin(avgHeading);
+        odom.theta += tick.deltaTheta;
+        odomSum += error(odom, tick.truth);
+    }
+
+    // the same trace through the filter, timing every update
+    lemlib::Ekf ekf;
+    ekf.setPose(lemlib::Pose(-30, -30, 0), 0);
+    std::vector<double> times;
+    times.reserve(ticks.size());
+    float ekfSum = 0;
+    for (const Tick& tick : ticks) {
+        const auto start = std::chrono::steady_clock::now();
+        ekf.predict(tick.localX, tick.localY, tick.deltaTheta, tick.time);
+        ekf.correctHeading(tick.imu, 0.01, tick.time);
+        if (tick.hasGps) {
+            ekf.correctPosition(tick.gpsX, tick.gpsY, 1, tick.time - GPS_LATENCY);
+            ekf.correctHeading(tick.gpsHeading, 0.05, tick.time - GPS_LATENCY);
+        }
+        for (const DistanceReading& reading : tick.distances) {
+            if (!std::isnan(reading.distance))
+                ekf.correctDistance(reading.offset, reading.distance, tick.time - DISTANCE_LATENCY);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        ekfSum += error(ekf.getPose(), tick.truth);
+    }
+
+    std::sort(times.begin(), times.end());
+    double total = 0;
+    for (double time : times) total += time;
+    std::printf("filter update, us: mean %.3f  p50 %.3f  p99 %.3f  max %.3f\n", total / times.size(),
+                times[times.size() / 2], times[times.size() * 99 / 100], times.back());
+    std::printf("%-16s %12s %12s\n", "position error", "mean (in)", "final (in)");
+    std::printf("%-16s %12.2f %12.2f\n", "dead reckoning", odomSum / ticks.size(), error(odom, ticks.back().truth));
+    std::printf("%-16s %12.2f %12.2f\n", "ekf", ekfSum / ticks.size(), error(ekf.getPose(), ticks.back().truth));
+}
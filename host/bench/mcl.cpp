@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "lemlib/chassis/mcl.hpp"
+#include "lemlib/field.hpp"
+#include "sim/diffDrive.hpp"
+
+/**
+ * Records a 60 second drive around the field on the drivetrain model, with slipping wheels and
+ * three distance sensors that sometimes see other robots, then replays it through the particle
+ * filter at several particle counts. The filter starts a few inches off. Reports the time per
+ * odometry step against the 10 ms period, and the pose error against plain dead reckoning.
+ */
+
+namespace {
+constexpr int TICKS = 6000; // 60 s at 10 ms
+constexpr float PERIOD_US = 10000;
+
+struct Tick {
+        float localX, localY, deltaTheta; // odometry step
+        std::array<float, 3> distances; // inches, NAN if out of range
+        sim::Pose truth;
+};
+
+// left, right and back, theta in radians
+const std::array<lemlib::Pose, 3> OFFSETS = {lemlib::Pose(-6, 0, -M_PI_2), lemlib::Pose(6, 0, M_PI_2),
+                                             lemlib::Pose(0, -7, M_PI)};
+const sim::Pose START = {-36, -24, 0};
+
+/**
+ * @brief Drive loops between the alliance wall and the center goals, recording what every sensor saw
+ */
+std::vector<Tick> record() {
+    std::mt19937 random(5225);
+    std::normal_distribution<float> unit(0, 1);
+    std::uniform_real_distribution<float> chance(0, 1);
+    sim::DiffDrive model;
+    model.setPose(START);
+    std::vector<Tick> ticks;
+    // one lap: 1.1 s forwards then a right turn
+    for (int i = 0; i < TICKS; i++) {
+        const int phase = i % 180;
+        const double left = phase < 110 ? 6000 : 4000;
+        const double right = phase < 110 ? 6000 : -4000;
+        const sim::Pose before = model.getPose();
+        for (int step = 0; step < 10; step++) model.step(left, right, 0.001);
+        const sim::Pose after = model.getPose();
+
+        Tick tick {.truth = after};
+        // invert the arc step to get what perfect wheels would have measured, then make them slip
+        const float deltaTheta = after.theta - before.theta;
+        const float avgHeading = before.theta + deltaTheta / 2;
+        const float dx = after.x - before.x;
+        const float dy = after.y - before.y;
+        tick.localY = (dx * std::sin(avgHeading) + dy * std::cos(avgHeading)) * (1.03f + 0.02f * unit(random));
+        tick.localX = -dx * std::cos(avgHeading) + dy * std::sin(avgHeading) + 0.01f * unit(random);
+        tick.deltaTheta = deltaTheta * 1.01f + 0.0005f * unit(random);
+
+        for (std::size_t s = 0; s < OFFSETS.size(); s++) {
+            const lemlib::Pose& offset = OFFSETS[s];
+            const float x = after.x + offset.x * std::cos(after.theta) + offset.y * std::sin(after.theta);
+            const float y = after.y - offset.x * std::sin(after.theta) + offset.y * std::cos(after.theta);
+            float distance = lemlib::rayCast(x, y, after.theta + offset.theta, lemlib::FIELD_WALLS, 1000);
+            // another robot gets in the way every now and then
+            if (chance(random) < 0.03f) distance *= chance(random);
+            tick.distances[s] = distance > 78 ? NAN : distance * (1 + 0.02f * unit(random));
+        }
+        ticks.push_back(tick);
+    }
+    return ticks;
+}
+
+float error(const lemlib::Pose& estimate, const sim::Pose& truth) {
+    return std::hypot(estimate.x - truth.x, estimate.y - truth.y);
+}
+} // namespace
+
+int main() {
+    const std::vector<Tick> ticks = record();
+    const lemlib::Pose start(START.x + 3, START.y - 2, START.theta + 0.03);
+
+    // dead reckoning, like odometry without the filter
+    lemlib::Pose odom = start;
+    float odomSum = 0;
+    for (const Tick& tick : ticks) {
+        const float avgHeading = odom.theta + tick.deltaTheta / 2;
+        odom.x += tick.localY * std::sin(avgHeading) - tick.localX * std::cos(avgHeading);
+        odom.y += tick.localY * std::cos(avgHeading) + tick.localX * std::sin(avgHeading);
+        odom.theta += tick.deltaTheta;
+        odomSum += error(odom, tick.truth);
+    }
+
+    std::printf("%-16s %10s %10s %10s %10s %12s %12s\n", "particles", "mean us", "p99 us", "max us", "% period",
+                "mean err in", "final err in");
+    std::printf("%-16s %10s %10s %10s %10s %12.2f %12.2f\n", "dead reckoning", "-", "-", "-", "-",
+                odomSum / ticks.size(), error(odom, ticks.back().truth));
+
+    // the same trace through the filter, timing every odometry step
+    for (std::size_t particles : {250, 500, 1000, 2000}) {
+        lemlib::Mcl mcl({.particles = particles});
+        mcl.setPose(start);
+        std::vector<double> times;
+        times.reserve(ticks.size());
+        float mclSum = 0;
+        for (const Tick& tick : ticks) {
+            const auto begin = std::chrono::steady_clock::now();
+            mcl.predict(tick.localX, tick.localY, tick.deltaTheta);
+            mcl.correct(OFFSETS, tick.distances);
+            const auto end = std::chrono::steady_clock::now();
+            times.push_back(std::chrono::duration<double, std::micro>(end - begin).count());
+            mclSum += error(mcl.getPose(), tick.truth);
+        }
+        std::sort(times.begin(), times.end());
+        double total = 0;
+        for (double time : times) total += time;
+        std::printf("%-16zu %10.1f %10.1f %10.1f %10.2f %12.2f %12.2f\n", particles, total / times.size(),
+                    times[times.size() * 99 / 100], times.back(), 100 * times.back() / PERIOD_US,
+                    mclSum / ticks.size(), error(mcl.getPose(), ticks.back().truth));
+    }
+}
@@ -0,0 +1,91 @@
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "lemlib/util.hpp"
+#include "pros/motor_group.hpp"
+#include "sim/world.hpp"
+
+/**
+ * Counts heap allocations per odometry tick on the drivetrain from src/main.cpp, comparing the
+ * vector returning MotorGroup reads against the fixed size buffers in lemlib/motorGroup.hpp
+ */
+
+namespace {
+std::atomic<std::size_t> allocations = 0;
+constexpr int TICKS = 10000;
+
+/**
+ * @brief How TrackingWheel read a motor group before it switched to fixed size buffers
+ */
+float vectorDistance(const pros::MotorGroup& motors) {
+    std::vector<pros::MotorGears> gearsets = motors.get_gearing_all();
+    std::vector<double> positions = motors.get_position_all();
+    std::vector<float> distances;
+    for (int i = 0; i < motors.size(); i++) {
+        const float in = gearsets[i] == pros::MotorGears::blue ? 600 : gearsets[i] == pros::MotorGears::red ? 100 : 200;
+        distances.push_back(positions[i] * (lemlib::Omniwheel::NEW_325 * M_PI) * (450 / in));
+    }
+    return lemlib::avg(distances);
+}
+
+/**
+ * @brief Run a tick function, returning allocations and nanoseconds per tick
+ */
+template <typename F> std::pair<double, double> measure(F tick) {
+    float sink = 0;
+    const std::size_t startAllocations = allocations;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < TICKS; i++) {
+        sim::step(0.01);
+        sink += tick();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    const std::size_t used = allocations - startAllocations;
+    if (sink == 12345) std::puts(""); // keep the reads from being optimized out
+    return {double(used) / TICKS, std::chrono::duration<double, std::nano>(end - start).count() / TICKS};
+}
+} // namespace
+
+void* operator new(std::size_t size) {
+    allocations++;
+    if (void* pointer = std::malloc(size)) return pointer;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+int main() {
+    pros::MotorGroup leftMotors({-1, -12, -11}, pros::MotorGearset::blue);
+    pros::MotorGroup rightMotors({13, 15, 14}, pros::MotorGearset::blue);
+    sim::configureDrivetrain({.leftPorts = {-1, -12, -11}, .rightPorts = {13, 15, 14}});
+    lemlib::TrackingWheel leftWheel(&leftMotors, lemlib::Omniwheel::NEW_325, -6, 450);
+    lemlib::TrackingWheel rightWheel(&rightMotors, lemlib::Omniwheel::NEW_325, 6, 450);
+    lemlib::Drivetrain drivetrain(&leftMotors, &rightMotors, 12, lemlib::Omniwheel::NEW_325, 450, 8);
+    lemlib::setSensors(lemlib::OdomSensors(&leftWheel, &rightWheel, nullptr, nullptr, nullptr), drivetrain);
+    leftMotors.move(100);
+    rightMotors.move(80);
+
+    const auto [vectorAllocations, vectorTime] =
+        measure([&] { return vectorDistance(leftMotors) + vectorDistance(rightMotors); });
+    const auto [bufferAllocations, bufferTime] =
+        measure([&] { return leftWheel.getDistanceTraveled() + rightWheel.getDistanceTraveled(); });
+    const auto [odomAllocations, odomTime] = measure([&] {
+        lemlib::update();
+        leftMotors.move(100);
+        rightMotors.move(80);
+        return lemlib::getPose().x;
+    });
+
+    std::printf("%-34s %10s %10s\n", "per tick, both sides", "allocs", "ns");
+    std::printf("%-34s %10.2f %10.1f\n", "get_*_all vectors", vectorAllocations, vectorTime);
+    std::printf("%-34s %10.2f %10.1f\n", "TrackingWheel fixed buffers", bufferAllocations, bufferTime);
+    std::printf("%-34s %10.2f %10.1f\n", "odom update + drive commands", odomAllocations, odomTime);
+    return bufferAllocations == 0 && odomAllocations == 0 ? 0 : 1;
+}
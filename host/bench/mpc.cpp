@@ -0,0 +1,164 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+#include "lemlib/mpc.hpp"
+#include "lemlib/trajectory.hpp"
+#include "lemlib/util.hpp"
+
+/**
+ * Solve time and iterations of DriveMpc over trajectories like our autons drive: the example
+ * trajectory asset, and a generated trajectory to each moveToPose target. The robot is the
+ * feedforward model with its gains a little off, so the solver always has something to correct.
+ * Each trajectory is solved warm started, as the chassis does every tick, and cold started for
+ * comparison. The ff row is the model's voltage for the reference alone, what moveDrivetrain
+ * applies without the MPC, for the tracking error
+ */
+
+namespace {
+constexpr float PERIOD = 0.01;
+constexpr float TRACK_WIDTH = 12;
+// gains the host sim characterizes to
+const lemlib::DriveFeedforward MODEL = {lemlib::Feedforward(0.3, 0.162, 0.019),
+                                        lemlib::Feedforward(0.3, 0.162, 0.019)};
+// about what the wheels can do without slipping
+const lemlib::MpcSettings SETTINGS = {.maxAcceleration = 400, .maxAngularAcceleration = 100, .trackWidth = TRACK_WIDTH};
+
+struct Target {
+        float x, y, theta;
+        float lead;
+};
+
+// moveToPose calls from src/main.cpp
+const std::vector<Target> TARGETS = {
+    {12.9, 26.75, 57, 0.72}, {34, -24, 180, 0.5}, {-12.796, 26.75, -59, 0.5}, {-33, -32, 180, 0.5}, {-34, -56, 0, 0.5},
+};
+
+/**
+ * @brief Read a trajectory asset straight from static/, into a buffer aligned like the real one
+ */
+std::vector<lemlib::TrajectorySample> readAsset(const char* path) {
+    std::FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) return {};
+    std::vector<std::uint64_t> buffer(1 << 12);
+    const std::size_t size = std::fread(buffer.data(), 1, buffer.size() * sizeof(std::uint64_t), file);
+    std::fclose(file);
+    const std::optional<lemlib::Trajectory> trajectory =
+        lemlib::Trajectory::load({reinterpret_cast<std::uint8_t*>(buffer.data()), size});
+    if (!trajectory) return {};
+    return {trajectory->samples().begin(), trajectory->samples().end()};
+}
+
+/**
+ * @brief Wheel velocities a trajectory asks for at a time
+ */
+std::pair<float, float> wheels(const std::vector<lemlib::TrajectorySample>& samples, float time) {
+    const auto after =
+        std::upper_bound(samples.begin(), samples.end(), time,
+                         [](float t, const lemlib::TrajectorySample& sample) { return t < sample.time; });
+    if (after == samples.end()) return {0, 0};
+    if (after == samples.begin()) return {0, 0};
+    const lemlib::TrajectorySample& a = *(after - 1);
+    const lemlib::TrajectorySample& b = *after;
+    const float t = (time - a.time) / (b.time - a.time);
+    const float velocity = a.velocity + (b.velocity - a.velocity) * t;
+    const float curvature = a.curvature + (b.curvature - a.curvature) * t;
+    // positive curvature turns clockwise, so the left wheel is on the outside
+    return {velocity * (1 + curvature * TRACK_WIDTH / 2), velocity * (1 - curvature * TRACK_WIDTH / 2)};
+}
+
+struct Stats {
+        std::vector<double> times; // us
+        long iterations = 0;
+        int maxIterations = 0;
+        int converged = 0;
+        double squaredError = 0; // of the wheel velocities, (in/s)^2
+};
+
+enum class Mode { WARM, COLD, FEEDFORWARD };
+
+/**
+ * @brief Drive a trajectory with the MPC, timing every solve
+ */
+void drive(const std::vector<lemlib::TrajectorySample>& samples, Mode mode, Stats& stats) {
+    lemlib::DriveMpc mpc(MODEL, SETTINGS, PERIOD);
+    // the robot is a little stronger and has a little more friction than the model thinks
+    const lemlib::Feedforward robot(0.4, 0.155, 0.021);
+    std::array<float, 2> velocity = {0, 0};
+    const float duration = samples.back().time + 0.2;
+    for (float time = 0; time < duration; time += PERIOD) {
+        std::array<float, lemlib::DriveMpc::HORIZON> left;
+        std::array<float, lemlib::DriveMpc::HORIZON> right;
+        for (int i = 0; i < lemlib::DriveMpc::HORIZON; i++)
+            std::tie(left[i], right[i]) = wheels(samples, time + (i + 1) * PERIOD);
+        if (mode == Mode::COLD) mpc.reset();
+
+        const auto start = std::chrono::steady_clock::now();
+        lemlib::MpcSolution solution {};
+        if (mode == Mode::FEEDFORWARD) {
+            // what moveDrivetrain does without the MPC, the model's voltage for the reference
+            const auto [leftNow, rightNow] = wheels(samples, time);
+            solution.leftVoltage =
+                std::clamp(MODEL.left.calculate(left[0], (left[0] - leftNow) / PERIOD), -12.0f, 12.0f);
+            solution.rightVoltage =
+                std::clamp(MODEL.right.calculate(right[0], (right[0] - rightNow) / PERIOD), -12.0f, 12.0f);
+        } else {
+            solution = mpc.solve(velocity[0], velocity[1], left, right);
+        }
+        const auto end = std::chrono::steady_clock::now();
+        stats.times.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+        stats.iterations += solution.iterations;
+        stats.maxIterations = std::max(stats.maxIterations, solution.iterations);
+        stats.converged += solution.converged;
+
+        // step the robot through the period in 1 ms steps
+        const std::array<float, 2> voltages = {solution.leftVoltage, solution.rightVoltage};
+        for (int s = 0; s < 2; s++) {
+            for (int step = 0; step < 10; step++) {
+                const float friction = velocity[s] != 0 ? robot.kS * lemlib::sgn(velocity[s]) : 0;
+                float acceleration = (voltages[s] - friction - robot.kV * velocity[s]) / robot.kA;
+                // friction holds a robot at rest until the voltage overcomes it
+                if (velocity[s] == 0 && std::fabs(voltages[s]) <= robot.kS) acceleration = 0;
+                const float next = velocity[s] + acceleration * PERIOD / 10;
+                velocity[s] = velocity[s] != 0 && next * velocity[s] < 0 ? 0 : next;
+            }
+        }
+        const auto [leftTarget, rightTarget] = wheels(samples, time + PERIOD);
+        stats.squaredError += (velocity[0] - leftTarget) * (velocity[0] - leftTarget) +
+                              (velocity[1] - rightTarget) * (velocity[1] - rightTarget);
+    }
+}
+
+void print(const char* label, Stats& stats) {
+    std::sort(stats.times.begin(), stats.times.end());
+    double total = 0;
+    for (double time : stats.times) total += time;
+    const std::size_t n = stats.times.size();
+    std::printf("%-6s %8zu %10.2f %10.2f %10.2f %10.1f %8d %10.1f %12.2f\n", label, n, total / n,
+                stats.times[n * 99 / 100], stats.times.back(), double(stats.iterations) / n, stats.maxIterations,
+                100.0 * stats.converged / n, std::sqrt(stats.squaredError / (2 * n)));
+}
+} // namespace
+
+int main() {
+    std::vector<std::vector<lemlib::TrajectorySample>> trajectories;
+    const std::vector<lemlib::TrajectorySample> example = readAsset("static/example.traj");
+    if (example.empty()) std::puts("couldn't read static/example.traj, run from the project root");
+    else trajectories.push_back(example);
+    const lemlib::TrajectoryConstraints constraints {.maxVelocity = 60, .maxAcceleration = 150,
+                                                     .trackWidth = TRACK_WIDTH};
+    for (const Target& target : TARGETS) {
+        const lemlib::Pose end(target.x, target.y, lemlib::degToRad(target.theta));
+        trajectories.push_back(lemlib::generateTrajectory(lemlib::Pose(0, 0, 0), end, target.lead, constraints));
+    }
+
+    std::printf("%-6s %8s %10s %10s %10s %10s %8s %10s %12s\n", "start", "solves", "mean us", "p99 us", "max us",
+                "mean iter", "max iter", "conv %", "rms in/s");
+    for (const auto [mode, label] : {std::pair(Mode::WARM, "warm"), std::pair(Mode::COLD, "cold"),
+                                      std::pair(Mode::FEEDFORWARD, "ff")}) {
+        Stats stats;
+        for (const std::vector<lemlib::TrajectorySample>& samples : trajectories) drive(samples, mode, stats);
+        print(label, stats);
+    }
+}
@@ -0,0 +1,237 @@
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+#include <vector>
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/trig.hpp"
+#include "sim/diffDrive.hpp"
+
+/**
+ * Checks lemlib/trig.hpp against libm, then replays drive traces recorded on the drivetrain model
+ * through the odometry step. The traces are sampled at 1 kHz on the model and read by odometry
+ * every 10 ms from two perfect drive encoders, so the position error is the integration alone.
+ * Compares forward Euler, midpoint (RK2) heading, the arc step as it was with libm, and
+ * lemlib::integrateArc with the fast kernels.
+ */
+
+namespace {
+constexpr int TRACE_TICKS = 1500; // 15 s at 10 ms
+constexpr float TRACK_WIDTH = 12;
+
+struct Sample {
+        float left, right; // encoder distance since the start, inches
+        sim::Pose truth;
+};
+
+struct Trace {
+        const char* name;
+        std::vector<Sample> samples;
+};
+
+/**
+ * @brief Record a trace, with the voltages to apply at each millisecond
+ */
+Trace record(const char* name, const std::function<std::pair<double, double>(double)>& voltages) {
+    sim::DiffDrive model;
+    Trace trace {name, {}};
+    double left = 0;
+    double right = 0;
+    for (int i = 0; i < TRACE_TICKS * 10; i++) {
+        const auto [leftVoltage, rightVoltage] = voltages(i / 1000.0);
+        model.step(leftVoltage, rightVoltage, 0.001);
+        left += model.getLeftSpeed() * 0.001;
+        right += model.getRightSpeed() * 0.001;
+        if (i % 10 == 9) trace.samples.push_back({float(left), float(right), model.getPose()});
+    }
+    return trace;
+}
+
+std::vector<Trace> traces() {
+    return {
+        // 1.6 s straight then a hard right, over and over
+        record("laps",
+               [](double t) {
+                   const bool turning = std::fmod(t, 2.3) > 1.6;
+                   return std::pair(turning ? 4000.0 : 6000.0, turning ? -4000.0 : 6000.0);
+               }),
+        // weaving at full speed, the curvature always changing
+        record("weave",
+               [](double t) {
+                   const double steer = 5000 * std::sin(t * 3);
+                   return std::pair(7000 + steer, 7000 - steer);
+               }),
+        // spinning in place, flipping direction every second
+        record("spin",
+               [](double t) {
+                   const double power = std::fmod(t, 2) < 1 ? 12000 : -12000;
+                   return std::pair(power, -power);
+               }),
+        // tight arcs at full power, like a fast curved approach
+        record("arcs",
+               [](double t) {
+                   const bool leftTurn = std::fmod(t, 3) < 1.5;
+                   return std::pair(leftTurn ? 3000.0 : 12000.0, leftTurn ? 12000.0 : 3000.0);
+               }),
+    };
+}
+
+/**
+ * @brief The arc step as odometry did it before, through double precision libm
+ */
+lemlib::Pose libmArc(const lemlib::Pose& pose, float arcX, float arcY, float deltaHeading) {
+    float localX = arcX;
+    float localY = arcY;
+    if (deltaHeading != 0) {
+        localX = 2 * sin(deltaHeading / 2) * (arcX / deltaHeading);
+        localY = 2 * sin(deltaHeading / 2) * (arcY / deltaHeading);
+    }
+    const float avgHeading = pose.theta + deltaHeading / 2;
+    return lemlib::Pose(pose.x + localY * sin(avgHeading) - localX * cos(avgHeading),
+                        pose.y + localY * cos(avgHeading) + localX * sin(avgHeading), pose.theta + deltaHeading);
+}
+
+/**
+ * @brief Straight line along the heading at the start of the step
+ */
+lemlib::Pose euler(const lemlib::Pose& pose, float arcX, float arcY, float deltaHeading) {
+    const float sinHeading = std::sin(pose.theta);
+    const float cosHeading = std::cos(pose.theta);
+    return lemlib::Pose(pose.x + arcY * sinHeading - arcX * cosHeading, pose.y + arcY * cosHeading + arcX * sinHeading,
+                        pose.theta + deltaHeading);
+}
+
+/**
+ * @brief Straight line along the heading halfway through the step
+ */
+lemlib::Pose midpoint(const lemlib::Pose& pose, float arcX, float arcY, float deltaHeading) {
+    const lemlib::Pose moved = euler(lemlib::Pose(pose.x, pose.y, pose.theta + deltaHeading / 2), arcX, arcY, 0);
+    return lemlib::Pose(moved.x, moved.y, pose.theta + deltaHeading);
+}
+
+lemlib::Pose fastArc(const lemlib::Pose& pose, float arcX, float arcY, float deltaHeading) {
+    return lemlib::integrateArc(pose, arcX, arcY, deltaHeading);
+}
+
+using Step = lemlib::Pose (*)(const lemlib::Pose&, float, float, float);
+
+struct Result {
+        float finalError = 0;
+        float maxError = 0;
+};
+
+/**
+ * @brief Run odometry over a trace with two vertical wheels, like the drive encoders in main.cpp
+ */
+Result replay(const Trace& trace, Step step) {
+    lemlib::Pose pose(0, 0, 0);
+    float prevLeft = 0;
+    float prevRight = 0;
+    Result result;
+    for (const Sample& sample : trace.samples) {
+        const float deltaLeft = sample.left - prevLeft;
+        const float deltaRight = sample.right - prevRight;
+        prevLeft = sample.left;
+        prevRight = sample.right;
+        const float deltaHeading = (deltaLeft - deltaRight) / TRACK_WIDTH;
+        // the left wheel is 6 inches left of the tracking center
+        pose = step(pose, 0, deltaLeft - TRACK_WIDTH / 2 * deltaHeading, deltaHeading);
+        const float error = std::hypot(pose.x - sample.truth.x, pose.y - sample.truth.y);
+        result.maxError = std::fmax(result.maxError, error);
+        result.finalError = error;
+    }
+    return result;
+}
+
+/**
+ * @brief Nanoseconds per call of a step over a trace
+ */
+double timeStep(const Trace& trace, Step step) {
+    constexpr int REPEATS = 200;
+    std::vector<float> deltas;
+    for (std::size_t i = 1; i < trace.samples.size(); i++)
+        deltas.push_back(trace.samples[i].left - trace.samples[i - 1].left);
+    lemlib::Pose pose(0, 0, 0);
+    const auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < REPEATS; r++) {
+        for (float delta : deltas) pose = step(pose, 0, delta, delta * 0.01f);
+    }
+    const auto end = std::chrono::steady_clock::now();
+    if (pose.x == 12345) std::puts(""); // keep the steps from being optimized out
+    return std::chrono::duration<double, std::nano>(end - start).count() / (REPEATS * deltas.size());
+}
+
+/**
+ * @brief Distance between two floats in units in the last place
+ */
+float ulps(float value, double truth) {
+    const float rounded = float(truth);
+    const float ulp = std::nextafter(std::fabs(rounded), INFINITY) - std::fabs(rounded);
+    return std::fabs(value - truth) / ulp;
+}
+
+void checkTrig() {
+    constexpr int POINTS = 2000000;
+    float maxSinUlp = 0, maxCosUlp = 0, libmSinUlp = 0, libmCosUlp = 0;
+    double maxError = 0;
+    for (int i = 0; i <= POINTS; i++) {
+        const float x = -64 + 128.0f * i / POINTS;
+        const auto [sin, cos] = lemlib::fastSinCos(x);
+        const double trueSin = std::sin(double(x));
+        const double trueCos = std::cos(double(x));
+        maxError = std::fmax(maxError, std::fmax(std::fabs(sin - trueSin), std::fabs(cos - trueCos)));
+        // ulps are only meaningful away from the zeros
+        if (std::fabs(trueSin) > 1e-3) {
+            maxSinUlp = std::fmax(maxSinUlp, ulps(sin, trueSin));
+            libmSinUlp = std::fmax(libmSinUlp, ulps(std::sin(x), trueSin));
+        }
+        if (std::fabs(trueCos) > 1e-3) {
+            maxCosUlp = std::fmax(maxCosUlp, ulps(cos, trueCos));
+            libmCosUlp = std::fmax(libmCosUlp, ulps(std::cos(x), trueCos));
+        }
+    }
+    std::printf("sin/cos over [-64, 64] rad: max abs error %.2e, max ulp fast sin %.2f cos %.2f, libm float sin %.2f "
+                "cos %.2f\n",
+                maxError, maxSinUlp, maxCosUlp, libmSinUlp, libmCosUlp);
+
+    // throughput of one sine and cosine, on angles like headings
+    std::vector<float> angles;
+    for (int i = 0; i < 4096; i++) angles.push_back(std::fmod(i * 0.37f, 20.0f) - 10);
+    const auto time = [&](auto sinCos) {
+        float sink = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (int r = 0; r < 500; r++) {
+            for (float angle : angles) {
+                const auto [s, c] = sinCos(angle + sink * 1e-30f);
+                sink += s + c;
+            }
+        }
+        const auto end = std::chrono::steady_clock::now();
+        if (sink == 12345) std::puts("");
+        return std::chrono::duration<double, std::nano>(end - start).count() / (500 * angles.size());
+    };
+    const double libmDouble = time([](float x) { return std::pair<float, float>(sin(double(x)), cos(double(x))); });
+    const double libmFloat = time([](float x) { return std::pair(std::sin(x), std::cos(x)); });
+    const double fast = time([](float x) { return lemlib::fastSinCos(x); });
+    std::printf("sin+cos, ns: libm double %.2f  libm float %.2f  fast %.2f\n\n", libmDouble, libmFloat, fast);
+}
+} // namespace
+
+int main() {
+    checkTrig();
+
+    const std::vector<Trace> recorded = traces();
+    const std::pair<const char*, Step> steps[] = {
+        {"euler", euler}, {"midpoint (rk2)", midpoint}, {"arc, libm", libmArc}, {"arc, fast", fastArc}};
+    std::printf("%-16s", "position error");
+    for (const Trace& trace : recorded) std::printf(" %8s final/max", trace.name);
+    std::printf(" %9s\n", "ns/step");
+    for (const auto& [name, step] : steps) {
+        std::printf("%-16s", name);
+        for (const Trace& trace : recorded) {
+            const Result result = replay(trace, step);
+            std::printf(" %8.4f/%-8.4f", result.finalError, result.maxError);
+        }
+        std::printf(" %9.2f\n", timeStep(recorded[1], step));
+    }
+}
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "lemlib/pose.hpp"
+#include "lemlib/seqlock.hpp"
+
+/**
+ * Has one task publish poses while three others read them, the way odometry, the motions and a
+ * controller printing task share the pose. Compares the plain global odometry used to have, a
+ * mutex around it, and lemlib::SeqLock. Every published pose has x == y == theta, so a read
+ * with mismatched fields was torn. Reports the latency of every read and write, and how often
+ * the writer had to wait for a reader. The sandbox this runs in may have a single core like the
+ * brain, where the long tail is preemption rather than the publisher itself.
+ */
+
+namespace {
+constexpr auto DURATION = std::chrono::milliseconds(1000);
+constexpr int READERS = 3;
+
+/**
+ * @brief A pose copied field by field with no synchronization, like reading the odometry globals
+ */
+class Plain {
+    public:
+        void store(const lemlib::Pose& pose) {
+            x.store(pose.x, std::memory_order_relaxed);
+            y.store(pose.y, std::memory_order_relaxed);
+            theta.store(pose.theta, std::memory_order_relaxed);
+        }
+
+        std::size_t getWaits() const { return 0; }
+
+        lemlib::Pose load() const {
+            return lemlib::Pose(x.load(std::memory_order_relaxed), y.load(std::memory_order_relaxed),
+                                theta.load(std::memory_order_relaxed));
+        }
+    private:
+        std::atomic<float> x = 0;
+        std::atomic<float> y = 0;
+        std::atomic<float> theta = 0;
+};
+
+/**
+ * @brief A pose behind a mutex, which readers and the writer both take
+ */
+class Locked {
+    public:
+        void store(const lemlib::Pose& pose) {
+            if (!mutex.try_lock()) {
+                waits++;
+                mutex.lock();
+            }
+            value = pose;
+            mutex.unlock();
+        }
+
+        std::size_t getWaits() const { return waits; }
+
+        lemlib::Pose load() const {
+            std::lock_guard lock(mutex);
+            return value;
+        }
+    private:
+        mutable std::mutex mutex;
+        lemlib::Pose value = lemlib::Pose(0, 0, 0);
+        std::size_t waits = 0;
+};
+
+struct Result {
+        std::vector<double> reads; // ns
+        std::vector<double> writes; // ns
+        std::size_t torn = 0;
+        std::size_t waits = 0; // writes that waited for a reader
+};
+
+template <typename Publisher> Result run() {
+    Publisher published;
+    std::atomic<bool> done = false;
+    std::array<std::vector<double>, READERS> reads;
+    std::array<std::size_t, READERS> torn {};
+    std::vector<double> writes;
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < READERS; r++) {
+        readers.emplace_back([&, r] {
+            reads[r].reserve(1 << 22);
+            while (!done.load(std::memory_order_relaxed)) {
+                const auto start = std::chrono::steady_clock::now();
+                const lemlib::Pose pose = published.load();
+                const auto end = std::chrono::steady_clock::now();
+                if (reads[r].size() < reads[r].capacity())
+                    reads[r].push_back(std::chrono::duration<double, std::nano>(end - start).count());
+                if (pose.x != pose.y || pose.y != pose.theta) torn[r]++;
+            }
+        });
+    }
+
+    writes.reserve(1 << 22);
+    const auto stop = std::chrono::steady_clock::now() + DURATION;
+    for (float k = 1; std::chrono::steady_clock::now() < stop; k++) {
+        const auto start = std::chrono::steady_clock::now();
+        published.store(lemlib::Pose(k, k, k));
+        const auto end = std::chrono::steady_clock::now();
+        if (writes.size() < writes.capacity())
+            writes.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+    }
+    done = true;
+    for (std::thread& reader : readers) reader.join();
+
+    Result result;
+    result.writes = std::move(writes);
+    result.waits = published.getWaits();
+    for (int r = 0; r < READERS; r++) {
+        result.reads.insert(result.reads.end(), reads[r].begin(), reads[r].end());
+        result.torn += torn[r];
+    }
+    return result;
+}
+
+void print(const char* name, const char* side, std::vector<double> times, std::size_t events) {
+    std::sort(times.begin(), times.end());
+    const auto at = [&](double fraction) { return times[std::size_t(fraction * (times.size() - 1))]; };
+    std::printf("%-9s %-6s %10zu %9.0f %9.0f %11.0f %12.0f %12zu\n", name, side, times.size(), at(0.5), at(0.99),
+                at(0.999), times.back(), events);
+}
+
+template <typename Publisher> void report(const char* name) {
+    const Result result = run<Publisher>();
+    print(name, "read", result.reads, result.torn);
+    print(name, "write", result.writes, result.waits);
+}
+
+/**
+ * @brief SeqLock with the default constructor the benchmark needs
+ */
+class Sequenced : public lemlib::SeqLock<lemlib::Pose> {
+    public:
+        Sequenced()
+            : SeqLock(lemlib::Pose(0, 0, 0)) {}
+
+        std::size_t getWaits() const { return 0; }
+};
+} // namespace
+
+int main() {
+    std::printf("%-9s %-6s %10s %9s %9s %11s %12s %12s\n", "publisher", "op", "count", "p50 ns", "p99 ns",
+                "p99.9 ns", "max ns", "torn/waited");
+    report<Plain>("plain");
+    report<Locked>("mutex");
+    report<Sequenced>("seqlock");
+}
@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <vector>
+#include "lemlib/pathCursor.hpp"
+
+/**
+ * Per tick latency of the pure pursuit search in Chassis::follow, on long paths. Compares the full
+ * scan follow() used to do against PathCursor, with a robot driving the length of the path slightly
+ * off to one side
+ */
+
+namespace {
+constexpr float SPACING = 0.5; // inches between path points, what path.jerryio exports
+constexpr float LOOKAHEAD = 10;
+constexpr float SPEED = 0.6; // inches per tick, 60 in/s at 100 Hz
+
+/**
+ * @brief A snaking path with a point every SPACING inches
+ */
+std::vector<lemlib::Pose> makePath(int points) {
+    std::vector<lemlib::Pose> path;
+    for (int i = 0; i < points; i++) {
+        const float y = i * SPACING;
+        path.emplace_back(24 * std::sin(y / 40), y, 100);
+    }
+    return path;
+}
+
+/**
+ * @brief How follow() found the closest point before PathCursor, copying the path every call
+ */
+int findClosest(lemlib::Pose pose, std::vector<lemlib::Pose> path) {
+    int closestPoint = 0;
+    float closestDist = std::numeric_limits<float>::infinity();
+    for (int i = 0; i < path.size(); i++) {
+        const float dist = pose.distance(path.at(i));
+        if (dist < closestDist) {
+            closestDist = dist;
+            closestPoint = i;
+        }
+    }
+    return closestPoint;
+}
+
+/**
+ * @brief How follow() found the lookahead point before PathCursor
+ */
+lemlib::Pose lookaheadPoint(lemlib::Pose lastLookahead, lemlib::Pose pose, std::vector<lemlib::Pose> path,
+                            int closest, float lookaheadDist) {
+    const int start = std::max(closest, int(lastLookahead.theta));
+    for (int i = start; i < path.size() - 1; i++) {
+        lemlib::Pose lastPathPose = path.at(i);
+        lemlib::Pose currentPathPose = path.at(i + 1);
+        float t = lemlib::circleIntersect(lastPathPose, currentPathPose, pose, lookaheadDist);
+        if (t != -1) {
+            lemlib::Pose lookahead = lastPathPose.lerp(currentPathPose, t);
+            lookahead.theta = i;
+            return lookahead;
+        }
+    }
+    return lastLookahead;
+}
+
+struct Latency {
+        double mean = 0; // ns
+        double p99 = 0; // ns
+        double max = 0; // ns
+        float checksum = 0; // sum of lookahead points, so both searches can be compared
+};
+
+/**
+ * @brief Drive the robot along the path, timing one search per tick
+ */
+template <typename F> Latency measure(const std::vector<lemlib::Pose>& path, F tick) {
+    std::vector<double> times;
+    Latency latency;
+    // walk along the path a tick at a time, 2 inches off to the side
+    for (float along = 0; along < (path.size() - 1) * SPACING; along += SPEED) {
+        const lemlib::Pose& onPath = path[int(along / SPACING)];
+        const lemlib::Pose pose(onPath.x + 2, onPath.y);
+        const auto start = std::chrono::steady_clock::now();
+        const lemlib::Pose lookahead = tick(pose);
+        const auto end = std::chrono::steady_clock::now();
+        times.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        latency.checksum += lookahead.x + lookahead.y;
+    }
+    std::sort(times.begin(), times.end());
+    for (double time : times) latency.mean += time / times.size();
+    latency.p99 = times[times.size() * 99 / 100];
+    latency.max = times.back();
+    return latency;
+}
+
+void print(const char* label, int points, const Latency& latency) {
+    std::printf("%-12s %8d %12.0f %12.0f %12.0f %14.1f\n", label, points, latency.mean, latency.p99, latency.max,
+                latency.checksum);
+}
+} // namespace
+
+int main() {
+    std::printf("%-12s %8s %12s %12s %12s %14s\n", "search", "points", "mean ns", "p99 ns", "max ns", "checksum");
+    bool same = true;
+    for (int points : {1000, 10000}) {
+        const std::vector<lemlib::Pose> path = makePath(points);
+
+        lemlib::Pose lastLookahead(path[0].x, path[0].y, 0);
+        const Latency scan = measure(path, [&](const lemlib::Pose& pose) {
+            lastLookahead = lookaheadPoint(lastLookahead, pose, path, findClosest(pose, path), LOOKAHEAD);
+            return lastLookahead;
+        });
+        print("full scan", points, scan);
+
+        lemlib::PathCursor cursor(path, LOOKAHEAD);
+        const Latency incremental = measure(path, [&](const lemlib::Pose& pose) {
+            cursor.update(pose);
+            return cursor.getLookahead();
+        });
+        print("PathCursor", points, incremental);
+        same = same && std::fabs(scan.checksum - incremental.checksum) < 1e-3 * std::fabs(scan.checksum);
+    }
+    if (!same) std::puts("PathCursor found different lookahead points than the full scan");
+    return same ? 0 : 1;
+}
@@ -0,0 +1,183 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/pid.hpp"
+#include "lemlib/ramsete.hpp"
+#include "lemlib/util.hpp"
+#include "sim/scheduler.hpp"
+#include "sim/world.hpp"
+
+/**
+ * Compares moveToPose's carrot point controller against RAMSETE trajectory tracking. First the
+ * per tick cost of each controller's math, then both controllers driving the robot in the
+ * simulator from the origin to each pose of our autons, reporting how long each move took and how
+ * far from the target the robot ended up, by ground truth
+ */
+
+namespace {
+struct Target {
+        float x, y, theta; // inches and degrees, like Chassis::moveToPose
+        bool forwards;
+        float lead;
+        float maxSpeed;
+};
+
+// moveToPose calls from src/main.cpp
+const std::vector<Target> TARGETS = {
+    {12.9, 26.75, 57, true, 0.72, 75}, {34, -24, 180, true, 0.5, 127},  {-12.796, 26.75, -59, true, 0.5, 127},
+    {-33, -32, 180, true, 0.5, 127},   {-34, -56, 180, false, 0.5, 127},
+};
+
+constexpr int TIMEOUT = 4000;
+
+template <typename F> double nanosecondsPerCall(int calls, F call) {
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < calls; i++) call(i);
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / calls;
+}
+
+/**
+ * @brief Time the per tick math of both controllers, with the robot on a generated trajectory
+ */
+void benchmarkCompute() {
+    const lemlib::TrajectoryConstraints constraints {.maxVelocity = 60, .maxAcceleration = 120, .trackWidth = 12};
+    const std::vector<lemlib::TrajectorySample> samples = lemlib::generateTrajectory(
+        lemlib::Pose(0, 0, 0), lemlib::Pose(12.9, 26.75, lemlib::degToRad(57)), 0.72, constraints);
+    std::vector<lemlib::Pose> poses;
+    for (const lemlib::TrajectorySample& sample : samples)
+        poses.emplace_back(sample.x + 0.5f, sample.y - 0.5f, M_PI_2 - sample.heading + 0.05f);
+    const int n = poses.size();
+    constexpr int CALLS = 1000000;
+    volatile float sink = 0;
+
+    // the carrot, side and error math of one moveToPose tick, with the PID updates
+    const lemlib::Pose target(12.9, 26.75, M_PI_2 - lemlib::degToRad(57));
+    lemlib::PID lateral(5.8, 0, 13, 3);
+    lemlib::PID angular(2.0, 0, 13.6, 3);
+    const double boomerang = nanosecondsPerCall(CALLS, [&](int i) {
+        const lemlib::Pose& pose = poses[i % n];
+        const float distTarget = pose.distance(target);
+        const lemlib::Pose carrot =
+            target - lemlib::Pose(std::cos(target.theta), std::sin(target.theta)) * 0.72 * distTarget;
+        const bool robotSide =
+            (pose.y - target.y) * -std::sin(target.theta) <= (pose.x - target.x) * std::cos(target.theta);
+        const bool carrotSide =
+            (carrot.y - target.y) * -std::sin(target.theta) <= (carrot.x - target.x) * std::cos(target.theta);
+        const float angularError = lemlib::angleError(pose.theta, pose.angle(carrot));
+        const float lateralError =
+            pose.distance(carrot) * lemlib::sgn(std::cos(lemlib::angleError(pose.theta, pose.angle(carrot))));
+        const float maxSlipSpeed = std::sqrt(8 * 9.8f / std::fabs(lemlib::getCurvature(pose, carrot)));
+        sink = lateral.update(lateralError) + angular.update(lemlib::radToDeg(angularError)) + maxSlipSpeed +
+               (robotSide == carrotSide);
+    });
+
+    // interpolating the reference and one Ramsete update
+    const lemlib::Ramsete ramsete;
+    const float duration = samples.back().time;
+    int index = 0;
+    const double tracking = nanosecondsPerCall(CALLS, [&](int i) {
+        const float elapsed = (i % n) * duration / n;
+        if (elapsed == 0) index = 0;
+        while (index < n - 2 && samples[index + 1].time <= elapsed) index++;
+        const lemlib::TrajectorySample& a = samples[index];
+        const lemlib::TrajectorySample& b = samples[index + 1];
+        const float t = std::clamp((elapsed - a.time) / (b.time - a.time), 0.0f, 1.0f);
+        const float velocity = a.velocity + (b.velocity - a.velocity) * t;
+        const float curvature = a.curvature + (b.curvature - a.curvature) * t;
+        const lemlib::Pose reference(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t,
+                                     M_PI_2 - (a.heading + lemlib::angleError(b.heading, a.heading) * t));
+        const auto [linear, turn] = ramsete.calculate(poses[i % n], reference, velocity, -velocity * curvature);
+        sink = linear + turn;
+    });
+
+    // RAMSETE generates its trajectory once, when the motion starts
+    const double generate = nanosecondsPerCall(1000, [&](int) {
+        sink = lemlib::generateTrajectory(lemlib::Pose(0, 0, 0), lemlib::Pose(12.9, 26.75, lemlib::degToRad(57)),
+                                          0.72, constraints)
+                   .back()
+                   .time;
+    });
+
+    std::printf("%-32s %12s\n", "per tick compute", "ns");
+    std::printf("%-32s %12.1f\n", "boomerang carrot + PIDs", boomerang);
+    std::printf("%-32s %12.1f\n", "RAMSETE reference + update", tracking);
+    std::printf("%-32s %12.1f\n", "RAMSETE trajectory generation", generate);
+}
+
+// the drivetrain and controllers of src/main.cpp
+pros::MotorGroup leftMotors({-1, -12, -11}, pros::MotorGears::blue);
+pros::MotorGroup rightMotors({13, 15, 14}, pros::MotorGears::blue);
+pros::Imu imu(16);
+lemlib::TrackingWheel leftWheel(&leftMotors, lemlib::Omniwheel::NEW_325, -6, 450);
+lemlib::TrackingWheel rightWheel(&rightMotors, lemlib::Omniwheel::NEW_325, 6, 450);
+lemlib::Chassis chassis({&leftMotors, &rightMotors, 12, lemlib::Omniwheel::NEW_325, 450, 8},
+                        {5.8, 0, 13, 3, 1, 100, 3, 500, 20}, {2.0, 0, 13.6, 3, 1, 100, 3, 500, 0},
+                        {&leftWheel, &rightWheel, nullptr, nullptr, &imu});
+
+struct Result {
+        std::uint32_t time; // ms
+        float position; // inches from the target
+        float heading; // degrees from the target
+};
+
+/**
+ * @brief Drive from the origin to a target, then measure the ground truth error once stopped
+ */
+Result drive(const Target& target, lemlib::PoseController controller) {
+    // odometry sees the teleport as a jump in the IMU heading, so reset it after the jump
+    sim::setRobotPose({0, 0, 0});
+    pros::delay(50);
+    chassis.setPose(0, 0, 0);
+    pros::delay(50);
+    const std::uint32_t start = pros::millis();
+    chassis.moveToPose(target.x, target.y, target.theta, TIMEOUT,
+                       {.forwards = target.forwards,
+                        .lead = target.lead,
+                        .maxSpeed = target.maxSpeed,
+                        .controller = controller},
+                       false);
+    const std::uint32_t time = pros::millis() - start;
+    pros::delay(500); // let the robot stop
+    const sim::Pose pose = sim::robotPose();
+    return {time, float(std::hypot(pose.x - target.x, pose.y - target.y)),
+            std::fabs(lemlib::angleError(target.theta, pose.theta * 180 / M_PI, false))};
+}
+} // namespace
+
+int main() {
+    benchmarkCompute();
+
+    sim::configureDrivetrain({.leftPorts = {-1, -12, -11},
+                              .rightPorts = {13, 15, 14},
+                              .trackWidth = 12,
+                              .wheelDiameter = 3.25,
+                              .rpm = 450});
+    sim::onTick([](std::uint32_t) { sim::step(0.001); });
+    sim::run(
+        [] {
+            chassis.calibrate();
+            chassis.setBrakeMode(pros::E_MOTOR_BRAKE_HOLD);
+            std::printf("\n%-24s %-10s %10s %14s %14s\n", "target", "controller", "time (ms)", "position (in)",
+                        "heading (deg)");
+            for (const Target& target : TARGETS) {
+                char label[32];
+                std::snprintf(label, sizeof(label), "%.1f, %.1f, %.0f%s", target.x, target.y, target.theta,
+                              target.forwards ? "" : " rev");
+                for (const auto [controller, name] : {std::pair(lemlib::PoseController::BOOMERANG, "boomerang"),
+                                                      std::pair(lemlib::PoseController::RAMSETE, "RAMSETE")}) {
+                    const Result result = drive(target, controller);
+                    std::printf("%-24s %-10s %10u %14.2f %14.2f\n", label, name, result.time, result.position,
+                                result.heading);
+                }
+            }
+        },
+        0, 600000);
+    // tasks that never return are still parked on their threads, so skip static destructors
+    std::fflush(stdout);
+    std::_Exit(0);
+}
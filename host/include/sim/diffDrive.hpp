@@ -0,0 +1,137 @@
+#pragma once
+
+namespace sim {
+/**
+ * @brief Ground truth pose of the simulated robot
+ *
+ * Uses the same convention as LemLib: inches, theta in radians measured clockwise from +y
+ */
+struct Pose {
+        double x = 0;
+        double y = 0;
+        double theta = 0;
+};
+
+/**
+ * @brief Physical constants of a differential drivetrain
+ *
+ * The motor constants describe a V5 smart motor at the cartridge output shaft. The V5 is
+ * rated at 2.1 Nm with a red cartridge at its default 2.5 A current limit, so a blue
+ * cartridge produces 0.35 Nm at the limit. Torque is proportional to current, and the
+ * unlimited stall current is an estimate
+ */
+struct DiffDriveParams {
+        double trackWidth = 12; /** inches */
+        double wheelDiameter = 3.25; /** inches */
+        double rpm = 450; /** wheel rpm at full voltage */
+        double cartridgeRpm = 600; /** free speed of the cartridge output shaft, in rpm */
+        int motorsPerSide = 3;
+        double mass = 6.8; /** kg */
+        double inertia = 0.15; /** moment of inertia about the turning center, in kg m^2 */
+        double stallTorque = 0.7; /** cartridge output torque at stall without a current limit, in Nm */
+        double stallCurrent = 5000; /** current at stall without a current limit, in mA */
+        double currentLimit = 2500; /** per motor current limit, in mA */
+        double linearDrag = 2; /** rolling resistance, in N per m/s */
+        double angularDrag = 0.1; /** scrub of the wheels while turning, in Nm per rad/s */
+};
+
+/**
+ * @brief Dynamics of a differential drivetrain driven by current limited DC motors
+ *
+ * Holds no global state, so any number of models can be stepped on different threads
+ */
+class DiffDrive {
+    public:
+        /**
+         * @brief Construct a new drivetrain at rest at the origin
+         *
+         * @param params physical constants of the drivetrain
+         */
+        explicit DiffDrive(const DiffDriveParams& params = {});
+        /**
+         * @brief Advance the model by one time step
+         *
+         * A side with no voltage that is not braking coasts, otherwise its motors short their
+         * windings and brake on their own back EMF
+         *
+         * @param leftVoltage voltage applied to every left motor, in mV
+         * @param rightVoltage voltage applied to every right motor, in mV
+         * @param dt time step, in seconds
+         * @param leftBraking whether the left motors are braking
+         * @param rightBraking whether the right motors are braking
+         */
+        void step(double leftVoltage, double rightVoltage, double dt, bool leftBraking = false,
+                  bool rightBraking = false);
+        /**
+         * @brief Get the pose of the robot
+         *
+         * @return Pose
+         */
+        Pose getPose() const;
+        /**
+         * @brief Teleport the robot, keeping its velocity
+         *
+         * @param pose the new pose
+         */
+        void setPose(const Pose& pose);
+        /**
+         * @brief Get the speed of the left wheels
+         *
+         * @return double inches per second
+         */
+        double getLeftSpeed() const;
+        /**
+         * @brief Get the speed of the right wheels
+         *
+         * @return double inches per second
+         */
+        double getRightSpeed() const;
+        /**
+         * @brief Get the current drawn by each left motor during the last step
+         *
+         * @return double mA
+         */
+        double getLeftCurrent() const;
+        /**
+         * @brief Get the current drawn by each right motor during the last step
+         *
+         * @return double mA
+         */
+        double getRightCurrent() const;
+        /**
+         * @brief Get the torque of each left motor during the last step
+         *
+         * @return double Nm, at the cartridge output shaft
+         */
+        double getLeftTorque() const;
+        /**
+         * @brief Get the torque of each right motor during the last step
+         *
+         * @return double Nm, at the cartridge output shaft
+         */
+        double getRightTorque() const;
+        /**
+         * @brief Get the physical constants of the drivetrain
+         *
+         * @return const DiffDriveParams&
+         */
+        const DiffDriveParams& getParams() const;
+    private:
+        /**
+         * @brief Current drawn by one motor
+         *
+         * @param voltage applied voltage, in mV
+         * @param wheelSpeed speed of the wheel it drives, in m/s
+         * @param braking whether the motor is braking
+         * @return double mA
+         */
+        double motorCurrent(double voltage, double wheelSpeed, bool braking) const;
+
+        DiffDriveParams params;
+        Pose pose;
+        double velocity = 0; // m/s
+        double angularVelocity = 0; // rad/s, clockwise positive
+        double leftCurrent = 0;
+        double rightCurrent = 0;
+};
+} // namespace sim
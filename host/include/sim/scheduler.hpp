@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+
+namespace sim {
+/**
+ * @brief Virtual clock and cooperative task scheduler backing the fake PROS RTOS
+ *
+ * Every pros::Task runs on its own host thread, but only one of them is allowed to
+ * execute at a time. A task runs until it calls pros::delay (or blocks on a mutex),
+ * at which point the scheduler hands control to the task with the earliest wake time
+ * and jumps the virtual clock straight to it. Nothing ever sleeps in wall time, so a
+ * 60 second routine finishes as fast as the host can execute the control loops.
+ */
+
+/**
+ * @brief Get the current virtual time
+ *
+ * @return std::uint64_t microseconds since the simulation started
+ */
+std::uint64_t now();
+/**
+ * @brief Block the calling task until the virtual clock reaches the given time
+ *
+ * @param wakeTime absolute virtual time in microseconds
+ */
+void sleepUntil(std::uint64_t wakeTime);
+/**
+ * @brief Let every other task that is ready at the current time run first
+ */
+void yield();
+/**
+ * @brief Register a callback that is stepped once per simulated millisecond
+ *
+ * The physics model uses this to integrate between task wake-ups
+ *
+ * @param step the callback, called with the virtual time in milliseconds
+ */
+void onTick(std::function<void(std::uint32_t)> step);
+/**
+ * @brief Run a function as the first simulated task
+ *
+ * Runs until the function returns and the clock has run for settleTime more, or until the clock
+ * reaches timeLimit, whichever comes first. Tasks that are still alive afterwards are
+ * abandoned, so this should only be called once per process.
+ *
+ * @param entry the function to run, typically initialize() followed by autonomous()
+ * @param settleTime how long to keep simulating after entry returns, in milliseconds
+ * @param timeLimit hard limit on the virtual clock, in milliseconds
+ * @return std::uint32_t the virtual time when the run stopped, in milliseconds
+ */
+std::uint32_t run(std::function<void()> entry, std::uint32_t settleTime, std::uint32_t timeLimit);
+} // namespace sim
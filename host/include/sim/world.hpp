@@ -0,0 +1,209 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "pros/motors.h"
+#include "pros/misc.h"
+#include "sim/diffDrive.hpp"
+
+namespace sim {
+/**
+ * @brief Simulated state of a V5 smart motor
+ *
+ * Everything is stored in the motor's own frame, i.e. before the sign flip applied to
+ * reversed ports. Positions and velocities are of the cartridge output shaft.
+ */
+struct MotorState {
+        double voltage = 0; /** commanded voltage, in mV */
+        double velocity = 0; /** output shaft velocity, in rpm */
+        double position = 0; /** output shaft position since boot, in degrees */
+        double zero = 0; /** position that reads as 0, in degrees */
+        double current = 0; /** current draw, in mA */
+        double torque = 0; /** output torque, in Nm */
+        bool braking = false; /** true after brake() or a zero move command until the next nonzero one */
+        bool positionMode = false; /** true after move_absolute() until the next move command */
+        double targetPosition = 0; /** position target for move_absolute(), in degrees */
+        double targetVelocity = 0; /** velocity target, in rpm */
+        pros::motor_gearset_e_t gearset = pros::E_MOTOR_GEARSET_18;
+        pros::motor_brake_mode_e_t brakeMode = pros::E_MOTOR_BRAKE_COAST;
+        pros::motor_encoder_units_e_t encoderUnits = pros::E_MOTOR_ENCODER_DEGREES;
+        std::int32_t currentLimit = 2500;
+        std::int32_t voltageLimit = 0;
+        /** something is stuck in the mechanism. Holds the motor still while it's driven forwards,
+         * and clears once it's driven backwards. Only for motors outside the drivetrain */
+        bool jammed = false;
+};
+
+/**
+ * @brief Simulated state of a V5 inertial sensor
+ */
+struct ImuState {
+        double rotationOffset = 0; /** added to the true rotation, in degrees */
+        double headingOffset = 0; /** added to the true heading, in degrees */
+        std::uint64_t calibratedAt = 0; /** virtual time calibration finishes, in microseconds */
+};
+
+/**
+ * @brief Simulated state of a V5 controller
+ */
+struct ControllerState {
+        std::array<std::int32_t, 4> analog {};
+        std::array<bool, 12> digital {};
+        std::array<bool, 12> pressed {}; /** buttons whose press has already been reported */
+};
+
+/**
+ * @brief Simulated state of a V5 optical sensor
+ *
+ * Nothing drives these on its own, a harness that simulates game objects passing the sensor
+ * writes the color and proximity
+ */
+struct OpticalState {
+        double hue = 0; /** hue, from 0 to 359.999 degrees */
+        double saturation = 0; /** saturation, from 0 to 1 */
+        double brightness = 0; /** brightness, from 0 to 1 */
+        std::int32_t proximity = 0; /** proximity, from 0 to 255 */
+        std::int32_t ledPwm = 0; /** led brightness, from 0 to 100 */
+        double integrationTime = 100; /** update rate, in milliseconds */
+};
+
+/**
+ * @brief Where a simulated distance sensor is mounted
+ */
+struct DistanceMount {
+        bool mounted = false; /** unmounted sensors never see anything */
+        double x = 0; /** inches to the right of the tracking center */
+        double y = 0; /** inches forward of the tracking center */
+        double theta = 0; /** direction the sensor faces, in degrees clockwise from forwards */
+        std::int32_t reading = -1; /** reported as is instead of looking at the field, in mm, for sensors
+                                    * inside the robot. -1 to look at the field */
+};
+
+/**
+ * @brief Which motors drive which side of the robot, and how fast the wheels spin
+ *
+ * Ports are signed exactly as they are passed to pros::MotorGroup
+ */
+struct DrivetrainConfig {
+        std::vector<std::int8_t> leftPorts;
+        std::vector<std::int8_t> rightPorts;
+        double trackWidth = 12; /** inches */
+        double wheelDiameter = 3.25; /** inches */
+        double rpm = 450; /** wheel rpm at full voltage */
+};
+
+/**
+ * @brief Configure the simulated drivetrain
+ *
+ * Motors that are not part of the drivetrain are simulated as unloaded motors. Call this after
+ * the drive motors are constructed, the cartridge of the first left motor sets the gear ratio
+ *
+ * @param config the drivetrain configuration
+ */
+void configureDrivetrain(const DrivetrainConfig& config);
+/**
+ * @brief Get the ground truth pose of the robot
+ *
+ * @return Pose
+ */
+Pose robotPose();
+/**
+ * @brief Teleport the robot, and bring it to rest
+ *
+ * The drivetrain stops dead, its motors forget what they were last commanded and their encoders
+ * go back to 0, so nothing from before the teleport carries over
+ *
+ * @param pose the new ground truth pose
+ */
+void setRobotPose(Pose pose);
+/**
+ * @brief Advance the physics by one time step
+ *
+ * @param dt time step, in seconds
+ */
+void step(double dt);
+
+/**
+ * @brief Get the state of the motor on a smart port
+ *
+ * @param port smart port, 1-21. The sign is ignored
+ * @return MotorState&
+ */
+MotorState& motor(std::int8_t port);
+/**
+ * @brief Get the state of the inertial sensor on a smart port
+ *
+ * @param port smart port, 1-21
+ * @return ImuState&
+ */
+ImuState& imu(std::uint8_t port);
+/**
+ * @brief Get the position of the rotation sensor on a smart port
+ *
+ * Nothing drives these on its own, a harness that simulates tracking wheels writes them
+ *
+ * @param port smart port, 1-21
+ * @return std::int32_t& position, in centidegrees
+ */
+std::int32_t& rotationSensor(std::uint8_t port);
+/**
+ * @brief Get where the distance sensor on a smart port is mounted
+ *
+ * @param port smart port, 1-21
+ * @return DistanceMount&
+ */
+DistanceMount& distanceSensor(std::uint8_t port);
+/**
+ * @brief Get the state of the optical sensor on a smart port
+ *
+ * @param port smart port, 1-21
+ * @return OpticalState&
+ */
+OpticalState& opticalSensor(std::uint8_t port);
+/**
+ * @brief Cast a ray against the field perimeter and goals
+ *
+ * The ground truth pose is in field coordinates, with the origin at the center of the field
+ *
+ * @param x x position the ray starts at, in inches
+ * @param y y position the ray starts at, in inches
+ * @param theta direction of the ray in radians, clockwise from +y
+ * @return double distance to the closest wall or goal, in inches
+ */
+double castRay(double x, double y, double theta);
+/**
+ * @brief Get the true rotation of the robot as an inertial sensor would report it
+ *
+ * @return double rotation in degrees, clockwise positive
+ */
+double trueRotation();
+/**
+ * @brief Get the value last written to an ADI port
+ *
+ * @param smartPort smart port of the expander, or 22 for the brain
+ * @param adiPort ADI port, 1-8
+ * @return std::int32_t&
+ */
+std::int32_t& adi(std::uint8_t smartPort, std::uint8_t adiPort);
+/**
+ * @brief Get the state of a controller
+ *
+ * @param id which controller
+ * @return ControllerState&
+ */
+ControllerState& controller(pros::controller_id_e_t id);
+/**
+ * @brief Get the battery voltage
+ *
+ * @return std::int32_t& battery voltage, in mV
+ */
+std::int32_t& batteryVoltage();
+/**
+ * @brief Get the free speed of a cartridge
+ *
+ * @param gearset the cartridge
+ * @return double free speed of the output shaft, in rpm
+ */
+double cartridgeRpm(pros::motor_gearset_e_t gearset);
+} // namespace sim
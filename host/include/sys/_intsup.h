@@ -0,0 +1,4 @@
+#pragma once
+
+// newlib-only header that include/intake.hpp pulls in, glibc has no equivalent
+#include <stdint.h>
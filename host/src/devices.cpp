@@ -0,0 +1,462 @@
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <map>
+#include "pros/adi.hpp"
+#include "pros/device.hpp"
+#include "pros/distance.hpp"
+#include "pros/gps.hpp"
+#include "pros/imu.hpp"
+#include "pros/llemu.h"
+#include "pros/llemu.hpp"
+#include "pros/misc.hpp"
+#include "pros/optical.hpp"
+#include "pros/rotation.hpp"
+#include "sim/scheduler.hpp"
+#include "sim/world.hpp"
+
+namespace {
+// how long the inertial sensor takes to calibrate, in microseconds
+constexpr std::uint64_t IMU_CALIBRATION_TIME = 2000000;
+constexpr double METERS_PER_INCH = 0.0254;
+constexpr double MM_PER_INCH = 25.4;
+// distance sensors report this when nothing is in range, in mm
+constexpr std::int32_t NO_OBJECT = 9999;
+constexpr double MAX_DISTANCE = 2000;
+
+double wrapHeading(double heading) {
+    heading = std::fmod(heading, 360);
+    return heading < 0 ? heading + 360 : heading;
+}
+
+/**
+ * @brief Convert an ADI port given as 1-8, 'a'-'h' or 'A'-'H' to 1-8
+ */
+std::uint8_t adiIndex(std::uint8_t port) {
+    if (std::isalpha(port)) return std::tolower(port) - 'a' + 1;
+    return port;
+}
+
+std::map<std::pair<std::uint8_t, std::uint8_t>, bool> lastPressed;
+std::map<std::pair<std::uint8_t, std::uint8_t>, std::int32_t> encoderZero;
+} // namespace
+
+namespace pros {
+inline namespace v5 {
+Device::Device(const std::uint8_t port)
+    : _port(port),
+      _deviceType(DeviceType::undefined) {}
+
+std::uint8_t Device::get_port(void) const { return _port; }
+
+bool Device::is_installed() { return true; }
+
+std::int32_t Imu::reset(bool blocking) const {
+    sim::ImuState& state = sim::imu(_port);
+    state.calibratedAt = sim::now() + IMU_CALIBRATION_TIME;
+    state.rotationOffset = -sim::trueRotation();
+    state.headingOffset = -sim::trueRotation();
+    if (blocking) sim::sleepUntil(state.calibratedAt);
+    return 1;
+}
+
+std::int32_t Imu::set_data_rate(std::uint32_t) const { return 1; }
+
+double Imu::get_rotation() const { return sim::trueRotation() + sim::imu(_port).rotationOffset; }
+
+double Imu::get_heading() const { return wrapHeading(sim::trueRotation() + sim::imu(_port).headingOffset); }
+
+quaternion_s_t Imu::get_quaternion() const {
+    const double yaw = -get_yaw() * M_PI / 180;
+    return {0, 0, std::sin(yaw / 2), std::cos(yaw / 2)};
+}
+
+euler_s_t Imu::get_euler() const { return {get_pitch(), get_roll(), get_yaw()}; }
+
+double Imu::get_pitch() const { return 0; }
+
+double Imu::get_roll() const { return 0; }
+
+double Imu::get_yaw() const {
+    const double heading = get_heading();
+    return heading > 180 ? heading - 360 : heading;
+}
+
+imu_gyro_s_t Imu::get_gyro_rate() const { return {}; }
+
+std::int32_t Imu::tare_rotation() const { return set_rotation(0); }
+
+std::int32_t Imu::tare_heading() const { return set_heading(0); }
+
+std::int32_t Imu::tare_pitch() const { return 1; }
+
+std::int32_t Imu::tare_yaw() const { return set_yaw(0); }
+
+std::int32_t Imu::tare_roll() const { return 1; }
+
+std::int32_t Imu::tare() const {
+    tare_rotation();
+    return tare_heading();
+}
+
+std::int32_t Imu::tare_euler() const { return tare_yaw(); }
+
+std::int32_t Imu::set_heading(const double target) const {
+    sim::imu(_port).headingOffset = target - sim::trueRotation();
+    return 1;
+}
+
+std::int32_t Imu::set_rotation(const double target) const {
+    sim::imu(_port).rotationOffset = target - sim::trueRotation();
+    return 1;
+}
+
+std::int32_t Imu::set_yaw(const double target) const { return set_heading(target); }
+
+std::int32_t Imu::set_pitch(const double) const { return 1; }
+
+std::int32_t Imu::set_roll(const double) const { return 1; }
+
+std::int32_t Imu::set_euler(const euler_s_t target) const { return set_yaw(target.yaw); }
+
+imu_accel_s_t Imu::get_accel() const { return {}; }
+
+ImuStatus Imu::get_status() const { return is_calibrating() ? ImuStatus::calibrating : ImuStatus::ready; }
+
+bool Imu::is_calibrating() const { return sim::now() < sim::imu(_port).calibratedAt; }
+
+imu_orientation_e_t Imu::get_physical_orientation() const { return E_IMU_Z_UP; }
+
+Rotation::Rotation(const std::int8_t port)
+    : Device(std::abs(port), DeviceType::rotation) {
+    if (port < 0) set_reversed(true);
+}
+
+std::int32_t Rotation::reset() { return reset_position(); }
+
+std::int32_t Rotation::set_data_rate(std::uint32_t) const { return 1; }
+
+std::int32_t Rotation::set_position(std::int32_t position) const {
+    sim::rotationSensor(_port) = position;
+    return 1;
+}
+
+std::int32_t Rotation::reset_position(void) const { return set_position(0); }
+
+std::int32_t Rotation::get_position() const { return sim::rotationSensor(_port); }
+
+std::int32_t Rotation::get_velocity() const { return 0; }
+
+std::int32_t Rotation::get_angle() const {
+    const std::int32_t angle = sim::rotationSensor(_port) % 36000;
+    return angle < 0 ? angle + 36000 : angle;
+}
+
+std::int32_t Rotation::set_reversed(bool) const { return 1; }
+
+std::int32_t Rotation::reverse() const { return 1; }
+
+std::int32_t Rotation::get_reversed() const { return 0; }
+
+// the GPS sees the robot's ground truth, which is already in field coordinates
+std::int32_t Gps::initialize_full(double, double, double, double, double) const { return 1; }
+
+std::int32_t Gps::set_offset(double, double) const { return 1; }
+
+gps_position_s_t Gps::get_offset() const { return {0, 0}; }
+
+std::int32_t Gps::set_position(double, double, double) const { return 1; }
+
+std::int32_t Gps::set_data_rate(std::uint32_t) const { return 1; }
+
+double Gps::get_error() const { return 0.01; }
+
+gps_status_s_t Gps::get_position_and_orientation() const {
+    const sim::Pose pose = sim::robotPose();
+    return {pose.x * METERS_PER_INCH, pose.y * METERS_PER_INCH, 0, 0, get_yaw()};
+}
+
+gps_position_s_t Gps::get_position() const {
+    const sim::Pose pose = sim::robotPose();
+    return {pose.x * METERS_PER_INCH, pose.y * METERS_PER_INCH};
+}
+
+double Gps::get_position_x() const { return get_position().x; }
+
+double Gps::get_position_y() const { return get_position().y; }
+
+gps_orientation_s_t Gps::get_orientation() const { return {0, 0, get_yaw()}; }
+
+double Gps::get_pitch() const { return 0; }
+
+double Gps::get_roll() const { return 0; }
+
+double Gps::get_yaw() const {
+    const double heading = get_heading();
+    return heading > 180 ? heading - 360 : heading;
+}
+
+double Gps::get_heading() const { return wrapHeading(sim::trueRotation()); }
+
+double Gps::get_heading_raw() const { return get_heading(); }
+
+gps_gyro_s_t Gps::get_gyro_rate() const { return {}; }
+
+double Gps::get_gyro_rate_x() const { return 0; }
+
+double Gps::get_gyro_rate_y() const { return 0; }
+
+double Gps::get_gyro_rate_z() const { return 0; }
+
+gps_accel_s_t Gps::get_accel() const { return {}; }
+
+double Gps::get_accel_x() const { return 0; }
+
+double Gps::get_accel_y() const { return 0; }
+
+double Gps::get_accel_z() const { return 0; }
+
+Distance::Distance(const std::uint8_t port)
+    : Device(port, DeviceType::distance) {}
+
+std::int32_t Distance::get() {
+    const sim::DistanceMount& mount = sim::distanceSensor(_port);
+    if (mount.reading >= 0) return mount.reading;
+    if (!mount.mounted) return NO_OBJECT;
+    const sim::Pose pose = sim::robotPose();
+    const double x = pose.x + mount.x * std::cos(pose.theta) + mount.y * std::sin(pose.theta);
+    const double y = pose.y - mount.x * std::sin(pose.theta) + mount.y * std::cos(pose.theta);
+    const double distance = sim::castRay(x, y, pose.theta + mount.theta * M_PI / 180) * MM_PER_INCH;
+    return distance > MAX_DISTANCE ? NO_OBJECT : std::lround(distance);
+}
+
+std::int32_t Distance::get_distance() { return get(); }
+
+std::int32_t Distance::get_confidence() { return get() == NO_OBJECT ? 0 : 63; }
+
+std::int32_t Distance::get_object_size() { return get() == NO_OBJECT ? -1 : 200; }
+
+double Distance::get_object_velocity() { return 0; }
+
+Optical::Optical(const std::uint8_t port)
+    : Device(port, DeviceType::optical) {}
+
+double Optical::get_hue() { return sim::opticalSensor(_port).hue; }
+
+double Optical::get_saturation() { return sim::opticalSensor(_port).saturation; }
+
+double Optical::get_brightness() { return sim::opticalSensor(_port).brightness; }
+
+std::int32_t Optical::get_proximity() { return sim::opticalSensor(_port).proximity; }
+
+std::int32_t Optical::set_led_pwm(uint8_t value) {
+    sim::opticalSensor(_port).ledPwm = std::min<std::int32_t>(value, 100);
+    return 1;
+}
+
+std::int32_t Optical::get_led_pwm() { return sim::opticalSensor(_port).ledPwm; }
+
+pros::c::optical_rgb_s_t Optical::get_rgb() {
+    // hsv to rgb, with brightness as the value
+    const sim::OpticalState& state = sim::opticalSensor(_port);
+    const double chroma = state.brightness * state.saturation;
+    const double sector = std::fmod(state.hue / 60, 6);
+    const double second = chroma * (1 - std::abs(std::fmod(sector, 2) - 1));
+    const double min = state.brightness - chroma;
+    double red = 0, green = 0, blue = 0;
+    if (sector < 1) red = chroma, green = second;
+    else if (sector < 2) red = second, green = chroma;
+    else if (sector < 3) green = chroma, blue = second;
+    else if (sector < 4) green = second, blue = chroma;
+    else if (sector < 5) red = second, blue = chroma;
+    else red = chroma, blue = second;
+    return {(red + min) * 255, (green + min) * 255, (blue + min) * 255, state.brightness};
+}
+
+pros::c::optical_raw_s_t Optical::get_raw() {
+    const pros::c::optical_rgb_s_t rgb = get_rgb();
+    return {std::uint32_t(rgb.brightness * 255), std::uint32_t(rgb.red), std::uint32_t(rgb.green),
+            std::uint32_t(rgb.blue)};
+}
+
+pros::c::optical_direction_e_t Optical::get_gesture() { return pros::c::NO_GESTURE; }
+
+pros::c::optical_gesture_s_t Optical::get_gesture_raw() { return {}; }
+
+std::int32_t Optical::enable_gesture() { return 1; }
+
+std::int32_t Optical::disable_gesture() { return 1; }
+
+double Optical::get_integration_time() { return sim::opticalSensor(_port).integrationTime; }
+
+std::int32_t Optical::set_integration_time(double time) {
+    sim::opticalSensor(_port).integrationTime = std::clamp(time, 3.0, 712.0);
+    return 1;
+}
+
+Controller::Controller(controller_id_e_t id)
+    : _id(id) {}
+
+std::int32_t Controller::is_connected(void) { return 1; }
+
+std::int32_t Controller::get_analog(controller_analog_e_t channel) { return sim::controller(_id).analog.at(channel); }
+
+std::int32_t Controller::get_battery_capacity(void) { return 100; }
+
+std::int32_t Controller::get_battery_level(void) { return 100; }
+
+std::int32_t Controller::get_digital(controller_digital_e_t button) {
+    return sim::controller(_id).digital.at(button - E_CONTROLLER_DIGITAL_L1);
+}
+
+std::int32_t Controller::get_digital_new_press(controller_digital_e_t button) {
+    sim::ControllerState& state = sim::controller(_id);
+    const std::size_t index = button - E_CONTROLLER_DIGITAL_L1;
+    const bool newPress = state.digital.at(index) && !state.pressed.at(index);
+    state.pressed.at(index) = state.digital.at(index);
+    return newPress;
+}
+
+std::int32_t Controller::get_digital_new_release(controller_digital_e_t button) {
+    sim::ControllerState& state = sim::controller(_id);
+    const std::size_t index = button - E_CONTROLLER_DIGITAL_L1;
+    const bool newRelease = !state.digital.at(index) && state.pressed.at(index);
+    state.pressed.at(index) = state.digital.at(index);
+    return newRelease;
+}
+
+std::int32_t Controller::set_text(std::uint8_t, std::uint8_t, const char*) { return 1; }
+
+std::int32_t Controller::set_text(std::uint8_t, std::uint8_t, const std::string&) { return 1; }
+
+std::int32_t Controller::clear_line(std::uint8_t) { return 1; }
+
+std::int32_t Controller::rumble(const char*) { return 1; }
+
+std::int32_t Controller::clear(void) { return 1; }
+} // namespace v5
+
+namespace adi {
+Port::Port(std::uint8_t adi_port, adi_port_config_e_t)
+    : _smart_port(INTERNAL_ADI_PORT),
+      _adi_port(adiIndex(adi_port)) {}
+
+Port::Port(ext_adi_port_pair_t port_pair, adi_port_config_e_t)
+    : _smart_port(port_pair.first),
+      _adi_port(adiIndex(port_pair.second)) {}
+
+std::int32_t Port::get_value() const { return sim::adi(_smart_port, _adi_port); }
+
+std::int32_t Port::set_config(adi_port_config_e_t) const { return 1; }
+
+std::int32_t Port::set_value(std::int32_t value) const {
+    sim::adi(_smart_port, _adi_port) = value;
+    return 1;
+}
+
+ext_adi_port_tuple_t Port::get_port() const { return {_smart_port, _adi_port, 0}; }
+
+DigitalOut::DigitalOut(std::uint8_t adi_port, bool init_state)
+    : Port(adi_port, E_ADI_DIGITAL_OUT) {
+    set_value(init_state);
+}
+
+DigitalOut::DigitalOut(ext_adi_port_pair_t port_pair, bool init_state)
+    : Port(port_pair, E_ADI_DIGITAL_OUT) {
+    set_value(init_state);
+}
+
+DigitalIn::DigitalIn(std::uint8_t adi_port)
+    : Port(adi_port, E_ADI_DIGITAL_IN) {}
+
+DigitalIn::DigitalIn(ext_adi_port_pair_t port_pair)
+    : Port(port_pair, E_ADI_DIGITAL_IN) {}
+
+std::int32_t DigitalIn::get_new_press() const {
+    bool& last = lastPressed[{_smart_port, _adi_port}];
+    const bool pressed = get_value();
+    const bool newPress = pressed && !last;
+    last = pressed;
+    return newPress;
+}
+
+Encoder::Encoder(std::uint8_t adi_port_top, std::uint8_t adi_port_bottom, bool)
+    : Port(adi_port_top, E_ADI_LEGACY_ENCODER),
+      _port_pair(adiIndex(adi_port_top), adiIndex(adi_port_bottom)) {}
+
+Encoder::Encoder(ext_adi_port_tuple_t port_tuple, bool)
+    : Port({std::get<0>(port_tuple), std::get<1>(port_tuple)}, E_ADI_LEGACY_ENCODER),
+      _port_pair(adiIndex(std::get<1>(port_tuple)), adiIndex(std::get<2>(port_tuple))) {}
+
+std::int32_t Encoder::reset() const {
+    encoderZero[{_smart_port, _adi_port}] = Port::get_value();
+    return 1;
+}
+
+std::int32_t Encoder::get_value() const { return Port::get_value() - encoderZero[{_smart_port, _adi_port}]; }
+
+ext_adi_port_tuple_t Encoder::get_port() const { return {_smart_port, _port_pair.first, _port_pair.second}; }
+} // namespace adi
+
+namespace battery {
+double get_capacity(void) { return 100; }
+
+int32_t get_current(void) { return 0; }
+
+double get_temperature(void) { return 25; }
+
+int32_t get_voltage(void) { return sim::batteryVoltage(); }
+} // namespace battery
+
+namespace competition {
+std::uint8_t get_status(void) { return 0; }
+
+std::uint8_t is_autonomous(void) { return 0; }
+
+std::uint8_t is_connected(void) { return 0; }
+
+std::uint8_t is_disabled(void) { return 0; }
+
+std::uint8_t is_field_control(void) { return 0; }
+
+std::uint8_t is_competition_switch(void) { return 0; }
+} // namespace competition
+
+// the emulated brain screen prints to stdout, prefixed with the virtual time
+namespace lcd {
+bool is_initialized(void) { return true; }
+
+bool initialize(void) { return true; }
+
+bool shutdown(void) { return true; }
+
+bool set_text(std::int16_t line, std::string text) {
+    std::printf("[%6u ms] lcd %d: %s\n", static_cast<unsigned>(sim::now() / 1000), line, text.c_str());
+    return true;
+}
+
+bool clear(void) { return true; }
+
+bool clear_line(std::int16_t) { return true; }
+
+void register_btn0_cb(lcd_btn_cb_fn_t) {}
+
+void register_btn1_cb(lcd_btn_cb_fn_t) {}
+
+void register_btn2_cb(lcd_btn_cb_fn_t) {}
+
+std::uint8_t read_buttons(void) { return 0; }
+} // namespace lcd
+} // namespace pros
+
+extern "C" {
+namespace pros::c {
+int32_t battery_get_voltage(void) { return sim::batteryVoltage(); }
+
+int32_t controller_print(controller_id_e_t, uint8_t, uint8_t, const char*, ...) { return 1; }
+
+int32_t controller_rumble(controller_id_e_t, const char*) { return 1; }
+} // namespace pros::c
+}
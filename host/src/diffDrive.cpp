@@ -0,0 +1,71 @@
+#include <algorithm>
+#include <cmath>
+#include "sim/diffDrive.hpp"
+
+namespace sim {
+namespace {
+constexpr double METERS_PER_INCH = 0.0254;
+} // namespace
+
+DiffDrive::DiffDrive(const DiffDriveParams& params)
+    : params(params) {}
+
+double DiffDrive::motorCurrent(double voltage, double wheelSpeed, bool braking) const {
+    if (voltage == 0 && !braking) return 0;
+    const double wheelRadius = params.wheelDiameter / 2 * METERS_PER_INCH;
+    const double wheelFreeSpeed = params.rpm / 60 * 2 * M_PI * wheelRadius;
+    // the back EMF is proportional to the shaft speed, and reaches the supply voltage at free speed
+    const double current = params.stallCurrent * (voltage / 12000 - wheelSpeed / wheelFreeSpeed);
+    return std::clamp(current, -params.currentLimit, params.currentLimit);
+}
+
+void DiffDrive::step(double leftVoltage, double rightVoltage, double dt, bool leftBraking, bool rightBraking) {
+    const double halfTrack = params.trackWidth / 2 * METERS_PER_INCH;
+    const double wheelRadius = params.wheelDiameter / 2 * METERS_PER_INCH;
+    const double leftSpeed = velocity + angularVelocity * halfTrack;
+    const double rightSpeed = velocity - angularVelocity * halfTrack;
+    leftCurrent = motorCurrent(leftVoltage, leftSpeed, leftBraking);
+    rightCurrent = motorCurrent(rightVoltage, rightSpeed, rightBraking);
+
+    // force each side applies at the ground
+    const double gearRatio = params.cartridgeRpm / params.rpm;
+    const double forcePerMilliamp = params.stallTorque / params.stallCurrent * gearRatio / wheelRadius;
+    const double leftForce = leftCurrent * forcePerMilliamp * params.motorsPerSide;
+    const double rightForce = rightCurrent * forcePerMilliamp * params.motorsPerSide;
+
+    // semi-implicit Euler, so the drag terms stay stable at large time steps
+    const double acceleration = (leftForce + rightForce - params.linearDrag * velocity) / params.mass;
+    const double angularAcceleration =
+        ((leftForce - rightForce) * halfTrack - params.angularDrag * angularVelocity) / params.inertia;
+    velocity += acceleration * dt;
+    angularVelocity += angularAcceleration * dt;
+
+    const double speed = velocity / METERS_PER_INCH;
+    const double midTheta = pose.theta + angularVelocity * dt / 2;
+    pose.x += speed * std::sin(midTheta) * dt;
+    pose.y += speed * std::cos(midTheta) * dt;
+    pose.theta += angularVelocity * dt;
+}
+
+Pose DiffDrive::getPose() const { return pose; }
+
+void DiffDrive::setPose(const Pose& pose) { this->pose = pose; }
+
+double DiffDrive::getLeftSpeed() const {
+    return (velocity + angularVelocity * params.trackWidth / 2 * METERS_PER_INCH) / METERS_PER_INCH;
+}
+
+double DiffDrive::getRightSpeed() const {
+    return (velocity - angularVelocity * params.trackWidth / 2 * METERS_PER_INCH) / METERS_PER_INCH;
+}
+
+double DiffDrive::getLeftCurrent() const { return leftCurrent; }
+
+double DiffDrive::getRightCurrent() const { return rightCurrent; }
+
+double DiffDrive::getLeftTorque() const { return leftCurrent * params.stallTorque / params.stallCurrent; }
+
+double DiffDrive::getRightTorque() const { return rightCurrent * params.stallTorque / params.stallCurrent; }
+
+const DiffDriveParams& DiffDrive::getParams() const { return params; }
+} // namespace sim
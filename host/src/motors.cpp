@@ -0,0 +1,724 @@
+#include <algorithm>
+#include <cmath>
+#include "pros/motor_group.hpp"
+#include "pros/motors.hpp"
+#include "sim/world.hpp"
+
+namespace {
+double sign(std::int8_t port) { return port < 0 ? -1 : 1; }
+
+double ticksPerRev(pros::motor_gearset_e_t gearset) {
+    switch (gearset) {
+        case pros::E_MOTOR_GEARSET_36: return 1800;
+        case pros::E_MOTOR_GEARSET_06: return 300;
+        default: return 900;
+    }
+}
+
+void command(std::int8_t port, double voltage) {
+    sim::MotorState& state = sim::motor(port);
+    const double limit = state.voltageLimit > 0 ? state.voltageLimit : 12000;
+    state.voltage = std::clamp(sign(port) * voltage, -limit, limit);
+    // like a real motor, a zero command applies the brake mode
+    state.braking = voltage == 0;
+    state.positionMode = false;
+}
+} // namespace
+
+extern "C" {
+namespace pros::c {
+int32_t motor_move(int8_t port, int32_t voltage) {
+    command(port, std::clamp(voltage, -127, 127) * 12000.0 / 127);
+    return 1;
+}
+
+int32_t motor_brake(int8_t port) {
+    command(port, 0);
+    return 1;
+}
+
+int32_t motor_move_absolute(int8_t port, double position, const int32_t velocity) {
+    sim::MotorState& state = sim::motor(port);
+    command(port, 0);
+    state.braking = false;
+    state.positionMode = true;
+    state.targetVelocity = velocity;
+    switch (state.encoderUnits) {
+        case E_MOTOR_ENCODER_ROTATIONS: position *= 360; break;
+        case E_MOTOR_ENCODER_COUNTS: position *= 360 / ticksPerRev(state.gearset); break;
+        default: break;
+    }
+    state.targetPosition = state.zero + sign(port) * position;
+    return 1;
+}
+
+int32_t motor_move_relative(int8_t port, double position, const int32_t velocity) {
+    return motor_move_absolute(port, motor_get_position(port) + position, velocity);
+}
+
+int32_t motor_move_velocity(int8_t port, const int32_t velocity) {
+    sim::MotorState& state = sim::motor(port);
+    command(port, velocity / sim::cartridgeRpm(state.gearset) * 12000);
+    state.targetVelocity = sign(port) * velocity;
+    return 1;
+}
+
+int32_t motor_move_voltage(int8_t port, const int32_t voltage) {
+    command(port, voltage);
+    return 1;
+}
+
+int32_t motor_modify_profiled_velocity(int8_t port, const int32_t velocity) {
+    sim::motor(port).targetVelocity = velocity;
+    return 1;
+}
+
+double motor_get_target_position(int8_t port) {
+    const sim::MotorState& state = sim::motor(port);
+    return sign(port) * (state.targetPosition - state.zero);
+}
+
+int32_t motor_get_target_velocity(int8_t port) { return sign(port) * sim::motor(port).targetVelocity; }
+
+double motor_get_actual_velocity(int8_t port) { return sign(port) * sim::motor(port).velocity; }
+
+int32_t motor_get_current_draw(int8_t port) { return sim::motor(port).current; }
+
+int32_t motor_get_direction(int8_t port) { return motor_get_actual_velocity(port) < 0 ? -1 : 1; }
+
+double motor_get_efficiency(int8_t port) {
+    const sim::MotorState& state = sim::motor(port);
+    if (state.voltage == 0) return 0;
+    return std::clamp(100 * state.velocity / (state.voltage / 12000 * sim::cartridgeRpm(state.gearset)), 0.0, 100.0);
+}
+
+int32_t motor_is_over_current(int8_t port) {
+    const sim::MotorState& state = sim::motor(port);
+    return state.current >= state.currentLimit;
+}
+
+int32_t motor_is_over_temp(int8_t) { return 0; }
+
+uint32_t motor_get_faults(int8_t port) {
+    return motor_is_over_current(port) ? E_MOTOR_FAULT_OVER_CURRENT : E_MOTOR_FAULT_NO_FAULTS;
+}
+
+uint32_t motor_get_flags(int8_t port) {
+    return sim::motor(port).velocity == 0 ? E_MOTOR_FLAGS_ZERO_VELOCITY : E_MOTOR_FLAGS_NONE;
+}
+
+int32_t motor_get_raw_position(int8_t port, uint32_t* const timestamp) {
+    const sim::MotorState& state = sim::motor(port);
+    if (timestamp != nullptr) *timestamp = millis();
+    return std::lround(sign(port) * state.position / 360 * ticksPerRev(state.gearset));
+}
+
+double motor_get_position(int8_t port) {
+    const sim::MotorState& state = sim::motor(port);
+    const double degrees = sign(port) * (state.position - state.zero);
+    switch (state.encoderUnits) {
+        case E_MOTOR_ENCODER_ROTATIONS: return degrees / 360;
+        case E_MOTOR_ENCODER_COUNTS: return std::round(degrees / 360 * ticksPerRev(state.gearset));
+        default: return degrees;
+    }
+}
+
+double motor_get_power(int8_t port) {
+    const sim::MotorState& state = sim::motor(port);
+    return std::abs(state.voltage / 1000 * state.current / 1000);
+}
+
+double motor_get_temperature(int8_t) { return 25; }
+
+double motor_get_torque(int8_t port) { return sim::motor(port).torque; }
+
+int32_t motor_get_voltage(int8_t port) { return sign(port) * sim::motor(port).voltage; }
+
+int32_t motor_set_zero_position(int8_t port, const double position) {
+    sim::MotorState& state = sim::motor(port);
+    double degrees = position;
+    switch (state.encoderUnits) {
+        case E_MOTOR_ENCODER_ROTATIONS: degrees *= 360; break;
+        case E_MOTOR_ENCODER_COUNTS: degrees *= 360 / ticksPerRev(state.gearset); break;
+        default: break;
+    }
+    state.zero = sign(port) * degrees;
+    return 1;
+}
+
+int32_t motor_tare_position(int8_t port) {
+    sim::MotorState& state = sim::motor(port);
+    state.zero = state.position;
+    return 1;
+}
+
+int32_t motor_set_brake_mode(int8_t port, const motor_brake_mode_e_t mode) {
+    sim::motor(port).brakeMode = mode;
+    return 1;
+}
+
+int32_t motor_set_current_limit(int8_t port, const int32_t limit) {
+    sim::motor(port).currentLimit = limit;
+    return 1;
+}
+
+int32_t motor_set_encoder_units(int8_t port, const motor_encoder_units_e_t units) {
+    sim::motor(port).encoderUnits = units;
+    return 1;
+}
+
+int32_t motor_set_gearing(int8_t port, const motor_gearset_e_t gearset) {
+    sim::motor(port).gearset = gearset;
+    return 1;
+}
+
+int32_t motor_set_voltage_limit(int8_t port, const int32_t limit) {
+    sim::motor(port).voltageLimit = limit;
+    return 1;
+}
+
+motor_brake_mode_e_t motor_get_brake_mode(int8_t port) { return sim::motor(port).brakeMode; }
+
+int32_t motor_get_current_limit(int8_t port) { return sim::motor(port).currentLimit; }
+
+motor_encoder_units_e_t motor_get_encoder_units(int8_t port) { return sim::motor(port).encoderUnits; }
+
+motor_gearset_e_t motor_get_gearing(int8_t port) { return sim::motor(port).gearset; }
+
+int32_t motor_get_voltage_limit(int8_t port) { return sim::motor(port).voltageLimit; }
+
+motor_type_e_t motor_get_type(int8_t) { return E_MOTOR_TYPE_V5; }
+} // namespace pros::c
+}
+
+namespace pros {
+inline namespace v5 {
+Motor::Motor(const std::int8_t port, const MotorGears gearset, const MotorUnits encoder_units)
+    : Device(std::abs(port), DeviceType::motor),
+      _port(port) {
+    if (gearset != MotorGears::invalid) set_gearing(gearset);
+    if (encoder_units != MotorUnits::invalid) set_encoder_units(encoder_units);
+}
+
+std::int32_t Motor::move(std::int32_t voltage) const { return c::motor_move(_port, voltage); }
+
+std::int32_t Motor::move_absolute(const double position, const std::int32_t velocity) const {
+    return c::motor_move_absolute(_port, position, velocity);
+}
+
+std::int32_t Motor::move_relative(const double position, const std::int32_t velocity) const {
+    return c::motor_move_relative(_port, position, velocity);
+}
+
+std::int32_t Motor::move_velocity(const std::int32_t velocity) const { return c::motor_move_velocity(_port, velocity); }
+
+std::int32_t Motor::move_voltage(const std::int32_t voltage) const { return c::motor_move_voltage(_port, voltage); }
+
+std::int32_t Motor::brake(void) const { return c::motor_brake(_port); }
+
+std::int32_t Motor::modify_profiled_velocity(const std::int32_t velocity) const {
+    return c::motor_modify_profiled_velocity(_port, velocity);
+}
+
+double Motor::get_target_position(const std::uint8_t) const { return c::motor_get_target_position(_port); }
+
+std::int32_t Motor::get_target_velocity(const std::uint8_t) const { return c::motor_get_target_velocity(_port); }
+
+double Motor::get_actual_velocity(const std::uint8_t) const { return c::motor_get_actual_velocity(_port); }
+
+std::int32_t Motor::get_current_draw(const std::uint8_t) const { return c::motor_get_current_draw(_port); }
+
+std::int32_t Motor::get_direction(const std::uint8_t) const { return c::motor_get_direction(_port); }
+
+double Motor::get_efficiency(const std::uint8_t) const { return c::motor_get_efficiency(_port); }
+
+std::uint32_t Motor::get_faults(const std::uint8_t) const { return c::motor_get_faults(_port); }
+
+std::uint32_t Motor::get_flags(const std::uint8_t) const { return c::motor_get_flags(_port); }
+
+double Motor::get_position(const std::uint8_t) const { return c::motor_get_position(_port); }
+
+double Motor::get_power(const std::uint8_t) const { return c::motor_get_power(_port); }
+
+std::int32_t Motor::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t) const {
+    return c::motor_get_raw_position(_port, timestamp);
+}
+
+double Motor::get_temperature(const std::uint8_t) const { return c::motor_get_temperature(_port); }
+
+double Motor::get_torque(const std::uint8_t) const { return c::motor_get_torque(_port); }
+
+std::int32_t Motor::get_voltage(const std::uint8_t) const { return c::motor_get_voltage(_port); }
+
+std::int32_t Motor::is_over_current(const std::uint8_t) const { return c::motor_is_over_current(_port); }
+
+std::int32_t Motor::is_over_temp(const std::uint8_t) const { return c::motor_is_over_temp(_port); }
+
+MotorBrake Motor::get_brake_mode(const std::uint8_t) const {
+    return static_cast<MotorBrake>(c::motor_get_brake_mode(_port));
+}
+
+std::int32_t Motor::get_current_limit(const std::uint8_t) const { return c::motor_get_current_limit(_port); }
+
+MotorUnits Motor::get_encoder_units(const std::uint8_t) const {
+    return static_cast<MotorUnits>(c::motor_get_encoder_units(_port));
+}
+
+MotorGears Motor::get_gearing(const std::uint8_t) const {
+    return static_cast<MotorGears>(c::motor_get_gearing(_port));
+}
+
+std::int32_t Motor::get_voltage_limit(const std::uint8_t) const { return c::motor_get_voltage_limit(_port); }
+
+std::int32_t Motor::is_reversed(const std::uint8_t) const { return _port < 0; }
+
+MotorType Motor::get_type(const std::uint8_t) const { return static_cast<MotorType>(c::motor_get_type(_port)); }
+
+std::int32_t Motor::set_brake_mode(const MotorBrake mode, const std::uint8_t) const {
+    return c::motor_set_brake_mode(_port, static_cast<motor_brake_mode_e_t>(mode));
+}
+
+std::int32_t Motor::set_brake_mode(const motor_brake_mode_e_t mode, const std::uint8_t) const {
+    return c::motor_set_brake_mode(_port, mode);
+}
+
+std::int32_t Motor::set_current_limit(const std::int32_t limit, const std::uint8_t) const {
+    return c::motor_set_current_limit(_port, limit);
+}
+
+std::int32_t Motor::set_encoder_units(const MotorUnits units, const std::uint8_t) const {
+    return c::motor_set_encoder_units(_port, static_cast<motor_encoder_units_e_t>(units));
+}
+
+std::int32_t Motor::set_encoder_units(const motor_encoder_units_e_t units, const std::uint8_t) const {
+    return c::motor_set_encoder_units(_port, units);
+}
+
+std::int32_t Motor::set_gearing(const MotorGears gearset, const std::uint8_t) const {
+    return c::motor_set_gearing(_port, static_cast<motor_gearset_e_t>(gearset));
+}
+
+std::int32_t Motor::set_gearing(const motor_gearset_e_t gearset, const std::uint8_t) const {
+    return c::motor_set_gearing(_port, gearset);
+}
+
+std::int32_t Motor::set_reversed(const bool reverse, const std::uint8_t) {
+    _port = reverse ? -std::abs(_port) : std::abs(_port);
+    return 1;
+}
+
+std::int32_t Motor::set_voltage_limit(const std::int32_t limit, const std::uint8_t) const {
+    return c::motor_set_voltage_limit(_port, limit);
+}
+
+std::int32_t Motor::set_zero_position(const double position, const std::uint8_t) const {
+    return c::motor_set_zero_position(_port, position);
+}
+
+std::int32_t Motor::tare_position(const std::uint8_t) const { return c::motor_tare_position(_port); }
+
+std::int8_t Motor::size(void) const { return 1; }
+
+std::int8_t Motor::get_port(const std::uint8_t) const { return _port; }
+
+std::vector<double> Motor::get_target_position_all(void) const { return {get_target_position()}; }
+
+std::vector<std::int32_t> Motor::get_target_velocity_all(void) const { return {get_target_velocity()}; }
+
+std::vector<double> Motor::get_actual_velocity_all(void) const { return {get_actual_velocity()}; }
+
+std::vector<std::int32_t> Motor::get_current_draw_all(void) const { return {get_current_draw()}; }
+
+std::vector<std::int32_t> Motor::get_direction_all(void) const { return {get_direction()}; }
+
+std::vector<double> Motor::get_efficiency_all(void) const { return {get_efficiency()}; }
+
+std::vector<std::uint32_t> Motor::get_faults_all(void) const { return {get_faults()}; }
+
+std::vector<std::uint32_t> Motor::get_flags_all(void) const { return {get_flags()}; }
+
+std::vector<double> Motor::get_position_all(void) const { return {get_position()}; }
+
+std::vector<double> Motor::get_power_all(void) const { return {get_power()}; }
+
+std::vector<std::int32_t> Motor::get_raw_position_all(std::uint32_t* const timestamp) const {
+    return {get_raw_position(timestamp)};
+}
+
+std::vector<double> Motor::get_temperature_all(void) const { return {get_temperature()}; }
+
+std::vector<double> Motor::get_torque_all(void) const { return {get_torque()}; }
+
+std::vector<std::int32_t> Motor::get_voltage_all(void) const { return {get_voltage()}; }
+
+std::vector<std::int32_t> Motor::is_over_current_all(void) const { return {is_over_current()}; }
+
+std::vector<std::int32_t> Motor::is_over_temp_all(void) const { return {is_over_temp()}; }
+
+std::vector<MotorBrake> Motor::get_brake_mode_all(void) const { return {get_brake_mode()}; }
+
+std::vector<std::int32_t> Motor::get_current_limit_all(void) const { return {get_current_limit()}; }
+
+std::vector<MotorUnits> Motor::get_encoder_units_all(void) const { return {get_encoder_units()}; }
+
+std::vector<MotorGears> Motor::get_gearing_all(void) const { return {get_gearing()}; }
+
+std::vector<std::int8_t> Motor::get_port_all(void) const { return {_port}; }
+
+std::vector<std::int32_t> Motor::get_voltage_limit_all(void) const { return {get_voltage_limit()}; }
+
+std::vector<std::int32_t> Motor::is_reversed_all(void) const { return {is_reversed()}; }
+
+std::vector<MotorType> Motor::get_type_all(void) const { return {get_type()}; }
+
+std::int32_t Motor::set_brake_mode_all(const MotorBrake mode) const { return set_brake_mode(mode); }
+
+std::int32_t Motor::set_brake_mode_all(const motor_brake_mode_e_t mode) const { return set_brake_mode(mode); }
+
+std::int32_t Motor::set_current_limit_all(const std::int32_t limit) const { return set_current_limit(limit); }
+
+std::int32_t Motor::set_encoder_units_all(const MotorUnits units) const { return set_encoder_units(units); }
+
+std::int32_t Motor::set_encoder_units_all(const motor_encoder_units_e_t units) const {
+    return set_encoder_units(units);
+}
+
+std::int32_t Motor::set_gearing_all(const MotorGears gearset) const { return set_gearing(gearset); }
+
+std::int32_t Motor::set_gearing_all(const motor_gearset_e_t gearset) const { return set_gearing(gearset); }
+
+std::int32_t Motor::set_reversed_all(const bool reverse) { return set_reversed(reverse); }
+
+std::int32_t Motor::set_voltage_limit_all(const std::int32_t limit) const { return set_voltage_limit(limit); }
+
+std::int32_t Motor::set_zero_position_all(const double position) const { return set_zero_position(position); }
+
+std::int32_t Motor::tare_position_all(void) const { return tare_position(); }
+
+MotorGroup::MotorGroup(const std::initializer_list<std::int8_t> ports, const MotorGears gearset,
+                       const MotorUnits encoder_units)
+    : MotorGroup(std::vector<std::int8_t>(ports), gearset, encoder_units) {}
+
+MotorGroup::MotorGroup(const std::vector<std::int8_t>& ports, const MotorGears gearset, const MotorUnits encoder_units)
+    : _ports(ports) {
+    if (gearset != MotorGears::invalid) set_gearing_all(gearset);
+    if (encoder_units != MotorUnits::invalid) set_encoder_units_all(encoder_units);
+}
+
+MotorGroup::MotorGroup(AbstractMotor& motor_group)
+    : _ports(motor_group.get_port_all()) {}
+
+// applies a C API call to every motor in the group, returning the first error if there is one
+#define FOR_EACH_PORT(call)                                                                                            \
+    std::int32_t result = 1;                                                                                           \
+    for (std::int8_t port : _ports) {                                                                                  \
+        const std::int32_t status = call;                                                                              \
+        if (status != 1 && result == 1) result = status;                                                               \
+    }                                                                                                                  \
+    return result;
+
+// reads one value per motor into a vector
+#define COLLECT(type, call)                                                                                            \
+    std::vector<type> values;                                                                                          \
+    values.reserve(_ports.size());                                                                                     \
+    for (std::int8_t port : _ports) values.push_back(call);                                                           \
+    return values;
+
+std::int32_t MotorGroup::move(std::int32_t voltage) const { FOR_EACH_PORT(c::motor_move(port, voltage)) }
+
+std::int32_t MotorGroup::move_absolute(const double position, const std::int32_t velocity) const {
+    FOR_EACH_PORT(c::motor_move_absolute(port, position, velocity))
+}
+
+std::int32_t MotorGroup::move_relative(const double position, const std::int32_t velocity) const {
+    FOR_EACH_PORT(c::motor_move_relative(port, position, velocity))
+}
+
+std::int32_t MotorGroup::move_velocity(const std::int32_t velocity) const {
+    FOR_EACH_PORT(c::motor_move_velocity(port, velocity))
+}
+
+std::int32_t MotorGroup::move_voltage(const std::int32_t voltage) const {
+    FOR_EACH_PORT(c::motor_move_voltage(port, voltage))
+}
+
+std::int32_t MotorGroup::brake(void) const { FOR_EACH_PORT(c::motor_brake(port)) }
+
+std::int32_t MotorGroup::modify_profiled_velocity(const std::int32_t velocity) const {
+    FOR_EACH_PORT(c::motor_modify_profiled_velocity(port, velocity))
+}
+
+double MotorGroup::get_target_position(const std::uint8_t index) const {
+    return c::motor_get_target_position(_ports.at(index));
+}
+
+std::int32_t MotorGroup::get_target_velocity(const std::uint8_t index) const {
+    return c::motor_get_target_velocity(_ports.at(index));
+}
+
+double MotorGroup::get_actual_velocity(const std::uint8_t index) const {
+    return c::motor_get_actual_velocity(_ports.at(index));
+}
+
+std::int32_t MotorGroup::get_current_draw(const std::uint8_t index) const {
+    return c::motor_get_current_draw(_ports.at(index));
+}
+
+std::int32_t MotorGroup::get_direction(const std::uint8_t index) const {
+    return c::motor_get_direction(_ports.at(index));
+}
+
+double MotorGroup::get_efficiency(const std::uint8_t index) const { return c::motor_get_efficiency(_ports.at(index)); }
+
+std::uint32_t MotorGroup::get_faults(const std::uint8_t index) const { return c::motor_get_faults(_ports.at(index)); }
+
+std::uint32_t MotorGroup::get_flags(const std::uint8_t index) const { return c::motor_get_flags(_ports.at(index)); }
+
+double MotorGroup::get_position(const std::uint8_t index) const { return c::motor_get_position(_ports.at(index)); }
+
+double MotorGroup::get_power(const std::uint8_t index) const { return c::motor_get_power(_ports.at(index)); }
+
+std::int32_t MotorGroup::get_raw_position(std::uint32_t* const timestamp, const std::uint8_t index) const {
+    return c::motor_get_raw_position(_ports.at(index), timestamp);
+}
+
+double MotorGroup::get_temperature(const std::uint8_t index) const {
+    return c::motor_get_temperature(_ports.at(index));
+}
+
+double MotorGroup::get_torque(const std::uint8_t index) const { return c::motor_get_torque(_ports.at(index)); }
+
+std::int32_t MotorGroup::get_voltage(const std::uint8_t index) const { return c::motor_get_voltage(_ports.at(index)); }
+
+std::int32_t MotorGroup::is_over_current(const std::uint8_t index) const {
+    return c::motor_is_over_current(_ports.at(index));
+}
+
+std::int32_t MotorGroup::is_over_temp(const std::uint8_t index) const {
+    return c::motor_is_over_temp(_ports.at(index));
+}
+
+MotorBrake MotorGroup::get_brake_mode(const std::uint8_t index) const {
+    return static_cast<MotorBrake>(c::motor_get_brake_mode(_ports.at(index)));
+}
+
+std::int32_t MotorGroup::get_current_limit(const std::uint8_t index) const {
+    return c::motor_get_current_limit(_ports.at(index));
+}
+
+MotorUnits MotorGroup::get_encoder_units(const std::uint8_t index) const {
+    return static_cast<MotorUnits>(c::motor_get_encoder_units(_ports.at(index)));
+}
+
+MotorGears MotorGroup::get_gearing(const std::uint8_t index) const {
+    return static_cast<MotorGears>(c::motor_get_gearing(_ports.at(index)));
+}
+
+std::int32_t MotorGroup::get_voltage_limit(const std::uint8_t index) const {
+    return c::motor_get_voltage_limit(_ports.at(index));
+}
+
+std::int32_t MotorGroup::is_reversed(const std::uint8_t index) const { return _ports.at(index) < 0; }
+
+MotorType MotorGroup::get_type(const std::uint8_t index) const {
+    return static_cast<MotorType>(c::motor_get_type(_ports.at(index)));
+}
+
+std::vector<double> MotorGroup::get_target_position_all(void) const {
+    COLLECT(double, c::motor_get_target_position(port))
+}
+
+std::vector<std::int32_t> MotorGroup::get_target_velocity_all(void) const {
+    COLLECT(std::int32_t, c::motor_get_target_velocity(port))
+}
+
+std::vector<double> MotorGroup::get_actual_velocity_all(void) const {
+    COLLECT(double, c::motor_get_actual_velocity(port))
+}
+
+std::vector<std::int32_t> MotorGroup::get_current_draw_all(void) const {
+    COLLECT(std::int32_t, c::motor_get_current_draw(port))
+}
+
+std::vector<std::int32_t> MotorGroup::get_direction_all(void) const {
+    COLLECT(std::int32_t, c::motor_get_direction(port))
+}
+
+std::vector<double> MotorGroup::get_efficiency_all(void) const { COLLECT(double, c::motor_get_efficiency(port)) }
+
+std::vector<std::uint32_t> MotorGroup::get_faults_all(void) const {
+    COLLECT(std::uint32_t, c::motor_get_faults(port))
+}
+
+std::vector<std::uint32_t> MotorGroup::get_flags_all(void) const { COLLECT(std::uint32_t, c::motor_get_flags(port)) }
+
+std::vector<double> MotorGroup::get_position_all(void) const { COLLECT(double, c::motor_get_position(port)) }
+
+std::vector<double> MotorGroup::get_power_all(void) const { COLLECT(double, c::motor_get_power(port)) }
+
+std::vector<std::int32_t> MotorGroup::get_raw_position_all(std::uint32_t* const timestamp) const {
+    COLLECT(std::int32_t, c::motor_get_raw_position(port, timestamp))
+}
+
+std::vector<double> MotorGroup::get_temperature_all(void) const { COLLECT(double, c::motor_get_temperature(port)) }
+
+std::vector<double> MotorGroup::get_torque_all(void) const { COLLECT(double, c::motor_get_torque(port)) }
+
+std::vector<std::int32_t> MotorGroup::get_voltage_all(void) const {
+    COLLECT(std::int32_t, c::motor_get_voltage(port))
+}
+
+std::vector<std::int32_t> MotorGroup::is_over_current_all(void) const {
+    COLLECT(std::int32_t, c::motor_is_over_current(port))
+}
+
+std::vector<std::int32_t> MotorGroup::is_over_temp_all(void) const {
+    COLLECT(std::int32_t, c::motor_is_over_temp(port))
+}
+
+std::vector<MotorBrake> MotorGroup::get_brake_mode_all(void) const {
+    COLLECT(MotorBrake, static_cast<MotorBrake>(c::motor_get_brake_mode(port)))
+}
+
+std::vector<std::int32_t> MotorGroup::get_current_limit_all(void) const {
+    COLLECT(std::int32_t, c::motor_get_current_limit(port))
+}
+
+std::vector<MotorUnits> MotorGroup::get_encoder_units_all(void) const {
+    COLLECT(MotorUnits, static_cast<MotorUnits>(c::motor_get_encoder_units(port)))
+}
+
+std::vector<MotorGears> MotorGroup::get_gearing_all(void) const {
+    COLLECT(MotorGears, static_cast<MotorGears>(c::motor_get_gearing(port)))
+}
+
+std::vector<std::int8_t> MotorGroup::get_port_all(void) const { return _ports; }
+
+std::vector<std::int32_t> MotorGroup::get_voltage_limit_all(void) const {
+    COLLECT(std::int32_t, c::motor_get_voltage_limit(port))
+}
+
+std::vector<std::int32_t> MotorGroup::is_reversed_all(void) const { COLLECT(std::int32_t, port < 0) }
+
+std::vector<MotorType> MotorGroup::get_type_all(void) const {
+    COLLECT(MotorType, static_cast<MotorType>(c::motor_get_type(port)))
+}
+
+std::int32_t MotorGroup::set_brake_mode(const MotorBrake mode, const std::uint8_t index) const {
+    return c::motor_set_brake_mode(_ports.at(index), static_cast<motor_brake_mode_e_t>(mode));
+}
+
+std::int32_t MotorGroup::set_brake_mode(const motor_brake_mode_e_t mode, const std::uint8_t index) const {
+    return c::motor_set_brake_mode(_ports.at(index), mode);
+}
+
+std::int32_t MotorGroup::set_brake_mode_all(const MotorBrake mode) const {
+    FOR_EACH_PORT(c::motor_set_brake_mode(port, static_cast<motor_brake_mode_e_t>(mode)))
+}
+
+std::int32_t MotorGroup::set_brake_mode_all(const motor_brake_mode_e_t mode) const {
+    FOR_EACH_PORT(c::motor_set_brake_mode(port, mode))
+}
+
+std::int32_t MotorGroup::set_current_limit(const std::int32_t limit, const std::uint8_t index) const {
+    return c::motor_set_current_limit(_ports.at(index), limit);
+}
+
+std::int32_t MotorGroup::set_current_limit_all(const std::int32_t limit) const {
+    FOR_EACH_PORT(c::motor_set_current_limit(port, limit))
+}
+
+std::int32_t MotorGroup::set_encoder_units(const MotorUnits units, const std::uint8_t index) const {
+    return c::motor_set_encoder_units(_ports.at(index), static_cast<motor_encoder_units_e_t>(units));
+}
+
+std::int32_t MotorGroup::set_encoder_units(const motor_encoder_units_e_t units, const std::uint8_t index) const {
+    return c::motor_set_encoder_units(_ports.at(index), units);
+}
+
+std::int32_t MotorGroup::set_encoder_units_all(const MotorUnits units) const {
+    FOR_EACH_PORT(c::motor_set_encoder_units(port, static_cast<motor_encoder_units_e_t>(units)))
+}
+
+std::int32_t MotorGroup::set_encoder_units_all(const motor_encoder_units_e_t units) const {
+    FOR_EACH_PORT(c::motor_set_encoder_units(port, units))
+}
+
+std::int32_t MotorGroup::set_gearing(std::vector<motor_gearset_e_t> gearsets) const {
+    for (std::size_t i = 0; i < _ports.size() && i < gearsets.size(); i++) c::motor_set_gearing(_ports[i], gearsets[i]);
+    return 1;
+}
+
+std::int32_t MotorGroup::set_gearing(const motor_gearset_e_t gearset, const std::uint8_t index) const {
+    return c::motor_set_gearing(_ports.at(index), gearset);
+}
+
+std::int32_t MotorGroup::set_gearing(std::vector<MotorGears> gearsets) const {
+    for (std::size_t i = 0; i < _ports.size() && i < gearsets.size(); i++)
+        c::motor_set_gearing(_ports[i], static_cast<motor_gearset_e_t>(gearsets[i]));
+    return 1;
+}
+
+std::int32_t MotorGroup::set_gearing(const MotorGears gearset, const std::uint8_t index) const {
+    return c::motor_set_gearing(_ports.at(index), static_cast<motor_gearset_e_t>(gearset));
+}
+
+std::int32_t MotorGroup::set_gearing_all(const MotorGears gearset) const {
+    FOR_EACH_PORT(c::motor_set_gearing(port, static_cast<motor_gearset_e_t>(gearset)))
+}
+
+std::int32_t MotorGroup::set_gearing_all(const motor_gearset_e_t gearset) const {
+    FOR_EACH_PORT(c::motor_set_gearing(port, gearset))
+}
+
+std::int32_t MotorGroup::set_reversed(const bool reverse, const std::uint8_t index) {
+    std::int8_t& port = _ports.at(index);
+    port = reverse ? -std::abs(port) : std::abs(port);
+    return 1;
+}
+
+std::int32_t MotorGroup::set_reversed_all(const bool reverse) {
+    for (std::int8_t& port : _ports) port = reverse ? -std::abs(port) : std::abs(port);
+    return 1;
+}
+
+std::int32_t MotorGroup::set_voltage_limit(const std::int32_t limit, const std::uint8_t index) const {
+    return c::motor_set_voltage_limit(_ports.at(index), limit);
+}
+
+std::int32_t MotorGroup::set_voltage_limit_all(const std::int32_t limit) const {
+    FOR_EACH_PORT(c::motor_set_voltage_limit(port, limit))
+}
+
+std::int32_t MotorGroup::set_zero_position(const double position, const std::uint8_t index) const {
+    return c::motor_set_zero_position(_ports.at(index), position);
+}
+
+std::int32_t MotorGroup::set_zero_position_all(const double position) const {
+    FOR_EACH_PORT(c::motor_set_zero_position(port, position))
+}
+
+std::int32_t MotorGroup::tare_position(const std::uint8_t index) const {
+    return c::motor_tare_position(_ports.at(index));
+}
+
+std::int32_t MotorGroup::tare_position_all(void) const { FOR_EACH_PORT(c::motor_tare_position(port)) }
+
+std::int8_t MotorGroup::size(void) const { return _ports.size(); }
+
+std::int8_t MotorGroup::get_port(const std::uint8_t index) const { return _ports.at(index); }
+
+void MotorGroup::operator+=(AbstractMotor& other) { append(other); }
+
+void MotorGroup::append(AbstractMotor& other) {
+    for (std::int8_t port : other.get_port_all()) _ports.push_back(port);
+}
+
+void MotorGroup::erase_port(std::int8_t port) {
+    std::erase_if(_ports, [port](std::int8_t p) { return std::abs(p) == std::abs(port); });
+}
+
+#undef FOR_EACH_PORT
+#undef COLLECT
+} // namespace v5
+} // namespace pros
@@ -0,0 +1,113 @@
+#include <cerrno>
+#include <system_error>
+#include "pros/rtos.hpp"
+
+namespace pros {
+Task::Task(task_fn_t function, void* parameters, std::uint32_t prio, std::uint16_t stack_depth, const char* name)
+    : task(c::task_create(function, parameters, prio, stack_depth, name)) {}
+
+Task::Task(task_fn_t function, void* parameters, const char* name)
+    : Task(function, parameters, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, name) {}
+
+Task::Task(task_t task)
+    : task(task) {}
+
+Task Task::current() { return Task(c::task_get_current()); }
+
+Task& Task::operator=(task_t in) {
+    task = in;
+    return *this;
+}
+
+void Task::remove() { c::task_delete(task); }
+
+std::uint32_t Task::get_priority() { return c::task_get_priority(task); }
+
+void Task::set_priority(std::uint32_t prio) { c::task_set_priority(task, prio); }
+
+std::uint32_t Task::get_state() { return c::task_get_state(task); }
+
+void Task::suspend() { c::task_suspend(task); }
+
+void Task::resume() { c::task_resume(task); }
+
+const char* Task::get_name() { return c::task_get_name(task); }
+
+std::uint32_t Task::notify() { return c::task_notify(task); }
+
+void Task::join() { c::task_join(task); }
+
+std::uint32_t Task::notify_ext(std::uint32_t value, notify_action_e_t action, std::uint32_t* prev_value) {
+    return c::task_notify_ext(task, value, action, prev_value);
+}
+
+std::uint32_t Task::notify_take(bool clear_on_exit, std::uint32_t timeout) {
+    return c::task_notify_take(clear_on_exit, timeout);
+}
+
+bool Task::notify_clear() { return c::task_notify_clear(task); }
+
+void Task::delay(const std::uint32_t milliseconds) { c::task_delay(milliseconds); }
+
+void Task::delay_until(std::uint32_t* const prev_time, const std::uint32_t delta) {
+    c::task_delay_until(prev_time, delta);
+}
+
+std::uint32_t Task::get_count() { return c::task_get_count(); }
+
+Clock::time_point Clock::now() { return time_point(duration(c::millis())); }
+
+mutex_t Mutex::lazy_init() {
+    mutex_t current = mutex.load();
+    if (current != nullptr) return current;
+    mutex_t created = c::mutex_create();
+    if (!mutex.compare_exchange_strong(current, created)) {
+        c::mutex_delete(created);
+        return current;
+    }
+    return created;
+}
+
+bool Mutex::take() { return c::mutex_take(lazy_init(), TIMEOUT_MAX); }
+
+bool Mutex::take(std::uint32_t timeout) { return c::mutex_take(lazy_init(), timeout); }
+
+bool Mutex::give() { return c::mutex_give(lazy_init()); }
+
+void Mutex::lock() {
+    if (!take()) throw std::system_error(errno, std::system_category(), "Cannot obtain lock!");
+}
+
+void Mutex::unlock() { give(); }
+
+bool Mutex::try_lock() { return take(0); }
+
+Mutex::~Mutex() { c::mutex_delete(mutex.load()); }
+
+mutex_t RecursiveMutex::lazy_init() {
+    mutex_t current = mutex.load();
+    if (current != nullptr) return current;
+    mutex_t created = c::mutex_recursive_create();
+    if (!mutex.compare_exchange_strong(current, created)) {
+        c::mutex_delete(created);
+        return current;
+    }
+    return created;
+}
+
+bool RecursiveMutex::take() { return c::mutex_recursive_take(lazy_init(), TIMEOUT_MAX); }
+
+bool RecursiveMutex::take(std::uint32_t timeout) { return c::mutex_recursive_take(lazy_init(), timeout); }
+
+bool RecursiveMutex::give() { return c::mutex_recursive_give(lazy_init()); }
+
+void RecursiveMutex::lock() {
+    if (!take()) throw std::system_error(errno, std::system_category(), "Cannot obtain lock!");
+}
+
+void RecursiveMutex::unlock() { give(); }
+
+bool RecursiveMutex::try_lock() { return take(0); }
+
+RecursiveMutex::~RecursiveMutex() { c::mutex_delete(mutex.load()); }
+} // namespace pros
@@ -0,0 +1,262 @@
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include "main.h"
+#include "lemlib/api.hpp" // IWYU pragma: keep
+#include "blockCounter.hpp"
+#include "descore.hpp"
+#include "intake.hpp"
+#include "littleWill.hpp"
+#include "sim/scheduler.hpp"
+#include "sim/world.hpp"
+
+// defined in src/main.cpp
+extern int autonSelection;
+extern lemlib::Chassis chassis;
+
+namespace {
+// the real autonomous period is 15 seconds, skills is 60
+constexpr std::uint32_t DEFAULT_TIME_LIMIT = 60000;
+// keep simulating after autonomous returns so the robot can coast to a stop
+constexpr std::uint32_t SETTLE_TIME = 500;
+
+// smart ports of the intake rollers in src/intake.cpp
+constexpr std::int8_t BOTTOM_INTAKE_PORT = 19;
+constexpr std::int8_t INDEXER_PORT = 17;
+
+/**
+ * @brief Jam the bottom roller while scoring in the long goal, and print how the intake task clears it
+ */
+void intakeJam() {
+    const std::uint32_t start = pros::millis();
+    outtakeLong(127);
+    pros::delay(500);
+    sim::motor(BOTTOM_INTAKE_PORT).jammed = true;
+    std::printf("[%6u ms] bottom roller jammed\n", pros::millis() - start);
+    bool unjamming = false;
+    bool recovered = false;
+    while (pros::millis() - start < 2000) {
+        if (isIntakeUnjamming() != unjamming) {
+            unjamming = !unjamming;
+            std::printf("[%6u ms] %s\n", pros::millis() - start, unjamming ? "reversing" : "resumed");
+        }
+        if (!recovered && !unjamming && getIntakeJamCount() > 0 &&
+            sim::motor(BOTTOM_INTAKE_PORT).velocity > 540 && sim::motor(INDEXER_PORT).velocity > 540) {
+            recovered = true;
+            std::printf("[%6u ms] both rollers back over 540 rpm\n", pros::millis() - start);
+        }
+        pros::delay(10);
+    }
+    intakeStop();
+    std::printf("jams cleared: %d\n", getIntakeJamCount());
+}
+
+/**
+ * @brief Fill the hopper while storing, so both rollers stall against the closed hood, and print
+ * whether the intake task mistook it for a jam
+ */
+void intakeFullHopper() {
+    const std::uint32_t start = pros::millis();
+    intakeStore(127);
+    pros::delay(500);
+    sim::motor(BOTTOM_INTAKE_PORT).jammed = true;
+    sim::motor(INDEXER_PORT).jammed = true;
+    std::printf("[%6u ms] hopper full\n", pros::millis() - start);
+    bool reversed = false;
+    while (pros::millis() - start < 3000) {
+        reversed = reversed || sim::motor(BOTTOM_INTAKE_PORT).voltage < 0 || sim::motor(INDEXER_PORT).voltage < 0;
+        pros::delay(1);
+    }
+    intakeStop();
+    std::printf("jams cleared: %d, rollers reversed: %s\n", getIntakeJamCount(), reversed ? "yes" : "no");
+}
+
+/**
+ * @brief Score blocks back to back at full speed, with waitUntilScored ending the step like an
+ * auton would, and print how many the block counter saw
+ *
+ * The blocks ride the indexer at its surface speed, as close as the intake picks them up, and
+ * the block sensor reads near while one is in front of it
+ */
+void backToBackBlocks() {
+    constexpr int BLOCKS = 7;
+    constexpr double BLOCK_LENGTH = 3.25; // inches
+    constexpr double BLOCK_GAP = 2; // inches between one block and the next
+    constexpr double ROLLER_DIAMETER = 2; // inches
+    constexpr std::uint8_t BLOCK_SENSOR_PORT = 18;
+    constexpr std::int32_t BLOCK_NEAR = 20; // mm to a block in front of the sensor
+    constexpr std::int32_t BLOCK_FAR = 120; // mm across the empty path
+    static double traveled = 0; // how far the blocks have moved, in inches
+    static bool feeding = true;
+    traveled = -BLOCK_GAP;
+    sim::distanceSensor(BLOCK_SENSOR_PORT).reading = BLOCK_FAR;
+    pros::Task feeder([] {
+        while (feeding) {
+            traveled += sim::motor(INDEXER_PORT).velocity / 60 * M_PI * ROLLER_DIAMETER * 0.001;
+            const double along = std::fmod(traveled, BLOCK_LENGTH + BLOCK_GAP);
+            const bool block = traveled >= 0 && traveled < BLOCKS * (BLOCK_LENGTH + BLOCK_GAP) && along < BLOCK_LENGTH;
+            sim::distanceSensor(BLOCK_SENSOR_PORT).reading = block ? BLOCK_NEAR : BLOCK_FAR;
+            pros::delay(1);
+        }
+    });
+
+    resetBlockCount();
+    const std::uint32_t start = pros::millis();
+    outtakeLong(127);
+    const bool scored = waitUntilScored(BLOCKS, 2000);
+    std::printf("[%6u ms] waitUntilScored(%d) %s, %d of %d blocks counted\n", pros::millis() - start, BLOCKS,
+                scored ? "returned" : "timed out", getBlocksScored(), BLOCKS);
+    intakeStop();
+    feeding = false;
+}
+
+/**
+ * @brief Routines the runner can drive while autonomous() in src/main.cpp is commented out
+ *
+ * The first ones are the drive of the routine of the same name in src/autons.cpp, which is
+ * commented out too, with its intake calls moved to the current intake API. The robot is put
+ * where the routine's setPose says it starts, so the ground truth pose is in the routine's frame.
+ * The intake ones inject what the physics doesn't model, jams and blocks, and print what the
+ * intake tasks did about it
+ */
+struct Routine {
+        const char* name;
+        sim::Pose start; // inches, and radians clockwise from +y
+        void (*run)();
+};
+
+const Routine ROUTINES[] = {
+    {"right4Block",
+     {0, 0, M_PI_2},
+     [] {
+         chassis.setPose(0, 0, 90);
+         chassis.moveToPoint(35.3, 0, 1000);
+         pros::delay(50);
+         setLittleWill(true);
+         chassis.turnToHeading(176, 750, {.maxSpeed = 90});
+         chassis.moveToPoint(36.3, -34, 1000, {.maxSpeed = 70});
+         intakeStore(127);
+         pros::delay(975);
+         chassis.moveToPoint(37.8, 22, 1000, {.forwards = false, .maxSpeed = 65}, false);
+         outtakeLong(127);
+         pros::delay(1200);
+         chassis.moveToPoint(37.5, -7, 1000);
+         pros::delay(400);
+         intakeStop();
+         setLittleWill(false);
+         setWing(true);
+         chassis.moveToPoint(48.3, 0, 1000, {.forwards = false});
+         chassis.turnToHeading(182, 1000);
+         chassis.moveToPoint(50, 28.5, 1000, {.forwards = false, .maxSpeed = 60}, false);
+         setWing(false);
+     }},
+    {"right7Block",
+     {0, 0, 0},
+     [] {
+         chassis.setPose(0, 0, 0);
+         chassis.moveToPose(12.9, 26.75, 57, 1200, {.lead = 0.5});
+         intakeStore(127);
+         pros::delay(900);
+         setLittleWill(true);
+         pros::delay(100);
+         chassis.moveToPose(34, -24, 180, 1900, {.lead = 0.5});
+         chassis.moveToPoint(34.286, 22, 1000, {.forwards = false, .maxSpeed = 70}, false);
+         outtakeLong(127);
+         pros::delay(1700);
+         chassis.moveToPoint(24.15, 0, 1000);
+         pros::delay(300);
+         intakeStop();
+         setLittleWill(false);
+         setWing(true);
+         chassis.turnToHeading(180, 1000);
+         pros::delay(200);
+         setWing(false);
+         chassis.moveToPoint(24, 32, 1000, {.forwards = false, .maxSpeed = 80}, false);
+     }},
+    {"intakeJam", {0, 0, 0}, intakeJam},
+    {"intakeFullHopper", {0, 0, 0}, intakeFullHopper},
+    {"backToBackBlocks", {0, 0, 0}, backToBackBlocks},
+};
+
+void usage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s [--auton N | --routine NAME] [--time-limit MS] [--trace MS]\n"
+                 "  --auton N        value of autonSelection when autonomous() starts. autonomous()\n"
+                 "                   in src/main.cpp is commented out for now, so this drives nothing\n"
+                 "  --routine NAME   run one of the runner's own routines after initialize() instead\n"
+                 "                   of autonomous(), one of:",
+                 program);
+    for (const Routine& routine : ROUTINES) std::fprintf(stderr, " %s", routine.name);
+    std::fprintf(stderr,
+                 "\n"
+                 "  --time-limit MS  stop the simulation after MS virtual milliseconds\n"
+                 "  --trace MS       print the ground truth pose every MS virtual milliseconds\n");
+}
+} // namespace
+
+/**
+ * @brief Run initialize() followed by autonomous() or a routine against the simulated robot
+ *
+ * The drivetrain below mirrors the motor groups and drivetrain settings in src/main.cpp
+ */
+int main(int argc, char** argv) {
+    int auton = 0;
+    std::uint32_t timeLimit = DEFAULT_TIME_LIMIT;
+    std::uint32_t trace = 0;
+    const Routine* routine = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 < argc && std::strcmp(argv[i], "--auton") == 0) auton = std::atoi(argv[++i]);
+        else if (i + 1 < argc && std::strcmp(argv[i], "--routine") == 0) {
+            const char* name = argv[++i];
+            for (const Routine& candidate : ROUTINES)
+                if (std::strcmp(candidate.name, name) == 0) routine = &candidate;
+            if (routine == nullptr) {
+                usage(argv[0]);
+                return 1;
+            }
+        }
+        else if (i + 1 < argc && std::strcmp(argv[i], "--time-limit") == 0) timeLimit = std::atoi(argv[++i]);
+        else if (i + 1 < argc && std::strcmp(argv[i], "--trace") == 0) trace = std::atoi(argv[++i]);
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    sim::configureDrivetrain({.leftPorts = {-1, -12, -11},
+                              .rightPorts = {13, 15, 14},
+                              .trackWidth = 12,
+                              .wheelDiameter = 3.25,
+                              .rpm = 450});
+    sim::onTick([trace](std::uint32_t time) {
+        sim::step(0.001);
+        if (trace != 0 && time % trace == 0) {
+            const sim::Pose pose = sim::robotPose();
+            std::printf("[%6u ms] pose x: %7.2f y: %7.2f theta: %7.2f\n", time, pose.x, pose.y,
+                        pose.theta * 180 / M_PI);
+        }
+    });
+
+    const std::uint32_t stoppedAt = sim::run(
+        [auton, routine] {
+            initialize();
+            if (routine == nullptr) {
+                autonSelection = auton;
+                autonomous();
+                return;
+            }
+            // odometry sees the teleport as a jump in the IMU heading, the routine's setPose resets it
+            sim::setRobotPose(routine->start);
+            pros::delay(50);
+            routine->run();
+        },
+        SETTLE_TIME, timeLimit);
+
+    const sim::Pose pose = sim::robotPose();
+    std::printf("finished at %u ms, pose x: %.2f y: %.2f theta: %.2f\n", stoppedAt, pose.x, pose.y,
+                pose.theta * 180 / M_PI);
+    // tasks that never return are still parked on their threads, so skip static destructors
+    std::fflush(stdout);
+    std::_Exit(0);
+}
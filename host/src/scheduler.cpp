@@ -0,0 +1,354 @@
+#include <algorithm>
+#include <climits>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "pros/rtos.h"
+#include "sim/scheduler.hpp"
+
+namespace sim {
+namespace {
+struct Task {
+        std::string name;
+        std::uint32_t priority;
+        std::uint64_t wakeTime = 0;
+        std::uint64_t lastRun = 0;
+        bool suspended = false;
+        bool finished = false;
+        std::uint32_t notifyValue = 0;
+        pros::task_fn_t function = nullptr;
+        void* parameters = nullptr;
+        std::condition_variable resume;
+};
+
+struct Mutex {
+        Task* owner = nullptr;
+        std::uint32_t depth = 0;
+        bool recursive = false;
+};
+
+// every field below is guarded by lock. The running task only holds it while it is
+// inside the scheduler, every other task is parked on its condition variable
+std::mutex lock;
+std::vector<std::unique_ptr<Task>> tasks;
+std::vector<std::function<void(std::uint32_t)>> tickCallbacks;
+Task* current = nullptr;
+std::uint64_t clock = 0;
+std::uint64_t switches = 0;
+std::uint64_t stopTime = UINT64_MAX;
+bool stopped = false;
+std::condition_variable stoppedChanged;
+
+thread_local Task* self = nullptr;
+
+/**
+ * @brief Move the virtual clock forward, stepping tick callbacks on every millisecond boundary
+ *
+ * @return false if the clock hit the stop time first
+ */
+bool advanceTo(std::uint64_t time) {
+    while (clock < time) {
+        const std::uint64_t nextTick = (clock / 1000 + 1) * 1000;
+        if (nextTick > time) {
+            clock = time;
+            break;
+        }
+        clock = nextTick;
+        for (auto& callback : tickCallbacks) callback(clock / 1000);
+        if (clock >= stopTime) return false;
+    }
+    return clock < stopTime;
+}
+
+/**
+ * @brief Hand control to the next ready task
+ *
+ * Picks the task with the earliest wake time, breaking ties by priority and then by
+ * whichever ran least recently. If the clock reaches the stop time instead, every task
+ * stays parked and run() is woken up.
+ */
+void dispatch() {
+    Task* next = nullptr;
+    for (auto& task : tasks) {
+        if (task->finished || task->suspended) continue;
+        if (next == nullptr || task->wakeTime < next->wakeTime ||
+            (task->wakeTime == next->wakeTime &&
+             (task->priority > next->priority ||
+              (task->priority == next->priority && task->lastRun < next->lastRun))))
+            next = task.get();
+    }
+    if (next == nullptr) {
+        std::fprintf(stderr, "sim: every task is blocked or finished at %llu ms\n",
+                     static_cast<unsigned long long>(clock / 1000));
+        stopped = true;
+        current = nullptr;
+        stoppedChanged.notify_all();
+        return;
+    }
+    if (!advanceTo(next->wakeTime)) {
+        stopped = true;
+        current = nullptr;
+        stoppedChanged.notify_all();
+        return;
+    }
+    next->lastRun = ++switches;
+    current = next;
+    next->resume.notify_one();
+}
+
+/**
+ * @brief Park the calling task until the scheduler picks it again
+ */
+void park(std::unique_lock<std::mutex>& guard, Task* task) {
+    task->resume.wait(guard, [task] { return current == task; });
+}
+
+void entry(Task* task) {
+    self = task;
+    {
+        std::unique_lock guard(lock);
+        park(guard, task);
+    }
+    task->function(task->parameters);
+    std::unique_lock guard(lock);
+    task->finished = true;
+    dispatch();
+}
+
+Task* find(pros::task_t handle) { return handle == nullptr ? self : static_cast<Task*>(handle); }
+
+/**
+ * @brief Poll a condition once per simulated millisecond until it holds or the timeout expires
+ */
+template <typename F> bool waitFor(std::uint32_t timeout, F&& condition) {
+    const std::uint64_t deadline = timeout == TIMEOUT_MAX ? UINT64_MAX : now() + timeout * 1000ull;
+    while (true) {
+        if (condition()) return true;
+        if (now() >= deadline) return false;
+        sleepUntil(now() + 1000);
+    }
+}
+} // namespace
+
+std::uint64_t now() {
+    std::lock_guard guard(lock);
+    return clock;
+}
+
+void sleepUntil(std::uint64_t wakeTime) {
+    // code that runs before the scheduler starts, like static constructors, can't sleep
+    if (self == nullptr) return;
+    std::unique_lock guard(lock);
+    self->wakeTime = std::max(wakeTime, clock);
+    dispatch();
+    park(guard, self);
+}
+
+void yield() { sleepUntil(now()); }
+
+void onTick(std::function<void(std::uint32_t)> step) {
+    std::lock_guard guard(lock);
+    tickCallbacks.push_back(std::move(step));
+}
+
+std::uint32_t run(std::function<void()> entry, std::uint32_t settleTime, std::uint32_t timeLimit) {
+    static std::function<void()> routine;
+    routine = [entry = std::move(entry), settleTime] {
+        entry();
+        std::lock_guard guard(lock);
+        stopTime = std::min<std::uint64_t>(stopTime, clock + settleTime * 1000ull);
+    };
+    pros::c::task_create([](void*) { routine(); }, nullptr, TASK_PRIORITY_DEFAULT, TASK_STACK_DEPTH_DEFAULT, "main");
+    std::unique_lock guard(lock);
+    stopTime = timeLimit * 1000ull;
+    dispatch();
+    stoppedChanged.wait(guard, [] { return stopped; });
+    return clock / 1000;
+}
+} // namespace sim
+
+using sim::Task;
+using sim::lock;
+
+extern "C" {
+namespace pros::c {
+uint32_t millis(void) { return sim::now() / 1000; }
+
+uint64_t micros(void) { return sim::now(); }
+
+task_t task_create(task_fn_t function, void* const parameters, uint32_t prio, const uint16_t, const char* const name) {
+    std::lock_guard guard(lock);
+    auto task = std::make_unique<Task>();
+    task->name = name == nullptr ? "" : name;
+    task->priority = prio;
+    task->wakeTime = sim::clock;
+    task->function = function;
+    task->parameters = parameters;
+    Task* handle = task.get();
+    sim::tasks.push_back(std::move(task));
+    std::thread(sim::entry, handle).detach();
+    return handle;
+}
+
+void task_delete(task_t task) {
+    Task* target = sim::find(task);
+    std::unique_lock guard(lock);
+    target->finished = true;
+    if (target != sim::self) return;
+    sim::dispatch();
+    // a task that deletes itself never runs again
+    target->resume.wait(guard, [] { return false; });
+}
+
+void task_delay(const uint32_t milliseconds) { sim::sleepUntil(sim::now() + milliseconds * 1000ull); }
+
+void delay(const uint32_t milliseconds) { task_delay(milliseconds); }
+
+void task_delay_until(uint32_t* const prev_time, const uint32_t delta) {
+    *prev_time += delta;
+    sim::sleepUntil(*prev_time * 1000ull);
+}
+
+uint32_t task_get_priority(task_t task) {
+    std::lock_guard guard(lock);
+    return sim::find(task)->priority;
+}
+
+void task_set_priority(task_t task, uint32_t prio) {
+    std::lock_guard guard(lock);
+    sim::find(task)->priority = prio;
+}
+
+task_state_e_t task_get_state(task_t task) {
+    std::lock_guard guard(lock);
+    Task* target = sim::find(task);
+    if (target->finished) return E_TASK_STATE_DELETED;
+    if (target->suspended) return E_TASK_STATE_SUSPENDED;
+    if (target == sim::current) return E_TASK_STATE_RUNNING;
+    return target->wakeTime > sim::clock ? E_TASK_STATE_BLOCKED : E_TASK_STATE_READY;
+}
+
+void task_suspend(task_t task) {
+    Task* target = sim::find(task);
+    std::unique_lock guard(lock);
+    target->suspended = true;
+    if (target != sim::self) return;
+    sim::dispatch();
+    sim::park(guard, target);
+}
+
+void task_resume(task_t task) {
+    std::lock_guard guard(lock);
+    Task* target = sim::find(task);
+    target->suspended = false;
+    target->wakeTime = std::max(target->wakeTime, sim::clock);
+}
+
+uint32_t task_get_count(void) {
+    std::lock_guard guard(lock);
+    return std::count_if(sim::tasks.begin(), sim::tasks.end(), [](auto& task) { return !task->finished; });
+}
+
+char* task_get_name(task_t task) {
+    std::lock_guard guard(lock);
+    return sim::find(task)->name.data();
+}
+
+task_t task_get_by_name(const char* name) {
+    std::lock_guard guard(lock);
+    for (auto& task : sim::tasks)
+        if (!task->finished && task->name == name) return task.get();
+    return nullptr;
+}
+
+task_t task_get_current() { return sim::self; }
+
+uint32_t task_notify(task_t task) { return task_notify_ext(task, 0, E_NOTIFY_ACTION_INCR, nullptr); }
+
+void task_join(task_t task) {
+    Task* target = sim::find(task);
+    sim::waitFor(TIMEOUT_MAX, [target] {
+        std::lock_guard guard(lock);
+        return target->finished;
+    });
+}
+
+uint32_t task_notify_ext(task_t task, uint32_t value, notify_action_e_t action, uint32_t* prev_value) {
+    std::lock_guard guard(lock);
+    Task* target = sim::find(task);
+    if (prev_value != nullptr) *prev_value = target->notifyValue;
+    switch (action) {
+        case E_NOTIFY_ACTION_NONE: break;
+        case E_NOTIFY_ACTION_BITS: target->notifyValue |= value; break;
+        case E_NOTIFY_ACTION_INCR: target->notifyValue++; break;
+        case E_NOTIFY_ACTION_OWRITE: target->notifyValue = value; break;
+        case E_NOTIFY_ACTION_NO_OWRITE:
+            if (target->notifyValue != 0) return 0;
+            target->notifyValue = value;
+            break;
+    }
+    return 1;
+}
+
+uint32_t task_notify_take(bool clear_on_exit, uint32_t timeout) {
+    Task* target = sim::self;
+    uint32_t value = 0;
+    sim::waitFor(timeout, [&] {
+        std::lock_guard guard(lock);
+        value = target->notifyValue;
+        if (value == 0) return false;
+        target->notifyValue = clear_on_exit ? 0 : value - 1;
+        return true;
+    });
+    return value;
+}
+
+bool task_notify_clear(task_t task) {
+    std::lock_guard guard(lock);
+    Task* target = sim::find(task);
+    const bool pending = target->notifyValue != 0;
+    target->notifyValue = 0;
+    return pending;
+}
+
+mutex_t mutex_create(void) { return new sim::Mutex(); }
+
+mutex_t mutex_recursive_create(void) {
+    auto mutex = new sim::Mutex();
+    mutex->recursive = true;
+    return mutex;
+}
+
+bool mutex_take(mutex_t mutex, uint32_t timeout) {
+    auto target = static_cast<sim::Mutex*>(mutex);
+    Task* owner = sim::self;
+    return sim::waitFor(timeout, [&] {
+        std::lock_guard guard(lock);
+        if (target->owner != nullptr && !(target->recursive && target->owner == owner)) return false;
+        target->owner = owner;
+        target->depth++;
+        return true;
+    });
+}
+
+bool mutex_give(mutex_t mutex) {
+    std::lock_guard guard(lock);
+    auto target = static_cast<sim::Mutex*>(mutex);
+    if (target->depth == 0) return false;
+    if (--target->depth == 0) target->owner = nullptr;
+    return true;
+}
+
+bool mutex_recursive_take(mutex_t mutex, uint32_t timeout) { return mutex_take(mutex, timeout); }
+
+bool mutex_recursive_give(mutex_t mutex) { return mutex_give(mutex); }
+
+void mutex_delete(mutex_t mutex) { delete static_cast<sim::Mutex*>(mutex); }
+} // namespace pros::c
+}
@@ -0,0 +1,167 @@
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include "lemlib/field.hpp"
+#include "sim/world.hpp"
+
+namespace sim {
+namespace {
+// time constant of an unloaded motor spinning up, in seconds
+constexpr double MOTOR_TIME_CONSTANT = 0.05;
+// how much faster an unloaded motor stops when braking instead of coasting
+constexpr double BRAKE_FACTOR = 4;
+// battery voltage the motor model is characterized at, in mV. Commands are a fraction of the
+// battery voltage, so motors are weaker below it and stronger above it
+constexpr double CHARACTERIZED_BATTERY = 12800;
+// output torque of a stalled 11W motor with the red cartridge at full voltage, in Nm
+constexpr double STALL_TORQUE = 2.1;
+
+std::array<MotorState, 22> motors;
+std::map<std::uint8_t, ImuState> imus;
+std::map<std::uint8_t, std::int32_t> rotationSensors;
+std::map<std::uint8_t, DistanceMount> distanceSensors;
+std::map<std::uint8_t, OpticalState> opticalSensors;
+std::map<std::pair<std::uint8_t, std::uint8_t>, std::int32_t> adiValues;
+std::array<ControllerState, 2> controllers;
+std::int32_t battery = 12800;
+
+DrivetrainConfig drivetrain;
+DiffDrive drive;
+
+double sign(std::int8_t port) { return port < 0 ? -1 : 1; }
+
+/**
+ * @brief Get the average voltage applied to one side of the drivetrain, and whether it is braking
+ */
+std::pair<double, bool> sideInput(const std::vector<std::int8_t>& ports) {
+    if (ports.empty()) return {0, false};
+    double voltage = 0;
+    bool braking = true;
+    for (std::int8_t port : ports) {
+        const MotorState& state = motor(port);
+        voltage += sign(port) * state.voltage * battery / CHARACTERIZED_BATTERY;
+        braking = braking && state.braking && state.brakeMode != pros::E_MOTOR_BRAKE_COAST;
+    }
+    return {voltage / ports.size(), braking};
+}
+
+/**
+ * @brief Write the speed of one side of the drivetrain back to its motors
+ */
+void writeSide(const std::vector<std::int8_t>& ports, double speed, double current, double torque) {
+    for (std::int8_t port : ports) {
+        MotorState& state = motor(port);
+        const double rpm = speed / (M_PI * drivetrain.wheelDiameter) * 60 * cartridgeRpm(state.gearset) /
+                           drivetrain.rpm;
+        state.velocity = sign(port) * rpm;
+        state.current = std::abs(current);
+        state.torque = sign(port) * torque;
+    }
+}
+
+bool isDriveMotor(std::uint8_t port) {
+    for (std::int8_t p : drivetrain.leftPorts)
+        if (std::abs(p) == port) return true;
+    for (std::int8_t p : drivetrain.rightPorts)
+        if (std::abs(p) == port) return true;
+    return false;
+}
+} // namespace
+
+void configureDrivetrain(const DrivetrainConfig& config) {
+    drivetrain = config;
+    DiffDriveParams params;
+    params.trackWidth = config.trackWidth;
+    params.wheelDiameter = config.wheelDiameter;
+    params.rpm = config.rpm;
+    params.motorsPerSide = std::max<int>(config.leftPorts.size(), 1);
+    if (!config.leftPorts.empty()) params.cartridgeRpm = cartridgeRpm(motor(config.leftPorts.front()).gearset);
+    const Pose pose = drive.getPose();
+    drive = DiffDrive(params);
+    drive.setPose(pose);
+}
+
+Pose robotPose() { return drive.getPose(); }
+
+void setRobotPose(Pose newPose) {
+    drive = DiffDrive(drive.getParams());
+    drive.setPose(newPose);
+    for (const std::vector<std::int8_t>* ports : {&drivetrain.leftPorts, &drivetrain.rightPorts}) {
+        for (std::int8_t port : *ports) {
+            MotorState& state = motor(port);
+            state.voltage = 0;
+            state.velocity = 0;
+            state.position = 0;
+            state.zero = 0;
+            state.current = 0;
+            state.torque = 0;
+            state.braking = false;
+            state.positionMode = false;
+        }
+    }
+}
+
+void step(double dt) {
+    // move_absolute and move_relative run a simple position loop on the motor
+    for (MotorState& state : motors) {
+        if (!state.positionMode) continue;
+        const double limit = std::abs(state.targetVelocity) / cartridgeRpm(state.gearset) * 12000;
+        state.voltage = std::clamp((state.targetPosition - state.position) * 40, -limit, limit);
+    }
+    const auto [leftVoltage, leftBraking] = sideInput(drivetrain.leftPorts);
+    const auto [rightVoltage, rightBraking] = sideInput(drivetrain.rightPorts);
+    drive.step(leftVoltage, rightVoltage, dt, leftBraking, rightBraking);
+    writeSide(drivetrain.leftPorts, drive.getLeftSpeed(), drive.getLeftCurrent(), drive.getLeftTorque());
+    writeSide(drivetrain.rightPorts, drive.getRightSpeed(), drive.getRightCurrent(), drive.getRightTorque());
+    // every motor that isn't part of the drivetrain spins freely
+    for (std::uint8_t port = 1; port <= 21; port++) {
+        if (isDriveMotor(port)) continue;
+        MotorState& state = motors[port];
+        if (state.jammed && state.voltage < 0) state.jammed = false;
+        if (state.jammed && state.voltage > 0) {
+            // stalled against the jam, drawing all the current it's allowed
+            state.velocity = 0;
+            state.current = std::min(state.currentLimit, 2500);
+            state.torque = STALL_TORQUE * 100 / cartridgeRpm(state.gearset) * state.voltage / 12000;
+            continue;
+        }
+        state.torque = 0;
+        const double target = state.voltage * battery / CHARACTERIZED_BATTERY / 12000 * cartridgeRpm(state.gearset);
+        const bool braking = state.braking && state.brakeMode != pros::E_MOTOR_BRAKE_COAST;
+        const double timeConstant = braking ? MOTOR_TIME_CONSTANT / BRAKE_FACTOR : MOTOR_TIME_CONSTANT;
+        state.velocity += (target - state.velocity) * std::min(dt / timeConstant, 1.0);
+        state.current = std::min(std::abs(target - state.velocity) / cartridgeRpm(state.gearset) * 2500, 2500.0);
+    }
+    for (MotorState& state : motors) state.position += state.velocity / 60 * 360 * dt;
+}
+
+MotorState& motor(std::int8_t port) { return motors[std::abs(port)]; }
+
+ImuState& imu(std::uint8_t port) { return imus[port]; }
+
+std::int32_t& rotationSensor(std::uint8_t port) { return rotationSensors[port]; }
+
+DistanceMount& distanceSensor(std::uint8_t port) { return distanceSensors[port]; }
+
+OpticalState& opticalSensor(std::uint8_t port) { return opticalSensors[port]; }
+
+double castRay(double x, double y, double theta) {
+    return lemlib::rayCast(x, y, theta, lemlib::FIELD_WALLS, INFINITY);
+}
+
+double trueRotation() { return drive.getPose().theta * 180 / M_PI; }
+
+std::int32_t& adi(std::uint8_t smartPort, std::uint8_t adiPort) { return adiValues[{smartPort, adiPort}]; }
+
+ControllerState& controller(pros::controller_id_e_t id) { return controllers[id]; }
+
+std::int32_t& batteryVoltage() { return battery; }
+
+double cartridgeRpm(pros::motor_gearset_e_t gearset) {
+    switch (gearset) {
+        case pros::E_MOTOR_GEARSET_36: return 100;
+        case pros::E_MOTOR_GEARSET_06: return 600;
+        default: return 200;
+    }
+}
+} // namespace sim
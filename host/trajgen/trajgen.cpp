@@ -0,0 +1,227 @@
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "lemlib/trajectory.hpp"
+
+/**
+ * Turns a list of waypoints into a time optimal trajectory asset for Chassis::followTrajectory.
+ *
+ * The waypoints are joined with a centripetal Catmull-Rom spline, which passes through every
+ * waypoint and doesn't loop or cusp between close ones, then resampled at even spacing. The
+ * velocity of each sample is planned by lemlib::timeParameterize: the fastest the path can be
+ * driven within the velocity and acceleration limits, starting and ending at rest.
+ *
+ * All of this is too slow and too allocation heavy to do on the brain at the start of a motion,
+ * so it runs here and the brain reads the result in place.
+ */
+
+namespace {
+struct Point {
+        double x;
+        double y;
+};
+
+struct Constraints {
+        double maxVelocity = 60; // in/s
+        double maxAcceleration = 80; // in/s^2
+        double maxCurvature = 0; // 1/in, 0 for no limit
+        double trackWidth = 12; // in, the robot in src/main.cpp
+        double spacing = 0.5; // in
+};
+
+/**
+ * @brief Read the waypoints of a path file
+ *
+ * Takes LemLib path files as they are, one "x, y, velocity" line per point up to "endData". The
+ * path ends at the first point with no velocity, and the points after it only extend the path for
+ * follow()'s lookahead, so they are left out. Other than that the velocity column is ignored, and a
+ * plain list of "x, y" lines works too
+ */
+std::vector<Point> readWaypoints(const char* path) {
+    std::vector<Point> waypoints;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.rfind("endData", 0) == 0) break;
+        Point point;
+        double velocity;
+        const int read = std::sscanf(line.c_str(), "%lf , %lf , %lf", &point.x, &point.y, &velocity);
+        if (read < 2) continue;
+        // repeated points would give the spline a zero length segment
+        if (waypoints.empty() || std::hypot(point.x - waypoints.back().x, point.y - waypoints.back().y) > 1e-6)
+            waypoints.push_back(point);
+        if (read == 3 && velocity == 0 && waypoints.size() > 1) break;
+    }
+    return waypoints;
+}
+
+/**
+ * @brief Point on the centripetal Catmull-Rom segment between p1 and p2
+ *
+ * Barry and Goldman's pyramidal form, with knots spaced by the square root of the chord lengths
+ *
+ * @param t 0 at p1, 1 at p2
+ */
+Point catmullRom(const Point& p0, const Point& p1, const Point& p2, const Point& p3, double t) {
+    const auto knot = [](const Point& a, const Point& b) { return std::sqrt(std::hypot(b.x - a.x, b.y - a.y)); };
+    const double t0 = 0;
+    const double t1 = t0 + knot(p0, p1);
+    const double t2 = t1 + knot(p1, p2);
+    const double t3 = t2 + knot(p2, p3);
+    const double u = t1 + t * (t2 - t1);
+    const auto mix = [](const Point& a, const Point& b, double ta, double tb, double u) {
+        const double w = (u - ta) / (tb - ta);
+        return Point {a.x + w * (b.x - a.x), a.y + w * (b.y - a.y)};
+    };
+    const Point a1 = mix(p0, p1, t0, t1, u);
+    const Point a2 = mix(p1, p2, t1, t2, u);
+    const Point a3 = mix(p2, p3, t2, t3, u);
+    const Point b1 = mix(a1, a2, t0, t2, u);
+    const Point b2 = mix(a2, a3, t1, t3, u);
+    return mix(b1, b2, t1, t2, u);
+}
+
+/**
+ * @brief Sample the spline through the waypoints at even spacing along it
+ */
+std::vector<Point> resample(const std::vector<Point>& waypoints, double spacing) {
+    // densely sample the spline first, then walk the dense polyline at the spacing
+    constexpr int STEPS = 32;
+    std::vector<Point> dense {waypoints.front()};
+    for (std::size_t i = 0; i + 1 < waypoints.size(); i++) {
+        const Point& p1 = waypoints[i];
+        const Point& p2 = waypoints[i + 1];
+        // mirror the end points so the spline starts and ends pointing along the first and last segments
+        const Point p0 = i > 0 ? waypoints[i - 1] : Point {2 * p1.x - p2.x, 2 * p1.y - p2.y};
+        const Point p3 = i + 2 < waypoints.size() ? waypoints[i + 2] : Point {2 * p2.x - p1.x, 2 * p2.y - p1.y};
+        for (int step = 1; step <= STEPS; step++) dense.push_back(catmullRom(p0, p1, p2, p3, double(step) / STEPS));
+    }
+
+    std::vector<Point> points {dense.front()};
+    double carried = 0; // distance along the dense polyline since the last sample
+    for (std::size_t i = 0; i + 1 < dense.size(); i++) {
+        const double length = std::hypot(dense[i + 1].x - dense[i].x, dense[i + 1].y - dense[i].y);
+        double along = spacing - carried;
+        while (along <= length) {
+            const double w = along / length;
+            points.push_back({dense[i].x + w * (dense[i + 1].x - dense[i].x),
+                              dense[i].y + w * (dense[i + 1].y - dense[i].y)});
+            along += spacing;
+        }
+        carried = length - (along - spacing);
+    }
+    // always end on the last waypoint, dropping a sample that would be too close to it
+    if (std::hypot(points.back().x - dense.back().x, points.back().y - dense.back().y) < spacing / 2 &&
+        points.size() > 1)
+        points.pop_back();
+    points.push_back(dense.back());
+    return points;
+}
+
+/**
+ * @brief Build the trajectory, or an empty one if the path breaks a constraint
+ */
+std::vector<lemlib::TrajectorySample> generate(const std::vector<Point>& points, const Constraints& constraints) {
+    const std::size_t n = points.size();
+    std::vector<lemlib::TrajectorySample> samples(n);
+    std::vector<double> distance(n, 0);
+    for (std::size_t i = 1; i < n; i++)
+        distance[i] = distance[i - 1] + std::hypot(points[i].x - points[i - 1].x, points[i].y - points[i - 1].y);
+
+    // heading from the neighbouring samples, clockwise from the y axis
+    std::vector<double> heading(n);
+    for (std::size_t i = 0; i < n; i++) {
+        const Point& before = points[i > 0 ? i - 1 : 0];
+        const Point& after = points[i + 1 < n ? i + 1 : n - 1];
+        heading[i] = std::atan2(after.x - before.x, after.y - before.y);
+    }
+    // curvature is how fast the heading turns along the path
+    std::vector<double> curvature(n, 0);
+    for (std::size_t i = 1; i + 1 < n; i++) {
+        const double turn = std::remainder(heading[i + 1] - heading[i - 1], 2 * M_PI);
+        curvature[i] = turn / (distance[i + 1] - distance[i - 1]);
+    }
+
+    for (std::size_t i = 0; i < n; i++) {
+        const double k = std::fabs(curvature[i]);
+        if (constraints.maxCurvature > 0 && k > constraints.maxCurvature) {
+            std::fprintf(stderr, "path turns with a radius of %.2f in at (%.2f, %.2f), tighter than the limit of %.2f\n",
+                         1 / k, points[i].x, points[i].y, 1 / constraints.maxCurvature);
+            return {};
+        }
+        samples[i] = {.x = float(points[i].x),
+                      .y = float(points[i].y),
+                      .heading = float(heading[i]),
+                      .curvature = float(curvature[i]),
+                      .distance = float(distance[i])};
+    }
+    // the same velocity passes the brain uses for moveToPose trajectories
+    lemlib::timeParameterize(samples, {.maxVelocity = float(constraints.maxVelocity),
+                                       .maxAcceleration = float(constraints.maxAcceleration),
+                                       .trackWidth = float(constraints.trackWidth)});
+    return samples;
+}
+
+bool write(const char* path, const std::vector<lemlib::TrajectorySample>& samples) {
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) return false;
+    const lemlib::TrajectoryHeader header {.magic = lemlib::TRAJECTORY_MAGIC,
+                                           .version = lemlib::TRAJECTORY_VERSION,
+                                           .sampleSize = sizeof(lemlib::TrajectorySample),
+                                           .count = std::uint32_t(samples.size())};
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    ok = ok && std::fwrite(samples.data(), sizeof(lemlib::TrajectorySample), samples.size(), file) == samples.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+void usage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s WAYPOINTS -o OUTPUT [--max-vel IN/S] [--max-accel IN/S^2] [--max-curvature 1/IN]\n"
+                 "          [--track-width IN] [--spacing IN]\n"
+                 "  WAYPOINTS is a LemLib path file or a list of \"x, y\" lines. OUTPUT goes in static/\n"
+                 "  to be loaded with ASSET(), e.g. static/skills.traj is ASSET(skills_traj)\n",
+                 program);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    Constraints constraints;
+    const char* input = nullptr;
+    const char* output = nullptr;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        if (hasValue && std::strcmp(argv[i], "-o") == 0) output = argv[++i];
+        else if (hasValue && std::strcmp(argv[i], "--max-vel") == 0) constraints.maxVelocity = std::atof(argv[++i]);
+        else if (hasValue && std::strcmp(argv[i], "--max-accel") == 0)
+            constraints.maxAcceleration = std::atof(argv[++i]);
+        else if (hasValue && std::strcmp(argv[i], "--max-curvature") == 0)
+            constraints.maxCurvature = std::atof(argv[++i]);
+        else if (hasValue && std::strcmp(argv[i], "--track-width") == 0) constraints.trackWidth = std::atof(argv[++i]);
+        else if (hasValue && std::strcmp(argv[i], "--spacing") == 0) constraints.spacing = std::atof(argv[++i]);
+        else if (argv[i][0] != '-' && input == nullptr) input = argv[i];
+        else return usage(argv[0]), 1;
+    }
+    if (input == nullptr || output == nullptr || constraints.maxVelocity <= 0 || constraints.maxAcceleration <= 0 ||
+        constraints.spacing <= 0)
+        return usage(argv[0]), 1;
+
+    const std::vector<Point> waypoints = readWaypoints(input);
+    if (waypoints.size() < 2) {
+        std::fprintf(stderr, "%s needs at least two distinct waypoints\n", input);
+        return 1;
+    }
+    const std::vector<lemlib::TrajectorySample> samples = generate(resample(waypoints, constraints.spacing), constraints);
+    if (samples.empty()) return 1;
+    if (!write(output, samples)) {
+        std::fprintf(stderr, "could not write %s\n", output);
+        return 1;
+    }
+    std::printf("%s: %zu samples, %.1f in, %.2f s\n", output, samples.size(), samples.back().distance,
+                samples.back().time);
+    return 0;
+}
@@ -0,0 +1,402 @@
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/util.hpp"
+#include "sim/scheduler.hpp"
+#include "sim/world.hpp"
+
+/**
+ * Sweeps kP, kD and slew for the lateral or angular controller, scoring every combination by
+ * driving lemlib::Chassis::moveToPoint or turnToHeading in the host simulation. The chassis is set
+ * up like src/main.cpp, with the sensor scheduler and battery compensation, so the sweep runs the
+ * same motions, profiles, feedforward and MPC as the robot does.
+ *
+ * The simulation can only run once per process, so the sweep runs in worker processes, each with
+ * its own simulation. Workers take the next gain set from a counter in memory shared with the
+ * parent, so one that draws slow gains doesn't hold up the rest, and write the results next to it.
+ * The robot is brought to rest before every run, so a gain set scores the same whichever worker
+ * runs it and whatever ran before.
+ */
+
+namespace {
+// keep simulating after the motion exits so overshoot while the brakes stop the robot is counted
+constexpr int STOP_TIME = 500;
+// let odometry settle after teleporting the robot back to the start, like host/bench/ramsete.cpp
+constexpr int RESET_TIME = 50;
+// motions start on the same phase of the odometry and sensor tasks' 10 ms period, in ms
+constexpr std::uint32_t PERIOD = 10;
+
+// the drivetrain and controllers of src/main.cpp
+pros::MotorGroup leftMotors({-1, -12, -11}, pros::MotorGears::blue);
+pros::MotorGroup rightMotors({13, 15, 14}, pros::MotorGears::blue);
+pros::Imu imu(16);
+lemlib::TrackingWheel leftWheel(&leftMotors, lemlib::Omniwheel::NEW_325, -6, 450);
+lemlib::TrackingWheel rightWheel(&rightMotors, lemlib::Omniwheel::NEW_325, 6, 450);
+const lemlib::Drivetrain DRIVETRAIN(&leftMotors, &rightMotors, 12, lemlib::Omniwheel::NEW_325, 450, 8);
+const lemlib::OdomSensors SENSORS(&leftWheel, &rightWheel, nullptr, nullptr, &imu);
+const lemlib::ControllerSettings LATERAL(5.8, 0, 13, 3, 1, 100, 3, 500, 20, 3);
+const lemlib::ControllerSettings ANGULAR(2.0, 0, 13.6, 3, 1, 100, 3, 500, 0, 15);
+lemlib::SensorScheduler sensorScheduler;
+
+enum class Motion { LATERAL, ANGULAR };
+
+struct Range {
+        float min;
+        float max;
+        float step;
+};
+
+struct Gains {
+        float kP;
+        float kD;
+        float slew;
+};
+
+/**
+ * @brief The parts of a motion's params and the chassis setup that change how it drives
+ */
+struct Options {
+        lemlib::ProfileConstraints profile; // like Chassis::setLateralProfile, 0 max velocity disables it
+        float profileKA = 0;
+        float minSpeed = 0; // nonzero to sweep a chained motion, which exits early
+        float earlyExitRange = 0;
+        std::optional<lemlib::Feedforward> feedforward; // like Chassis::setFeedforward, for both sides
+        bool mpc = false; // like Chassis::setMpc with the default settings
+};
+
+/**
+ * @brief How one motion went, written by a worker into memory shared with the parent
+ */
+struct Run {
+        int time; // ms the motion took
+        float overshoot; // inches or degrees
+};
+
+struct Result {
+        Gains gains;
+        int totalTime = 0; // ms, summed over every target
+        float maxOvershoot = 0; // inches or degrees
+        int timeouts = 0;
+        float score = 0;
+        std::vector<int> times;
+};
+
+// what the physics tick tracks the overshoot of, and the most it has been in this motion
+Motion tracked = Motion::LATERAL;
+float trackedTarget = 0;
+float maxOvershoot = 0;
+
+/**
+ * @brief Signed distance past the target by ground truth, positive once the robot overshoots
+ */
+float overshoot() {
+    const sim::Pose pose = sim::robotPose();
+    if (tracked == Motion::LATERAL) return lemlib::sgn(trackedTarget) * (pose.y - trackedTarget);
+    return lemlib::sgn(trackedTarget) * (lemlib::radToDeg(pose.theta) - trackedTarget);
+}
+
+/**
+ * @brief Drive to every target with one set of gains, from the origin each time
+ */
+void evaluate(Motion motion, Gains gains, const Options& options, const std::vector<float>& targets, int timeout,
+              Run* runs) {
+    lemlib::ControllerSettings lateral = LATERAL;
+    lemlib::ControllerSettings angular = ANGULAR;
+    lemlib::ControllerSettings& settings = motion == Motion::LATERAL ? lateral : angular;
+    settings.kP = gains.kP;
+    settings.kD = gains.kD;
+    settings.slew = gains.slew;
+    // the gains are fixed once a chassis is built, so every gain set gets its own
+    lemlib::Chassis chassis(DRIVETRAIN, lateral, angular, SENSORS);
+    chassis.setVoltageCompensation(lemlib::VoltageCompensation(&sensorScheduler));
+    chassis.setBrakeMode(pros::E_MOTOR_BRAKE_HOLD);
+    if (options.profile.maxVelocity > 0 && motion == Motion::LATERAL)
+        chassis.setLateralProfile(options.profile, options.profileKA);
+    if (options.profile.maxVelocity > 0 && motion == Motion::ANGULAR)
+        chassis.setAngularProfile(options.profile, options.profileKA);
+    if (options.feedforward) chassis.setFeedforward({*options.feedforward, *options.feedforward});
+    if (options.mpc) chassis.setMpc({});
+
+    tracked = motion;
+    for (std::size_t i = 0; i < targets.size(); i++) {
+        // odometry sees the teleport as a jump in the IMU heading and the encoders, so reset it after
+        // the jump. The teleport stops the robot, wait until the wheels read still too. Odometry is
+        // already running, so only the sensors are reset
+        sim::setRobotPose({0, 0, 0});
+        do pros::delay(RESET_TIME);
+        while (leftMotors.get_actual_velocity() != 0 || rightMotors.get_actual_velocity() != 0);
+        chassis.calibrate(false);
+        chassis.setPose(0, 0, 0);
+        pros::delay(RESET_TIME + PERIOD - pros::millis() % PERIOD);
+
+        trackedTarget = targets[i];
+        maxOvershoot = 0;
+        const std::uint32_t start = pros::millis();
+        if (motion == Motion::LATERAL) {
+            chassis.moveToPoint(0, targets[i], timeout,
+                                {.minSpeed = options.minSpeed, .earlyExitRange = options.earlyExitRange}, false);
+        } else {
+            chassis.turnToHeading(targets[i], timeout,
+                                  {.minSpeed = int(options.minSpeed), .earlyExitRange = options.earlyExitRange},
+                                  false);
+        }
+        runs[i].time = pros::millis() - start;
+        pros::delay(STOP_TIME);
+        runs[i].overshoot = maxOvershoot;
+    }
+}
+
+/**
+ * @brief Run gain sets in a simulation of its own, taking the next one from next until there are none left
+ */
+void work(Motion motion, const std::vector<Gains>& gainSets, std::atomic<std::size_t>& next, const Options& options,
+          const std::vector<float>& targets, int timeout, Run* runs) {
+    sim::configureDrivetrain({.leftPorts = {-1, -12, -11},
+                              .rightPorts = {13, 15, 14},
+                              .trackWidth = 12,
+                              .wheelDiameter = 3.25,
+                              .rpm = 450});
+    sim::onTick([](std::uint32_t) {
+        sim::step(0.001);
+        maxOvershoot = std::max(maxOvershoot, overshoot());
+    });
+    sim::run(
+        [&] {
+            // read the drive like src/main.cpp does, for odometry and battery compensation
+            sensorScheduler.addMotors(&leftMotors);
+            sensorScheduler.addMotors(&rightMotors);
+            sensorScheduler.addImu(&imu);
+            sensorScheduler.addBattery();
+            sensorScheduler.start();
+            lemlib::setSensorScheduler(&sensorScheduler);
+            // calibrate the IMU and start odometry once, for every chassis after this one
+            lemlib::Chassis(DRIVETRAIN, LATERAL, ANGULAR, SENSORS).calibrate();
+            for (std::size_t i = next++; i < gainSets.size(); i = next++)
+                evaluate(motion, gainSets[i], options, targets, timeout, &runs[i * targets.size()]);
+        },
+        0, UINT32_MAX);
+}
+
+/**
+ * @brief Allocate memory shared with the processes forked after this
+ *
+ * @return T* count value-initialized Ts, or nullptr if there isn't the memory
+ */
+template <typename T> T* share(std::size_t count) {
+    void* memory = mmap(nullptr, count * sizeof(T), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED) return nullptr;
+    T* values = static_cast<T*>(memory);
+    for (std::size_t i = 0; i < count; i++) new (&values[i]) T();
+    return values;
+}
+
+/**
+ * @brief Total up one gain set's runs
+ */
+Result score(Gains gains, const Run* runs, std::size_t count, int timeout, float overshootWeight) {
+    Result result {};
+    result.gains = gains;
+    for (std::size_t i = 0; i < count; i++) {
+        result.times.push_back(runs[i].time);
+        result.totalTime += runs[i].time;
+        result.maxOvershoot = std::max(result.maxOvershoot, runs[i].overshoot);
+        if (runs[i].time >= timeout) result.timeouts++;
+    }
+    result.score = result.totalTime + overshootWeight * result.maxOvershoot;
+    return result;
+}
+
+std::vector<float> expand(const Range& range) {
+    std::vector<float> values;
+    if (range.step <= 0) return {range.min};
+    for (int i = 0; range.min + i * range.step <= range.max + range.step / 1000; i++)
+        values.push_back(range.min + i * range.step);
+    return values;
+}
+
+bool parseProfile(const char* text, lemlib::ProfileConstraints& profile) {
+    profile.maxJerk = 0;
+    const int read =
+        std::sscanf(text, "%f:%f:%f", &profile.maxVelocity, &profile.maxAcceleration, &profile.maxJerk);
+    return read >= 2 && profile.maxVelocity > 0 && profile.maxAcceleration > 0 && profile.maxJerk >= 0;
+}
+
+bool parseFeedforward(const char* text, std::optional<lemlib::Feedforward>& feedforward) {
+    float kS, kV, kA;
+    if (std::sscanf(text, "%f:%f:%f", &kS, &kV, &kA) != 3 || kV <= 0) return false;
+    feedforward.emplace(kS, kV, kA);
+    return true;
+}
+
+bool parseRange(const char* text, Range& range) {
+    range.step = 0;
+    const int read = std::sscanf(text, "%f:%f:%f", &range.min, &range.max, &range.step);
+    if (read == 1) range.max = range.min;
+    return read == 1 || read == 3;
+}
+
+std::vector<float> parseList(const char* text) {
+    std::vector<float> values;
+    std::string list(text);
+    std::size_t start = 0;
+    while (start <= list.size()) {
+        const std::size_t end = std::min(list.find(',', start), list.size());
+        values.push_back(std::strtof(list.substr(start, end - start).c_str(), nullptr));
+        start = end + 1;
+    }
+    return values;
+}
+
+void printResult(const char* label, const Result& result) {
+    std::printf("%-9s kP %6.2f  kD %6.2f  slew %5.1f  total %6d ms  overshoot %6.2f  timeouts %d  [", label,
+                result.gains.kP, result.gains.kD, result.gains.slew, result.totalTime, result.maxOvershoot,
+                result.timeouts);
+    for (std::size_t i = 0; i < result.times.size(); i++) std::printf(i == 0 ? "%d" : " %d", result.times[i]);
+    std::printf("]\n");
+}
+
+void usage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s [--motion lateral|angular] [--kp R] [--kd R] [--slew R] [--targets LIST]\n"
+                 "          [--timeout MS] [--overshoot-weight MS] [--jobs N] [--top N]\n"
+                 "          [--profile V:A[:J]] [--profile-ka K] [--min-speed S] [--early-exit R]\n"
+                 "          [--feedforward KS:KV:KA] [--mpc]\n"
+                 "  R is a single value or MIN:MAX:STEP, LIST is comma separated distances in inches\n"
+                 "  or headings in degrees. Gains are ranked by total settle time plus overshoot\n"
+                 "  times the overshoot weight, and gains that time out are ranked last. --profile and\n"
+                 "  --profile-ka sweep a profiled motion like setLateralProfile or setAngularProfile,\n"
+                 "  --min-speed and --early-exit a chained one, and --feedforward and --mpc a chassis\n"
+                 "  with setFeedforward and setMpc. --jobs is how many simulations run at once\n",
+                 program);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    Motion motion = Motion::LATERAL;
+    std::optional<Range> kP;
+    std::optional<Range> kD;
+    std::optional<Range> slew;
+    std::optional<std::vector<float>> targets;
+    Options options;
+    int timeout = 4000;
+    float overshootWeight = 50;
+    unsigned jobs = std::max(std::thread::hardware_concurrency(), 1u);
+    int top = 10;
+    for (int i = 1; i < argc; i++) {
+        const bool hasValue = i + 1 < argc;
+        Range range;
+        if (hasValue && std::strcmp(argv[i], "--motion") == 0) {
+            const char* name = argv[++i];
+            if (std::strcmp(name, "lateral") == 0) motion = Motion::LATERAL;
+            else if (std::strcmp(name, "angular") == 0) motion = Motion::ANGULAR;
+            else return usage(argv[0]), 1;
+        } else if (hasValue && std::strcmp(argv[i], "--kp") == 0 && parseRange(argv[i + 1], range)) {
+            kP = range;
+            i++;
+        } else if (hasValue && std::strcmp(argv[i], "--kd") == 0 && parseRange(argv[i + 1], range)) {
+            kD = range;
+            i++;
+        } else if (hasValue && std::strcmp(argv[i], "--slew") == 0 && parseRange(argv[i + 1], range)) {
+            slew = range;
+            i++;
+        } else if (hasValue && std::strcmp(argv[i], "--profile") == 0 && parseProfile(argv[i + 1], options.profile)) {
+            i++;
+        } else if (hasValue && std::strcmp(argv[i], "--feedforward") == 0 &&
+                   parseFeedforward(argv[i + 1], options.feedforward)) {
+            i++;
+        } else if (std::strcmp(argv[i], "--mpc") == 0) options.mpc = true;
+        else if (hasValue && std::strcmp(argv[i], "--targets") == 0) targets = parseList(argv[++i]);
+        else if (hasValue && std::strcmp(argv[i], "--profile-ka") == 0) options.profileKA = std::atof(argv[++i]);
+        else if (hasValue && std::strcmp(argv[i], "--min-speed") == 0)
+            options.minSpeed = std::fabs(std::atof(argv[++i]));
+        else if (hasValue && std::strcmp(argv[i], "--early-exit") == 0)
+            options.earlyExitRange = std::fabs(std::atof(argv[++i]));
+        else if (hasValue && std::strcmp(argv[i], "--timeout") == 0) timeout = std::atoi(argv[++i]);
+        else if (hasValue && std::strcmp(argv[i], "--overshoot-weight") == 0) overshootWeight = std::atof(argv[++i]);
+        else if (hasValue && std::strcmp(argv[i], "--jobs") == 0) jobs = std::max(std::atoi(argv[++i]), 1);
+        else if (hasValue && std::strcmp(argv[i], "--top") == 0) top = std::atoi(argv[++i]);
+        else return usage(argv[0]), 1;
+    }
+    if (options.mpc && !options.feedforward) {
+        std::fprintf(stderr, "--mpc needs --feedforward\n");
+        return 1;
+    }
+
+    // default grids bracket the gains currently in src/main.cpp
+    const bool lateral = motion == Motion::LATERAL;
+    const std::vector<float> kPs = expand(kP.value_or(lateral ? Range {2, 12, 0.2} : Range {0.5, 5, 0.1}));
+    const std::vector<float> kDs = expand(kD.value_or(Range {0, 30, 1}));
+    const std::vector<float> slews = expand(slew.value_or(lateral ? Range {0, 40, 5} : Range {0, 20, 5}));
+    const std::vector<float> targetList = targets.value_or(lateral ? std::vector<float> {12, 24, 48}
+                                                                   : std::vector<float> {45, 90, 180});
+
+    // the current gains go first, so they are simulated alongside the sweep
+    const lemlib::ControllerSettings& current = lateral ? LATERAL : ANGULAR;
+    std::vector<Gains> gainSets = {{current.kP, current.kD, current.slew}};
+    for (float p : kPs)
+        for (float d : kDs)
+            for (float s : slews) gainSets.push_back({p, d, s});
+    jobs = std::min<std::size_t>(jobs, gainSets.size());
+    std::printf("sweeping %zu %s gain sets in %u simulations\n", gainSets.size() - 1, lateral ? "lateral" : "angular",
+                jobs);
+    std::fflush(stdout);
+
+    // only lock-free atomics work between processes
+    static_assert(std::atomic<std::size_t>::is_always_lock_free);
+    // workers take gain sets from the counter and fill in their runs, in memory that outlives them
+    std::atomic<std::size_t>* next = share<std::atomic<std::size_t>>(1);
+    Run* runs = share<Run>(gainSets.size() * targetList.size());
+    if (next == nullptr || runs == nullptr) {
+        std::perror("mmap");
+        return 1;
+    }
+    for (unsigned job = 0; job < jobs; job++) {
+        const pid_t pid = fork();
+        if (pid < 0) {
+            std::perror("fork");
+            return 1;
+        }
+        if (pid == 0) {
+            work(motion, gainSets, *next, options, targetList, timeout, runs);
+            // tasks that never return are still parked on their threads, so skip static destructors
+            std::_Exit(0);
+        }
+    }
+    bool failed = false;
+    for (unsigned job = 0; job < jobs; job++) {
+        int status;
+        failed |= wait(&status) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0;
+    }
+    if (failed) {
+        std::fprintf(stderr, "a simulation failed\n");
+        return 1;
+    }
+
+    std::vector<Result> results;
+    for (std::size_t i = 0; i < gainSets.size(); i++)
+        results.push_back(score(gainSets[i], &runs[i * targetList.size()], targetList.size(), timeout,
+                                overshootWeight));
+    printResult("current", results.front());
+    results.erase(results.begin());
+    std::sort(results.begin(), results.end(), [](const Result& a, const Result& b) {
+        if (a.timeouts != b.timeouts) return a.timeouts < b.timeouts;
+        return a.score < b.score;
+    });
+    for (int i = 0; i < top && i < int(results.size()); i++) {
+        printResult(("#" + std::to_string(i + 1)).c_str(), results[i]);
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "main.h" // IWYU pragma: keep
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief How many commands an ActuatorCache has written and skipped
+ */
+struct ActuatorStats {
+        /** commands written to a motor or ADI port */
+        std::uint32_t issued = 0;
+        /** commands that were already what the output was set to, or were replaced before being written */
+        std::uint32_t suppressed = 0;
+};
+
+/**
+ * @brief Holds the last command of every motor and pneumatic, and only writes the ones that change
+ *
+ * Control loops set their outputs every tick whether or not anything changed, and every write is
+ * a trip through the device's mutex to the smart port or ADI expander. The cache takes commands
+ * from any task, and once per tick writes only the outputs whose command differs from what was
+ * last written. An output set several times in one tick is written once, with its last value.
+ *
+ * Outputs are added the first time they're set. Everything that drives an output has to go
+ * through the cache, or the cache won't know the output changed. Until start() is called,
+ * commands are written as soon as they're set, still skipping the ones that don't change anything
+ *
+ * @b Example
+ * @code {.cpp}
+ * ActuatorCache actuators;
+ * actuators.start();
+ * // in any task, as often as you like
+ * actuators.move(&intake, 127);
+ * actuators.set(&clamp, true);
+ * @endcode
+ */
+class ActuatorCache {
+    public:
+        /**
+         * @brief Construct a new ActuatorCache with no outputs
+         */
+        ActuatorCache();
+        /**
+         * @brief Set the power of a motor or motor group
+         *
+         * @param motor the motor
+         * @param power -127 to 127, like pros::Motor::move
+         */
+        void move(pros::AbstractMotor* motor, std::int32_t power);
+        /**
+         * @brief Set the state of a digital output, such as a solenoid
+         *
+         * @param output the digital output
+         * @param value true to set the port high
+         */
+        void set(pros::adi::DigitalOut* output, bool value);
+        /**
+         * @brief Write every output whose command changed since it was last written
+         *
+         * The task started by start() calls this every period. It can be called directly instead,
+         * e.g. at the end of a control loop
+         */
+        void flush();
+        /**
+         * @brief Start a task that flushes the cache. Does nothing if it's already running
+         *
+         * @param period how often to flush, in milliseconds. 10 by default, once per control tick
+         */
+        void start(std::uint32_t period = 10);
+        /**
+         * @brief Forget what was written, so every output is written again on the next flush
+         *
+         * For when an output was driven without the cache, or a device was unplugged
+         */
+        void invalidate();
+        /**
+         * @brief Get how many commands were written and skipped since the cache was made
+         */
+        ActuatorStats getStats();
+    private:
+        template <typename Device, typename Value> struct Output {
+                Device* device = nullptr;
+                Value pending {};
+                Value written {};
+                bool staged = false; // pending hasn't been flushed
+                bool known = false; // written holds what the device was last given
+        };
+
+        static constexpr std::size_t MAX_OUTPUTS = 16;
+
+        template <typename Device, typename Value, std::size_t N>
+        void stage(std::array<Output<Device, Value>, N>& outputs, std::size_t& count, Device* device, Value value);
+        template <typename Device, typename Value, std::size_t N>
+        void writeChanged(std::array<Output<Device, Value>, N>& outputs, std::size_t count);
+
+        std::array<Output<pros::AbstractMotor, std::int32_t>, MAX_OUTPUTS> motors;
+        std::size_t motorCount = 0;
+        std::array<Output<pros::adi::DigitalOut, bool>, MAX_OUTPUTS> digitalOuts;
+        std::size_t digitalOutCount = 0;
+        ActuatorStats stats;
+        pros::Mutex mutex;
+        pros::Task* task = nullptr;
+};
+
+// Writes the intake motors and pistons only when their command changes, once per tick
+extern ActuatorCache actuators;
@@ -0,0 +1,20 @@
+#pragma once
+#include "main.h" // IWYU pragma: keep
+#include "lemlib/sensors.hpp"
+
+// Distance sensor looking across the path at the indexer
+extern pros::Distance blockSensor;
+
+// Block counting. Every block that passes the indexer counts once, as stored while the intake
+// is storing and as scored while it scores in the long or upper middle goal. blockSensor has to
+// be added to sensorScheduler before it starts
+void startBlockCounter();
+void updateBlockCounter();
+int getBlocksStored();
+int getBlocksScored();
+float getBlockThroughput();
+void resetBlockCount();
+
+// Wait until count blocks have been scored since the last reset, or timeout ms pass. Returns
+// whether the count was reached
+bool waitUntilScored(int count, int timeout);
@@ -0,0 +1,14 @@
+#pragma once
+#include "main.h" // IWYU pragma: keep
+#include "colorSorter.hpp"
+#include "intake.hpp"
+
+// Optical sensor looking at blocks as they pass the bottom of the indexer
+extern pros::Optical sortSensor;
+
+// Color sorting task, running the ColorSorter from colorSorter.hpp on this robot. Blocks of the
+// rejected color are thrown out at the top of the intake, timed from the indexer's velocity.
+// sortSensor has to be added to sensorScheduler before it starts
+void startColorSort();
+void setColorSort(BlockColor reject, EjectMethod method);
+int getBlocksEjected();
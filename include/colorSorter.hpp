@@ -0,0 +1,145 @@
+#pragma once
+#include "main.h" // IWYU pragma: keep
+#include <array>
+#include <cstdint>
+#include "lemlib/sensors.hpp"
+
+/**
+ * @brief Color of a game piece
+ */
+enum class BlockColor { NONE, RED, BLUE };
+
+/**
+ * @brief Which optical readings count as a block, and which color it is
+ *
+ * Red wraps around 0, so it is the hues above redMinHue or below redMaxHue
+ */
+struct ColorModel {
+        /** highest hue that is red, in degrees. 30 by default */
+        float redMaxHue = 30;
+        /** lowest hue that is red, in degrees. 330 by default */
+        float redMinHue = 330;
+        /** lowest hue that is blue, in degrees. 180 by default */
+        float blueMinHue = 180;
+        /** highest hue that is blue, in degrees. 260 by default */
+        float blueMaxHue = 260;
+        /** saturation below which the color is too washed out to tell, from 0 to 1. 0.3 by default */
+        float minSaturation = 0.3;
+        /** proximity at which a block is in front of the sensor, from 0 to 255. 100 by default */
+        std::int32_t minProximity = 100;
+};
+
+/**
+ * @brief Classify one optical reading
+ *
+ * @param sample the reading
+ * @param model thresholds of the colors
+ * @return BlockColor NONE if there is no block in front of the sensor, or its color can't be told
+ */
+BlockColor classifyBlock(const lemlib::OpticalSample& sample, const ColorModel& model = {});
+
+/**
+ * @brief Where the sensor and the ejector are along the intake, and how the ejector behaves
+ */
+struct ColorSortSettings {
+        /** distance a block travels from the optical sensor to the ejector, in inches */
+        float distanceToEjector = 6;
+        /** diameter of the roller that carries blocks past the sensor, in inches */
+        float rollerDiameter = 2;
+        /** ratio of block speed to roller surface speed, below 1 if blocks slip. 1 by default */
+        float slip = 1;
+        /** time from firing the ejector to it acting on a block, in milliseconds. 20 by default */
+        float ejectLatency = 20;
+        /** length of a block along the intake, in inches. 3 by default */
+        float blockLength = 3;
+        /** readings a block needs before it can be ejected, so a glancing reading can't fire. 2 by default */
+        int minReadings = 2;
+        /** roller velocity the intake normally runs at, for the shortest ejection, in rpm. 600 by default */
+        float nominalRpm = 600;
+};
+
+/**
+ * @brief Decides when to eject blocks of the wrong color
+ *
+ * Each block that comes in front of the optical sensor is tracked until it reaches the ejector.
+ * Its color is voted on by every reading taken while it's in front of the sensor, and a tied vote
+ * is never ejected. Its distance to the ejector is counted down from the measured roller velocity.
+ * The ejector fires once the block is ejectLatency away from it, so the ejector acts just as the
+ * block arrives, even if the rollers change speed on the way.
+ *
+ * The sorter only makes decisions, so it runs the same on the robot and on recorded traces
+ *
+ * @b Example
+ * @code {.cpp}
+ * ColorSorter sorter({.distanceToEjector = 6, .rollerDiameter = 2});
+ * sorter.setReject(BlockColor::BLUE);
+ * // every time there is a new reading
+ * if (sorter.update(&sample, indexerRpm, pros::millis())) eject();
+ * @endcode
+ */
+class ColorSorter {
+    public:
+        /**
+         * @brief ColorSorter constructor
+         *
+         * @param settings geometry and timing of the intake
+         * @param model thresholds of the colors
+         */
+        ColorSorter(const ColorSortSettings& settings, const ColorModel& model = {});
+        /**
+         * @brief Set which color to eject
+         *
+         * @param color the color to eject, NONE to keep everything
+         */
+        void setReject(BlockColor color);
+        /**
+         * @brief Get which color is being ejected
+         */
+        BlockColor getReject() const;
+        /**
+         * @brief Track blocks up to now
+         *
+         * @param sample a new optical reading, or nullptr if there isn't one this time
+         * @param rollerRpm velocity of the roller carrying the blocks, positive towards the ejector
+         * @param time now, in milliseconds
+         * @return true if the ejector should fire now
+         */
+        bool update(const lemlib::OpticalSample* sample, float rollerRpm, std::uint32_t time);
+        /**
+         * @brief How long the ejector has to stay out for a whole block to pass it
+         *
+         * Holding it longer risks catching the next block, which can be right behind. The measured
+         * velocity can dip to 0 in the tick the ejector fires, so the time is never shorter than a
+         * block takes to pass at nominalRpm
+         *
+         * @param rollerRpm velocity of the roller carrying the blocks
+         * @return float the time, in milliseconds
+         */
+        float getEjectTime(float rollerRpm) const;
+        /**
+         * @brief Forget every tracked block, e.g. when the intake stops or reverses to clear a jam
+         */
+        void reset();
+    private:
+        /**
+         * @brief Speed blocks move along the intake at, in inches per second
+         */
+        float blockSpeed(float rollerRpm) const;
+
+        struct Block {
+                float remaining = 0; // inches to the ejector
+                int red = 0; // readings that were red
+                int blue = 0; // readings that were blue
+        };
+
+        static constexpr int MAX_BLOCKS = 4;
+
+        ColorSortSettings settings;
+        ColorModel model;
+        BlockColor reject = BlockColor::NONE;
+        std::array<Block, MAX_BLOCKS> blocks;
+        int blockCount = 0;
+        bool inView = false; // the newest block is still in front of the sensor
+        std::uint32_t lastTime = 0;
+        bool started = false;
+};
@@ -1,8 +1,9 @@
 #pragma once
 #include "main.h" // IWYU pragma: keep
+#include "lemlib/sensors.hpp"
 
 extern pros::adi::DigitalOut wing;
 extern bool wingToggle;
 
 void setWing(bool extended);
-void descoreControl();
\ No newline at end of file
+void descoreControl(const lemlib::ControllerSample& input);
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 #include "main.h" // IWYU pragma: keep
 #include <sys/_intsup.h>
+#include "lemlib/sensors.hpp"
 
 // Motor/Sensor declarations for intake system
 extern pros::Motor bottomIntake;
@@ -21,7 +22,38 @@ extern bool hoodPistonToggle;
 void setFloatingPiston(bool extended);
 void setHoodPiston(bool extended);
 
+// States of the intake, each one a piston setup and a roller direction
+enum class IntakeState {
+    STOP,       // rollers stopped
+    STORE,      // intake and hold blocks
+    LONG,       // score in the long goal, hood up
+    UPPER_MID,  // score in the upper middle goal, indexer piston out
+    LOWER_MID,  // score in the lower middle goal, floating piston down and rollers reversed
+    OUTTAKE     // spit blocks out the front
+};
+
+// Ways to throw out a block on its way up: flip the hood to the other goal, or reverse the indexer
+enum class EjectMethod {
+    HOOD,
+    REVERSE
+};
+
+// Intake state machine. The intake task runs it every 10 ms, reversing the rollers for a moment
+// whenever they jam and then carrying on. While storing, a stall means the hopper is full and the
+// rollers keep pushing. None of these block
+void startIntakeTask();
+void setIntakeState(IntakeState state, int voltage);
+IntakeState getIntakeState();
+bool isIntakeUnjamming();
+// Throw out the block at the top of the intake for duration ms, then go back to the current state.
+// Does nothing unless the intake is moving blocks up
+void ejectBlock(EjectMethod method, int duration);
+bool isIntakeEjecting();
+bool isIntakeRunningUp();
+int getIntakeJamCount();
+
 // Intake functions
+void runIntake(int voltage);
 void intakeStore(int voltage);
 void intakeStop();
 
@@ -32,4 +64,4 @@ void outtakeLowerMid(int voltage);
 void outtake(int voltage);
 
 // Used control function
-void intakeControl();
\ No newline at end of file
+void intakeControl(const lemlib::ControllerSample& input);
\ No newline at end of file
@@ -3,7 +3,10 @@
 #include "lemlib/pid.hpp" // IWYU pragma: keep
 #include "lemlib/pose.hpp" // IWYU pragma: keep
 #include "lemlib/util.hpp" // IWYU pragma: keep
+#include "lemlib/voltageCompensation.hpp" // IWYU pragma: keep
 #include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/motionQueue.hpp" // IWYU pragma: keep
+#include "lemlib/chassis/odom.hpp" // IWYU pragma: keep
 #include "lemlib/chassis/trackingWheel.hpp" // IWYU pragma: keep
 #include "lemlib/logger/logger.hpp" // IWYU pragma: keep
 
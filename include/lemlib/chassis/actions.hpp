@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "pros/rtos.hpp"
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+/**
+ * @brief Runs callbacks partway through a chassis motion
+ *
+ * Actions are checked by the motion's own loop every tick, right after it moves the drivetrain, so
+ * they run in the motion's task exactly when their trigger is crossed, with no task or delay of
+ * their own. Each action runs once. Actions belong to the motion that is running when they are
+ * registered, or the next one to start if none is, and the ones that never trigger are dropped when
+ * that motion ends. Register them right after starting an asynchronous motion.
+ *
+ * Distances are in inches for moveToPoint, moveToPose and follow, and in degrees for turns and
+ * swings, like Chassis::getDistanceTraveled(). Callbacks should return quickly, since the motion
+ * waits for them
+ *
+ * @b Example
+ * @code {.cpp}
+ * chassis.moveToPoint(36, -34, 1000, {.maxSpeed = 70});
+ * chassis.actions.atRemaining(6, [] { intakeStore(127); });
+ * chassis.actions.atTime(300, [] { setLittleWill(true); });
+ * chassis.actions.when([](const lemlib::Pose& pose) { return pose.y < -20; }, [] { setHoodPiston(true); });
+ * chassis.waitUntilDone();
+ * @endcode
+ */
+class ActionScheduler {
+    public:
+        /**
+         * @brief Run an action once the motion has traveled a distance
+         *
+         * @param distance distance traveled since the start of the motion
+         * @param action the callback
+         */
+        void atDistance(float distance, std::function<void()> action);
+        /**
+         * @brief Run an action once the motion is within a distance of its target
+         *
+         * @param distance distance left to the target, or to the end of the path
+         * @param action the callback
+         */
+        void atRemaining(float distance, std::function<void()> action);
+        /**
+         * @brief Run an action once the motion has been running for a time
+         *
+         * @param time milliseconds since the motion started
+         * @param action the callback
+         */
+        void atTime(int time, std::function<void()> action);
+        /**
+         * @brief Run an action once the robot's pose meets a condition
+         *
+         * @param condition checked every tick with the pose in degrees, like Chassis::getPose()
+         * @param action the callback
+         */
+        void when(std::function<bool(const Pose&)> condition, std::function<void()> action);
+        /**
+         * @brief Start timing a motion. Called by the motions when they start
+         */
+        void begin();
+        /**
+         * @brief Run every action whose trigger has been crossed. Called by the motions every tick
+         *
+         * @param traveled distance traveled since the start of the motion
+         * @param remaining distance left to the target
+         * @param pose pose of the robot, in degrees
+         */
+        void update(float traveled, float remaining, const Pose& pose);
+        /**
+         * @brief Drop every action that hasn't run. Called by the motions when they end
+         */
+        void clear();
+        /**
+         * @brief Whether there are actions waiting to run
+         */
+        bool empty() const;
+    private:
+        enum class Trigger { DISTANCE, REMAINING, TIME, POSE };
+
+        struct Action {
+                Trigger trigger;
+                float threshold; // inches, degrees or milliseconds, unused for POSE
+                std::function<bool(const Pose&)> condition; // only for POSE
+                std::function<void()> callback;
+        };
+
+        void add(Action action);
+
+        std::vector<Action> actions;
+        /** callbacks that fired this tick, kept so update doesn't allocate every tick */
+        std::vector<std::function<void()>> fired;
+        /** millis() when the motion started */
+        std::uint32_t startTime = 0;
+        mutable pros::Mutex mutex;
+};
+} // namespace lemlib
@@ -1,13 +1,25 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
+#include <optional>
+#include <utility>
 #include "pros/rtos.hpp"
 #include "pros/imu.hpp"
 #include "lemlib/asset.hpp"
+#include "lemlib/chassis/actions.hpp"
 #include "lemlib/chassis/trackingWheel.hpp"
 #include "lemlib/pose.hpp"
 #include "lemlib/pid.hpp"
 #include "lemlib/exitcondition.hpp"
 #include "lemlib/driveCurve.hpp"
+#include "lemlib/feedforward.hpp"
+#include "lemlib/mpc.hpp"
+#include "lemlib/profile.hpp"
+#include "lemlib/ramsete.hpp"
+#include "lemlib/sensors.hpp"
+#include "lemlib/trajectory.hpp"
+#include "lemlib/voltageCompensation.hpp"
 
 namespace lemlib {
 
@@ -73,6 +85,9 @@ class ControllerSettings {
          * @param largeErrorTimeout the time the chassis controller will wait before exiting if error is within a
          * certain range determined by largeError
          * @param slew maximum acceleration
+         * @param settleVelocity velocity under which the chassis counts as stopped, in inches per second for lateral
+         * and degrees per second for angular. Once the error is within smallError and the chassis has stopped, the
+         * controller exits without waiting out smallErrorTimeout. 0 by default, which disables it
          *
          * @b Example
          * @code {.cpp}
@@ -84,11 +99,12 @@ class ControllerSettings {
          *                                            100, // small error range timeout, in milliseconds
          *                                            3, // large error range, in inches
          *                                            500, // large error range timeout, in milliseconds
-         *                                            5); // maximum acceleration (slew)
+         *                                            5, // maximum acceleration (slew)
+         *                                            2); // settle velocity, in inches per second
          * @endcode
          */
         ControllerSettings(float kP, float kI, float kD, float windupRange, float smallError, float smallErrorTimeout,
-                           float largeError, float largeErrorTimeout, float slew)
+                           float largeError, float largeErrorTimeout, float slew, float settleVelocity = 0)
             : kP(kP),
               kI(kI),
               kD(kD),
@@ -97,7 +113,8 @@ class ControllerSettings {
               smallErrorTimeout(smallErrorTimeout),
               largeError(largeError),
               largeErrorTimeout(largeErrorTimeout),
-              slew(slew) {}
+              slew(slew),
+              settleVelocity(settleVelocity) {}
 
         float kP;
         float kI;
@@ -108,6 +125,7 @@ class ControllerSettings {
         float largeError;
         float largeErrorTimeout;
         float slew;
+        float settleVelocity;
 };
 
 /**
@@ -196,6 +214,9 @@ struct TurnToPointParams {
         /** angle between the robot and target point where the movement will exit. Only has an effect if minSpeed is
          * non-zero.*/
         float earlyExitRange = 0;
+        /** whether to leave the drivetrain moving when the motion ends, for a motion that starts right after it.
+         * MotionQueue sets it. false by default */
+        bool handoff = false;
 };
 
 /**
@@ -217,6 +238,9 @@ struct TurnToHeadingParams {
         /** angle between the robot and target point where the movement will exit. Only has an effect if minSpeed is
          * non-zero.*/
         float earlyExitRange = 0;
+        /** whether to leave the drivetrain moving when the motion ends, for a motion that starts right after it.
+         * MotionQueue sets it. false by default */
+        bool handoff = false;
 };
 
 /**
@@ -253,6 +277,9 @@ struct SwingToPointParams {
         /** angle between the robot and target heading where the movement will exit. Only has an effect if minSpeed is
          * non-zero.*/
         float earlyExitRange = 0;
+        /** whether to leave the drivetrain moving when the motion ends, for a motion that starts right after it.
+         * MotionQueue sets it. false by default */
+        bool handoff = false;
 };
 
 /**
@@ -274,6 +301,21 @@ struct SwingToHeadingParams {
         /** angle between the robot and target heading where the movement will exit. Only has an effect if minSpeed is
          * non-zero.*/
         float earlyExitRange = 0;
+        /** whether to leave the drivetrain moving when the motion ends, for a motion that starts right after it.
+         * MotionQueue sets it. false by default */
+        bool handoff = false;
+};
+
+/**
+ * @brief PoseController
+ *
+ * Chassis::moveToPose can steer with one of two controllers.
+ * BOOMERANG chases a carrot point ahead of the target with the lateral and angular PIDs.
+ * RAMSETE generates a trajectory to the target and tracks it with a Ramsete controller
+ */
+enum class PoseController {
+    BOOMERANG, /** chase a carrot point with PIDs */
+    RAMSETE /** track a generated trajectory, see Chassis::setRamsete */
 };
 
 /**
@@ -300,6 +342,11 @@ struct MoveToPoseParams {
         /** distance between the robot and target point where the movement will exit. Only has an effect if minSpeed is
          * non-zero.*/
         float earlyExitRange = 0;
+        /** how the robot steers to the target. BOOMERANG by default */
+        PoseController controller = PoseController::BOOMERANG;
+        /** whether to leave the drivetrain moving when the motion ends, for a motion that starts right after it.
+         * MotionQueue sets it. false by default */
+        bool handoff = false;
 };
 
 /**
@@ -321,15 +368,38 @@ struct MoveToPointParams {
         /** distance between the robot and target point where the movement will exit. Only has an effect if minSpeed is
          * non-zero.*/
         float earlyExitRange = 0;
+        /** whether to leave the drivetrain moving when the motion ends, for a motion that starts right after it.
+         * MotionQueue sets it. false by default */
+        bool handoff = false;
+};
+
+/**
+ * @brief Parameters for Chassis::characterize
+ *
+ * The robot drives forwards for the quasistatic test and backwards for the dynamic one, so it
+ * ends up near where it started. The defaults need about 5 feet of space in front of the robot
+ */
+struct CharacterizeParams {
+        /** how fast the quasistatic test ramps the voltage up, in volts per second. 1.5 by default */
+        float rampRate = 1.5;
+        /** how long the quasistatic test runs, in seconds. 4 by default */
+        float rampTime = 4;
+        /** voltage of the dynamic test's step. 6 by default */
+        float stepVoltage = 6;
+        /** how long the dynamic test runs, in seconds. 1.5 by default */
+        float stepTime = 1.5;
 };
 
 // default drive curve
 extern ExpoDriveCurve defaultDriveCurve;
 
+class MotionQueue;
+
 /**
  * @brief Chassis class
  */
 class Chassis {
+        friend class MotionQueue;
     public:
         /**
          * @brief Chassis constructor
@@ -649,6 +719,8 @@ class Chassis {
          * // move the robot to 0, 0, and facing heading 0 with a timeout of 4000ms
          * // this motion should not be as curved as the others, so we set lead to a smaller value (0.3)
          * chassis.moveToPose(0, 0, 0, 4000, {.lead = 0.3});
+         * // track a generated trajectory to the target instead of chasing a carrot point
+         * chassis.moveToPose(24, 24, 90, 2000, {.controller = lemlib::PoseController::RAMSETE});
          * @endcode
          */
         void moveToPose(float x, float y, float theta, int timeout, MoveToPoseParams params = {}, bool async = true);
@@ -708,6 +780,33 @@ class Chassis {
          * @endcode
          */
         void follow(const asset& path, float lookahead, int timeout, bool forwards = true, bool async = true);
+        /**
+         * @brief Move the chassis along a pregenerated trajectory
+         *
+         * Steers with pure pursuit like follow(), but drives at the velocity the trajectory generator
+         * planned for each point, which already respects the acceleration and wheel speed limits of
+         * the robot. The velocity goes through the feedforward model when there is one. The asset is
+         * read in place, nothing is parsed or copied when the motion starts
+         *
+         * @param trajectory the trajectory asset, written by the trajectory generator (make trajectory)
+         * @param lookahead the lookahead distance. Units in inches
+         * @param timeout the maximum time the robot can spend moving
+         * @param forwards whether the robot should follow the trajectory going forwards. true by default
+         * @param async whether the function should be run asynchronously. true by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // generated with make trajectory TRAJ_ARGS="static/myPath.txt -o static/myPath.traj"
+         * ASSET(myPath_traj);
+         *
+         * void autonomous() {
+         *     // follow the trajectory with a lookahead of 10 inches and a timeout of 4000ms
+         *     chassis.followTrajectory(myPath_traj, 10, 4000);
+         * }
+         * @endcode
+         */
+        void followTrajectory(const asset& trajectory, float lookahead, int timeout, bool forwards = true,
+                              bool async = true);
         /**
          * @brief Control the robot during the driver using the tank drive control scheme. In this control scheme one
          * joystick axis controls the left motors' forward and backwards movement of the robot, while the other joystick
@@ -895,6 +994,141 @@ class Chassis {
          * @endcode
          */
         void resetLocalPosition();
+        /**
+         * @brief Drive moveToPoint along a motion profile
+         *
+         * Instead of chasing the target with PID alone, the motion plans a velocity profile along
+         * the line to the target and drives it with feedforward, leaving PID to correct the error
+         * from where the profile says the robot should be. The profile limits acceleration, so the
+         * lateral slew isn't applied. Exit conditions still use the distance to the target
+         *
+         * @param constraints limits of the profile, in inches. A maxVelocity of 0 disables profiling. Limits
+         * that can't make a profile, like a maxAcceleration of 0, are logged and disable it too
+         * @param kA motor power per in/s^2 of acceleration the profile asks for, 0 by default. Without
+         * it the robot lags the profile while accelerating and overruns it while braking
+         *
+         * @b Example
+         * @code {.cpp}
+         * // at most 60 in/s, 150 in/s^2 and 1000 in/s^3, an S-curve
+         * chassis.setLateralProfile({60, 150, 1000}, 0.15);
+         * chassis.moveToPoint(0, 48, 2000);
+         * @endcode
+         */
+        void setLateralProfile(const ProfileConstraints& constraints, float kA = 0);
+        /**
+         * @brief Drive turnToHeading along a motion profile
+         *
+         * @see setLateralProfile
+         *
+         * @param constraints limits of the profile, in degrees. A maxVelocity of 0 disables profiling. Limits
+         * that can't make a profile, like a maxAcceleration of 0, are logged and disable it too
+         * @param kA motor power per deg/s^2 of angular acceleration the profile asks for, 0 by default
+         *
+         * @b Example
+         * @code {.cpp}
+         * // at most 540 deg/s and 1500 deg/s^2, a trapezoid
+         * chassis.setAngularProfile({540, 1500}, 0.01);
+         * chassis.turnToHeading(90, 1000);
+         * @endcode
+         */
+        void setAngularProfile(const ProfileConstraints& constraints, float kA = 0);
+        /**
+         * @brief Drive with a feedforward model of each drivetrain side
+         *
+         * Once set, moveToPoint, moveToPose, turnToHeading, turnToPoint and follow treat their
+         * output as a wheel velocity, as a fraction of the drivetrain's free speed, and apply the
+         * voltage the model says holds that velocity. Static friction and the real back EMF are
+         * accounted for, so the PIDs only correct what the model gets wrong and can use lower
+         * gains. Motion profiles also use the model's kA in place of their own
+         *
+         * @param feedforward gains of each side, from characterize() or fitFeedforward()
+         *
+         * @b Example
+         * @code {.cpp}
+         * chassis.setFeedforward({lemlib::Feedforward(0.8, 0.15, 0.02), lemlib::Feedforward(0.8, 0.15, 0.02)});
+         * @endcode
+         */
+        void setFeedforward(const DriveFeedforward& feedforward);
+        /**
+         * @brief Set up moveToPose with PoseController::RAMSETE
+         *
+         * A RAMSETE moveToPose generates a trajectory from the robot to the target, shaped by lead,
+         * and tracks it by time. The robot drives the trajectory's velocities through feedforward,
+         * and the controller corrects position and heading errors together. Once the trajectory is
+         * over the lateral and angular PIDs settle the robot on the target, with the usual exit
+         * conditions. With minSpeed set the motion exits at earlyExitRange or the end of the
+         * trajectory instead
+         *
+         * @param ramsete the controller gains
+         * @param constraints limits of the generated trajectories. Fields left at 0 come from the
+         * lateral profile if one is set, or from the drivetrain otherwise
+         *
+         * @b Example
+         * @code {.cpp}
+         * chassis.setRamsete(lemlib::Ramsete(0.003, 0.9), {.maxVelocity = 60, .maxAcceleration = 120});
+         * chassis.moveToPose(24, 24, 90, 2000, {.controller = lemlib::PoseController::RAMSETE});
+         * @endcode
+         */
+        void setRamsete(const Ramsete& ramsete, const TrajectoryConstraints& constraints = {});
+        /**
+         * @brief Drive the wheels with a model predictive controller
+         *
+         * Needs a feedforward model, so call it after setFeedforward(). Wherever the model would
+         * turn a wheel velocity into a voltage, the controller plans the next DriveMpc::HORIZON
+         * voltages of both sides to reach that velocity from the measured one instead, within the
+         * voltage, acceleration and angular acceleration limits, and applies the first. The motions
+         * don't change, only how their output reaches the motors
+         *
+         * @param settings weights and limits of the controller. The track width comes from the
+         * drivetrain
+         *
+         * @b Example
+         * @code {.cpp}
+         * chassis.setFeedforward({lemlib::Feedforward(0.3, 0.162, 0.019), lemlib::Feedforward(0.3, 0.162, 0.019)});
+         * chassis.setMpc({.maxAcceleration = 400, .maxAngularAcceleration = 100});
+         * @endcode
+         */
+        void setMpc(const MpcSettings& settings);
+        /**
+         * @brief Scale every drivetrain command by the battery voltage
+         *
+         * Motions, driver control and the feedforward model all command the motors as if the
+         * battery were at the nominal voltage, so the same routine drives the same on a charged
+         * battery and a tired one
+         *
+         * @param compensation reads the battery and scales the commands
+         *
+         * @b Example
+         * @code {.cpp}
+         * sensorScheduler.addBattery();
+         * chassis.setVoltageCompensation(lemlib::VoltageCompensation(&sensorScheduler));
+         * @endcode
+         */
+        void setVoltageCompensation(const VoltageCompensation& compensation);
+        /**
+         * @brief Measure the feedforward gains of each drivetrain side
+         *
+         * Runs a quasistatic test, ramping the voltage slowly so acceleration is negligible, then a
+         * dynamic test, stepping the voltage so acceleration dominates. Position is read from the
+         * drive motors every 10 ms. Every sample is logged to the telemetry sink as
+         * time,leftVoltage,leftVelocity,leftAcceleration,rightVoltage,rightVelocity,rightAcceleration
+         * and the gains are fit by least squares. With setVoltageCompensation, the voltages are
+         * applied and logged in nominal volts, the same units the gains are used in. This function
+         * is blocking, and waits for any motion in progress to finish first
+         *
+         * @param params struct to simulate named parameters
+         * @return std::optional<DriveFeedforward> the fitted gains, or nothing if the robot barely moved
+         *
+         * @b Example
+         * @code {.cpp}
+         * std::optional<lemlib::DriveFeedforward> gains = chassis.characterize();
+         * if (gains) {
+         *     printf("kS %f kV %f kA %f\n", gains->left.kS, gains->left.kV, gains->left.kA);
+         *     chassis.setFeedforward(*gains);
+         * }
+         * @endcode
+         */
+        std::optional<DriveFeedforward> characterize(CharacterizeParams params = {});
         /**
          * PIDs are exposed so advanced users can implement things like gain scheduling
          * Changes are immediate and will affect a motion in progress
@@ -909,6 +1143,17 @@ class Chassis {
          * @warning Do not interact with these unless you know what you are doing
          */
         PID angularPID;
+        /**
+         * Actions to run partway through the current motion, triggered by distance, time or pose
+         *
+         * @b Example
+         * @code {.cpp}
+         * chassis.moveToPoint(36, -34, 1000);
+         * // start the intake 6 inches before the target
+         * chassis.actions.atRemaining(6, [] { intakeStore(127); });
+         * @endcode
+         */
+        ActionScheduler actions;
     protected:
         /**
          * @brief Indicates that this motion is queued and blocks current task until this motion reaches front of queue
@@ -921,9 +1166,121 @@ class Chassis {
 
         bool motionRunning = false;
         bool motionQueued = false;
+        /**
+         * whether another motion follows the current one, so the drivetrain keeps moving between them
+         * instead of stopping. Each motion sets it from its params once it owns the mutex
+         */
+        std::atomic<bool> handoff = false;
+        /**
+         * left and right power the drivetrain was last commanded by a motion, 0 once a motion stops it.
+         * Each motion's slew starts from it, so the one after a handoff carries on from the same power
+         */
+        std::pair<float, float> commandedPower = {0, 0};
+        /** incremented by cancelAllMotions, so a MotionQueue knows to stop */
+        std::atomic<std::uint32_t> cancelAllCount = 0;
 
         float distTraveled = 0;
 
+        /**
+         * @brief Run the actions whose triggers were crossed. Called by every motion each tick
+         *
+         * @param remaining distance left to the target, in the motion's units
+         */
+        void updateActions(float remaining);
+
+        /**
+         * @brief moveToPose with PoseController::RAMSETE. Called by moveToPose once it has the mutex
+         */
+        void moveToPoseRamsete(float x, float y, float theta, int timeout, MoveToPoseParams params);
+
+        /**
+         * @brief Get the motor power that asks moveDrivetrain() for a wheel velocity
+         *
+         * @param velocity wheel velocity, in inches per second
+         * @return float motor power, -127 to 127 at the drivetrain's free speed
+         */
+        float feedforward(float velocity) const;
+        /**
+         * @brief Move the drivetrain, through the feedforward model if there is one
+         *
+         * With a model, the power of each side is the velocity it asks for, and that side's own
+         * gains turn the velocity and acceleration into a voltage. kS follows the sign of the
+         * velocity, so it holds while the wheels brake. Without a model the accelerations are ignored
+         *
+         * @param leftPower power of the left side, -127 to 127
+         * @param rightPower power of the right side, -127 to 127
+         * @param leftAcceleration acceleration of the left wheels, in inches per second squared. 0 by default
+         * @param rightAcceleration acceleration of the right wheels, in inches per second squared. 0 by default
+         */
+        void moveDrivetrain(float leftPower, float rightPower, float leftAcceleration = 0, float rightAcceleration = 0);
+        /**
+         * @brief Move both sides of the drivetrain, scaled by the battery voltage
+         *
+         * @param leftPower power of the left side, -127 to 127
+         * @param rightPower power of the right side, -127 to 127
+         */
+        void movePower(float leftPower, float rightPower);
+        /**
+         * @brief Apply a voltage to both sides of the drivetrain, scaled by the battery voltage
+         *
+         * @param leftVoltage voltage of the left side, in volts
+         * @param rightVoltage voltage of the right side, in volts
+         */
+        void moveVoltage(float leftVoltage, float rightVoltage);
+        /**
+         * @brief Get the drivetrain's free speed
+         *
+         * @return float inches per second
+         */
+        float freeSpeed() const;
+        /**
+         * @brief Measure the velocity of both sides of the drivetrain
+         *
+         * While odometry reads from a SensorScheduler, both sides come from its latest frame, which is
+         * only copied again once the scheduler publishes a new one. Otherwise the motors are read directly
+         *
+         * @return std::pair<float, float> left and right wheel velocities, in inches per second
+         */
+        std::pair<float, float> wheelVelocities();
+        /**
+         * @brief Measure the velocity of one side of the drivetrain
+         *
+         * @param motors the side's motors
+         * @param frame frame to read the motors from, nullptr to read the motors themselves
+         * @return float wheel velocity, in inches per second
+         */
+        float wheelVelocity(const pros::MotorGroup& motors, const SensorFrame* frame) const;
+        /**
+         * @brief Measure how fast the robot is driving forwards, from the drive motors
+         *
+         * @return float inches per second
+         */
+        float lateralVelocity();
+        /**
+         * @brief Measure how fast the robot is turning, from the drive motors
+         *
+         * @return float degrees per second, positive clockwise
+         */
+        float angularVelocity();
+
+        std::optional<DriveFeedforward> driveFeedforward;
+        std::optional<DriveMpc> mpc;
+        /** millis() of the last MPC solve, to start cold after a gap */
+        std::uint32_t lastMpcSolve = 0;
+        /** last scheduler frame the drive velocities were read from, reused until there is a newer one */
+        SensorFrame velocityFrame;
+        std::uint32_t velocityVersion = 0;
+        std::pair<float, float> measuredVelocities = {0, 0};
+        std::optional<VoltageCompensation> voltageCompensation;
+
+        ProfileConstraints lateralProfile;
+        ProfileConstraints angularProfile;
+        float lateralProfileKA = 0;
+        float angularProfileKA = 0;
+
+        Ramsete ramsete;
+        TrajectoryConstraints ramseteConstraints;
+
         ControllerSettings lateralSettings;
         ControllerSettings angularSettings;
         Drivetrain drivetrain;
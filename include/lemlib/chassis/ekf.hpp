@@ -0,0 +1,173 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+#include "pros/distance.hpp"
+#include "pros/gps.hpp"
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+/**
+ * @brief A distance sensor used to correct odometry against the field walls
+ */
+struct EkfDistanceSensor {
+        /** the distance sensor */
+        pros::Distance* sensor;
+        /** position of the sensor relative to the tracking center, in inches, x to the right and y forwards.
+         * Theta is the direction the sensor faces in degrees, clockwise from forwards */
+        Pose offset;
+        /** how old a reading is by the time it is read, in milliseconds. 35 by default */
+        std::uint32_t latency = 35;
+};
+
+/**
+ * @brief Sensors the EKF fuses on top of the odometry sensors
+ *
+ * The odometry tracking wheels drive the prediction step, and the odometry IMU corrects heading
+ */
+struct EkfSensors {
+        /** GPS sensor, already configured with its offset from the tracking center. nullptr if unused */
+        pros::Gps* gps = nullptr;
+        /** how old a GPS reading is by the time it is read, in milliseconds. 20 by default */
+        std::uint32_t gpsLatency = 20;
+        /** distance sensors facing the field walls */
+        std::vector<EkfDistanceSensor> distanceSensors = {};
+};
+
+/**
+ * @brief Noise parameters of the EKF
+ *
+ * Standard deviations are in inches and radians
+ */
+struct EkfSettings {
+        /** translation noise of the wheels, per inch traveled. 0.02 by default */
+        float translationNoise = 0.02;
+        /** heading noise of odometry, per radian turned. 0.01 by default */
+        float rotationNoise = 0.01;
+        /** heading noise of odometry, per inch traveled. 0.001 by default */
+        float driftNoise = 0.001;
+        /** standard deviation of the IMU heading. 0.01 by default */
+        float imuNoise = 0.01;
+        /** smallest standard deviation of a GPS position, it reports its own error above this. 1 by default */
+        float gpsNoise = 1;
+        /** standard deviation of the GPS heading. 0.05 by default */
+        float gpsHeadingNoise = 0.05;
+        /** standard deviation of a distance reading, as a fraction of the distance. 0.05 by default */
+        float distanceNoise = 0.05;
+        /** smallest standard deviation of a distance reading. 0.6 by default */
+        float minDistanceNoise = 0.6;
+        /** measurements further than this many standard deviations from the estimate are rejected. 3 by default */
+        float gate = 3;
+};
+
+/**
+ * @brief Extended Kalman filter estimating the pose of the robot
+ *
+ * The state is x, y and heading in the same frame as odometry: inches, and radians clockwise
+ * from +y. Every measurement is applied as a scalar update, so nothing needs a matrix inverse.
+ * Delayed measurements are compared against the estimate from when they were taken, and the
+ * correction is applied to the current estimate and every estimate since, so the next delayed
+ * measurement sees it
+ */
+class Ekf {
+    public:
+        /**
+         * @brief Construct a new EKF at the origin
+         *
+         * @param settings noise parameters
+         */
+        Ekf(const EkfSettings& settings = {});
+        /**
+         * @brief Reset the estimate to a known pose
+         *
+         * @param pose the pose, theta in radians
+         * @param time when the robot was at the pose, in milliseconds
+         */
+        void setPose(Pose pose, std::uint32_t time);
+        /**
+         * @brief Get the current estimate
+         *
+         * @return Pose theta in radians
+         */
+        Pose getPose() const;
+        /**
+         * @brief Get the covariance of the current estimate
+         *
+         * @return std::array<float, 9> row major 3x3 covariance of x, y and theta
+         */
+        std::array<float, 9> getCovariance() const;
+        /**
+         * @brief Move the estimate by an odometry step
+         *
+         * @param localX distance moved to the right of the robot, in inches
+         * @param localY distance moved forwards, in inches
+         * @param deltaTheta change in heading, in radians
+         * @param time when the step ended, in milliseconds
+         */
+        void predict(float localX, float localY, float deltaTheta, std::uint32_t time);
+        /**
+         * @brief Correct the heading with an absolute measurement
+         *
+         * @param theta measured heading in radians
+         * @param noise standard deviation of the measurement, in radians
+         * @param time when the measurement was taken, in milliseconds
+         * @return true if the measurement was accepted
+         */
+        bool correctHeading(float theta, float noise, std::uint32_t time);
+        /**
+         * @brief Correct the position with an absolute measurement
+         *
+         * @param x measured x position, in inches
+         * @param y measured y position, in inches
+         * @param noise standard deviation of each axis, in inches
+         * @param time when the measurement was taken, in milliseconds
+         * @return true if the measurement was accepted
+         */
+        bool correctPosition(float x, float y, float noise, std::uint32_t time);
+        /**
+         * @brief Correct the pose with a distance sensor reading of the field walls
+         *
+         * @param offset position of the sensor relative to the tracking center, theta in radians
+         * @param distance measured distance, in inches
+         * @param time when the measurement was taken, in milliseconds
+         * @return true if the measurement was accepted
+         */
+        bool correctDistance(const Pose& offset, float distance, std::uint32_t time);
+    private:
+        struct Snapshot {
+                std::uint32_t time = 0;
+                Pose pose = Pose(0, 0, 0);
+        };
+
+        /**
+         * @brief Apply a scalar measurement
+         *
+         * @param innovation measured value minus predicted value
+         * @param jacobian derivative of the predicted value with respect to x, y and theta
+         * @param variance variance of the measurement
+         * @param age how many snapshots back the measurement is from, see snapshotAt. The correction
+         * is applied to that one and every newer one
+         * @return true if the innovation passed the gate
+         */
+        bool update(float innovation, const std::array<float, 3>& jacobian, float variance, std::size_t age);
+        /**
+         * @brief Find the estimate closest to a time, going no further back than the history
+         *
+         * @return std::size_t how many snapshots back from the newest one it is
+         */
+        std::size_t snapshotAt(std::uint32_t time) const;
+        /**
+         * @brief Get a snapshot by how many back from the newest one it is
+         */
+        const Snapshot& snapshot(std::size_t age) const;
+
+        EkfSettings settings;
+        Pose pose;
+        std::array<float, 9> covariance {};
+        // recent estimates, for measurements that arrive late
+        std::array<Snapshot, 16> history;
+        std::size_t historyHead = 0;
+        std::size_t historySize = 0;
+};
+} // namespace lemlib
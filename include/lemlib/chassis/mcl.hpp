@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstdint>
+#include <random>
+#include <span>
+#include <vector>
+#include "pros/distance.hpp"
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+/**
+ * @brief A distance sensor used to localize the robot against the field walls and goals
+ */
+struct MclDistanceSensor {
+        /** the distance sensor */
+        pros::Distance* sensor;
+        /** position of the sensor relative to the tracking center, in inches, x to the right and y forwards.
+         * Theta is the direction the sensor faces in degrees, clockwise from forwards */
+        Pose offset;
+};
+
+/**
+ * @brief Parameters of the particle filter
+ *
+ * Standard deviations are in inches and radians
+ */
+struct MclSettings {
+        /** number of particles. 500 by default */
+        std::size_t particles = 500;
+        /** translation noise of the wheels, per inch traveled. 0.03 by default */
+        float translationNoise = 0.03;
+        /** heading noise of odometry, per radian turned. 0.02 by default */
+        float rotationNoise = 0.02;
+        /** heading noise of odometry, per inch traveled. 0.002 by default */
+        float driftNoise = 0.002;
+        /** standard deviation of a distance reading, as a fraction of the distance. 0.05 by default */
+        float distanceNoise = 0.05;
+        /** smallest standard deviation of a distance reading. 0.8 by default */
+        float minDistanceNoise = 0.8;
+        /** chance a reading is something the map doesn't know about, like another robot. 0.05 by default */
+        float outlierChance = 0.05;
+        /** resample once the effective number of particles falls below this fraction. 0.5 by default */
+        float resampleThreshold = 0.5;
+        /** how far the robot has to move before the next correction, in inches. 0.5 by default */
+        float updateDistance = 0.5;
+        /** how far the robot has to turn before the next correction, in radians. 0.03 by default */
+        float updateAngle = 0.03;
+        /** spread of the particles around a pose passed to setPose, in inches. 1 by default */
+        float initialSpread = 1;
+        /** spread of the particle headings around a pose passed to setPose, in radians. 0.02 by default */
+        float initialHeadingSpread = 0.02;
+};
+
+/**
+ * @brief Monte Carlo localization against the field walls and goals
+ *
+ * The state is x, y and heading in the same frame as odometry: inches, and radians clockwise
+ * from +y. Odometry steps move every particle, and distance sensor readings weigh them by how
+ * well they match a ray cast against the field. Particles are stored as one array per field
+ * so the ray casting loops run over contiguous floats without branches, the layout the
+ * compiler needs to vectorize them. Nothing is allocated after construction
+ */
+class Mcl {
+    public:
+        /**
+         * @brief Construct a new particle filter, with every particle at the origin
+         *
+         * @param settings parameters of the filter
+         */
+        Mcl(const MclSettings& settings = {});
+        /**
+         * @brief Scatter the particles around a known pose
+         *
+         * @param pose the pose, theta in radians
+         */
+        void setPose(Pose pose);
+        /**
+         * @brief Get the weighted mean of the particles
+         *
+         * @return Pose theta in radians
+         */
+        Pose getPose() const;
+        /**
+         * @brief Get the effective number of particles, which falls as the weights concentrate
+         *
+         * @return float between 1 and the number of particles
+         */
+        float getEffectiveSize() const;
+        /**
+         * @brief Move every particle by a noisy copy of an odometry step
+         *
+         * @param localX distance moved to the right of the robot, in inches
+         * @param localY distance moved forwards, in inches
+         * @param deltaTheta change in heading, in radians
+         */
+        void predict(float localX, float localY, float deltaTheta);
+        /**
+         * @brief Weigh the particles by distance sensor readings, resampling if too few carry the weight
+         *
+         * Readings are only used once the robot has moved far enough since the last correction,
+         * since correcting a stationary robot over and over collapses the particles onto one pose
+         *
+         * @param offsets position of each sensor relative to the tracking center, theta in radians
+         * @param distances reading of each sensor in inches, NAN if it has no reading
+         * @return true if the readings were used
+         */
+        bool correct(std::span<const Pose> offsets, std::span<const float> distances);
+    private:
+        /**
+         * @brief Ray cast one sensor from every particle, into expected
+         */
+        void castRays(const Pose& offset);
+        /**
+         * @brief Draw a new set of particles in proportion to their weights
+         */
+        void resample();
+        /**
+         * @brief Recalculate the weighted mean of the particles
+         */
+        void updateEstimate();
+
+        MclSettings settings;
+        std::minstd_rand random;
+        std::normal_distribution<float> unit {0, 1};
+        Pose estimate;
+        float motionSinceCorrection = 0;
+        float turnSinceCorrection = 0;
+        // the particles
+        std::vector<float> x;
+        std::vector<float> y;
+        std::vector<float> theta;
+        std::vector<float> weight;
+        // per particle scratch space, reused by every correction
+        std::vector<float> sinTheta;
+        std::vector<float> cosTheta;
+        std::vector<float> rayX;
+        std::vector<float> rayY;
+        std::vector<float> rayDx;
+        std::vector<float> rayDy;
+        std::vector<float> expected;
+        std::vector<float> resampledX;
+        std::vector<float> resampledY;
+        std::vector<float> resampledTheta;
+};
+} // namespace lemlib
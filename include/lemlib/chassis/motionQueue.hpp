@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <vector>
+#include "lemlib/chassis/chassis.hpp"
+
+namespace lemlib {
+/**
+ * @brief How a MotionQueue blends one motion into the next
+ *
+ * Every motion but the last exits early and hands off to the next one while still moving, instead
+ * of slowing to a stop and waiting out its exit conditions. Motions given their own minSpeed keep
+ * it, and their own earlyExitRange
+ */
+struct BlendSettings {
+        /** speed carried from one motion into the next, 0 to 127 */
+        float minSpeed = 40;
+        /** distance from the target where moves hand off, in inches */
+        float lateralExitRange = 4;
+        /** angle from the target where turns and swings hand off, in degrees */
+        float angularExitRange = 10;
+};
+
+/**
+ * @brief A sequence of chassis motions that run back to back
+ *
+ * Each motion is still started with the usual requestMotionStart and ended with endMotion, so
+ * cancelMotion skips to the next motion in the queue, and motions started outside the queue wait
+ * their turn like any other. cancelAllMotions stops the whole queue. A routine can move its motions
+ * into queues one stretch at a time
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::MotionQueue queue(chassis);
+ * queue.moveToPoint(0, 24, 1000)
+ *     .turnToHeading(90, 750)
+ *     .moveToPoint(24, 24, 1000); // the last motion settles as usual
+ * queue.run();
+ * // do other things while the queue runs
+ * queue.waitUntilDone();
+ * @endcode
+ */
+class MotionQueue {
+    public:
+        /**
+         * @brief Construct a new, empty motion queue
+         *
+         * @param chassis the chassis to move
+         * @param settings how motions blend into each other
+         */
+        MotionQueue(Chassis& chassis, BlendSettings settings = {});
+        /**
+         * @brief Queue a Chassis::moveToPoint
+         *
+         * @return MotionQueue& this queue, to queue the next motion
+         */
+        MotionQueue& moveToPoint(float x, float y, int timeout, MoveToPointParams params = {});
+        /**
+         * @brief Queue a Chassis::moveToPose
+         *
+         * @return MotionQueue& this queue, to queue the next motion
+         */
+        MotionQueue& moveToPose(float x, float y, float theta, int timeout, MoveToPoseParams params = {});
+        /**
+         * @brief Queue a Chassis::turnToHeading
+         *
+         * @return MotionQueue& this queue, to queue the next motion
+         */
+        MotionQueue& turnToHeading(float theta, int timeout, TurnToHeadingParams params = {});
+        /**
+         * @brief Queue a Chassis::turnToPoint
+         *
+         * @return MotionQueue& this queue, to queue the next motion
+         */
+        MotionQueue& turnToPoint(float x, float y, int timeout, TurnToPointParams params = {});
+        /**
+         * @brief Queue a Chassis::swingToHeading
+         *
+         * @return MotionQueue& this queue, to queue the next motion
+         */
+        MotionQueue& swingToHeading(float theta, DriveSide lockedSide, int timeout, SwingToHeadingParams params = {});
+        /**
+         * @brief Queue a Chassis::swingToPoint
+         *
+         * @return MotionQueue& this queue, to queue the next motion
+         */
+        MotionQueue& swingToPoint(float x, float y, DriveSide lockedSide, int timeout, SwingToPointParams params = {});
+        /**
+         * @brief Run the queued motions in order
+         *
+         * The motions stay queued, so the same queue can be run again
+         *
+         * @param async whether the function should be run asynchronously. true by default. The queue
+         * has to outlive an asynchronous run
+         */
+        void run(bool async = true);
+        /**
+         * @brief Wait until an asynchronous run has finished
+         */
+        void waitUntilDone() const;
+        /**
+         * @brief Remove every queued motion
+         */
+        void clear();
+    private:
+        Chassis& chassis;
+        BlendSettings settings;
+        /** each motion takes whether another motion follows it */
+        std::vector<std::function<void(bool)>> motions;
+        /** read by waitUntilDone from another task */
+        std::atomic<bool> running = false;
+};
+} // namespace lemlib
@@ -1,7 +1,11 @@
 #pragma once
 
 #include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/ekf.hpp"
+#include "lemlib/chassis/mcl.hpp"
+#include "lemlib/chassis/poseHistory.hpp"
 #include "lemlib/pose.hpp"
+#include "lemlib/sensors.hpp"
 
 namespace lemlib {
 /**
@@ -11,6 +15,22 @@ namespace lemlib {
  * @param drivetrain drivetrain to be used
  */
 void setSensors(lemlib::OdomSensors sensors, lemlib::Drivetrain drivetrain);
+/**
+ * @brief Read the odometry sensors from a SensorScheduler instead of the devices
+ *
+ * While the scheduler's task is running, every update reads the tracking wheels, the IMU and the
+ * distance sensors of the EKF or particle filter from the scheduler's latest frame. Devices the
+ * scheduler doesn't read are still read directly
+ *
+ * @param scheduler the scheduler, nullptr to go back to reading the devices
+ */
+void setSensorScheduler(const SensorScheduler* scheduler);
+/**
+ * @brief Get the SensorScheduler odometry is reading from
+ *
+ * @return const SensorScheduler* the scheduler, nullptr if odometry reads the devices
+ */
+const SensorScheduler* getSensorScheduler();
 /**
  * @brief Get the pose of the robot
  *
@@ -18,6 +38,17 @@ void setSensors(lemlib::OdomSensors sensors, lemlib::Drivetrain drivetrain);
  * @return Pose
  */
 Pose getPose(bool radians = false);
+/**
+ * @brief Get the pose of the robot, and the time the sensors behind it were sampled
+ *
+ * The pose is only as new as the encoder sample it was integrated from, which can be several
+ * milliseconds older than the time it is read
+ *
+ * @param radians true for theta in radians, false for degrees
+ * @param timestamp set to the sample time of the pose, in milliseconds
+ * @return Pose
+ */
+Pose getPose(bool radians, std::uint32_t* timestamp);
 /**
  * @brief Set the Pose of the robot
  *
@@ -25,6 +56,44 @@ Pose getPose(bool radians = false);
  * @param radians true if theta is in radians, false if in degrees. False by default
  */
 void setPose(Pose pose, bool radians = false);
+/**
+ * @brief Get where the robot was at a past time
+ *
+ * Odometry keeps the last PoseHistory::CAPACITY updates, 1.28 seconds. Times between two updates
+ * are interpolated along the arc the robot drove. Useful for comparing a sensor reading that
+ * arrives late with where the robot was when it was taken
+ *
+ * @param time time in milliseconds, from pros::millis()
+ * @param radians true for theta in radians, false for degrees. False by default
+ * @return std::optional<Pose> the pose, std::nullopt if the time is older than the history or
+ * newer than the last update
+ *
+ * @b Example
+ * @code {.cpp}
+ * // where was the robot 40 ms ago
+ * std::optional<lemlib::Pose> pose = lemlib::getPoseAt(pros::millis() - 40);
+ * @endcode
+ */
+std::optional<Pose> getPoseAt(std::uint32_t time, bool radians = false);
+/**
+ * @brief Correct where the robot was at a past time, keeping the motion odometry measured since
+ *
+ * The current pose, and the history after the time, move as if odometry had been integrating
+ * from the corrected pose all along. If the EKF or the particle filter are enabled, they restart
+ * from the corrected pose
+ *
+ * @param pose where the robot was
+ * @param time when the robot was there, in milliseconds from pros::millis()
+ * @param radians true if theta is in radians, false if in degrees. False by default
+ * @return true if the time was in the history and the pose was corrected
+ *
+ * @b Example
+ * @code {.cpp}
+ * // a camera saw the robot at (24, 48) facing 90 degrees, 50 ms ago
+ * lemlib::correctPose(lemlib::Pose(24, 48, 90), pros::millis() - 50);
+ * @endcode
+ */
+bool correctPose(Pose pose, std::uint32_t time, bool radians = false);
 /**
  * @brief Get the speed of the robot
  *
@@ -47,14 +116,78 @@ Pose getLocalSpeed(bool radians = false);
  * @return lemlib::Pose
  */
 Pose estimatePose(float time, bool radians = false);
+/**
+ * @brief Move a pose along the arc the robot drove during one odometry update
+ *
+ * The heading is taken to change at a constant rate through the update, so the tracking center
+ * moves along a circular arc and the displacement is the chord of that arc. This is exact for
+ * any constant speed and curvature, not just straight lines, and costs one sine and cosine
+ *
+ * @param pose pose at the start of the update, theta in radians
+ * @param arcX distance the tracking center moved sideways, along the arc, in inches. Same sign
+ * as a horizontal tracking wheel
+ * @param arcY distance the tracking center moved forwards, along the arc, in inches
+ * @param deltaHeading change in heading, in radians
+ * @param chord set to the chord in the frame of the heading halfway through the update, which
+ * is what the EKF and particle filter predict from. Ignored if nullptr
+ * @return Pose the pose at the end of the update
+ */
+Pose integrateArc(const Pose& pose, float arcX, float arcY, float deltaHeading, Pose* chord = nullptr);
+/**
+ * @brief Fuse odometry with more sensors using an extended Kalman filter
+ *
+ * Once enabled, the tracking wheels drive the filter's prediction and the IMU, GPS and distance
+ * sensors correct it. The predicted heading, and the arc the translation is built from, come from
+ * the wheels too, the drive encoders if there are no tracking wheels, so the IMU isn't counted
+ * twice. getPose and setPose keep working as before, but return and reset the filtered pose. GPS
+ * and distance sensors measure in field coordinates, so the pose should be set in field
+ * coordinates too: inches from the center of the field
+ *
+ * @param sensors sensors to fuse on top of the odometry sensors
+ * @param settings noise parameters of the filter
+ */
+void enableEkf(const EkfSensors& sensors, const EkfSettings& settings = {});
+/**
+ * @brief Go back to plain odometry, starting from the last filtered pose
+ */
+void disableEkf();
+/**
+ * @brief Localize against the field walls and goals with a particle filter
+ *
+ * Once enabled, every odometry step moves the particles and the distance sensors weigh them.
+ * The filter replaces the EKF if that was enabled. getPose and setPose keep working as before,
+ * so Chassis motions track their targets in the corrected frame. The map is in field
+ * coordinates, so the pose should be set in field coordinates too: inches from the center of
+ * the field
+ *
+ * @param sensors distance sensors facing the field walls and goals
+ * @param settings parameters of the filter
+ *
+ * @b Example
+ * @code {.cpp}
+ * pros::Distance left(4);
+ * pros::Distance back(5);
+ * // left sensor 6 inches left of the tracking center facing left, back sensor 7 inches behind facing back
+ * lemlib::enableMcl({{&left, lemlib::Pose(-6, 0, -90)}, {&back, lemlib::Pose(0, -7, 180)}});
+ * chassis.setPose(-48, -60, 0);
+ * @endcode
+ */
+void enableMcl(const std::vector<MclDistanceSensor>& sensors, const MclSettings& settings = {});
+/**
+ * @brief Go back to plain odometry, starting from the last localized pose
+ */
+void disableMcl();
 /**
  * @brief Update the pose of the robot
  *
+ * Speeds are calculated from the time between encoder samples rather than the loop period,
+ * and nothing is integrated when the sensors haven't produced a new sample
  */
 void update();
 /**
  * @brief Initialize the odometry system
  *
+ * Starts a high priority task that calls update() at a fixed rate
  */
 void init();
 } // namespace lemlib
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+/**
+ * @brief A fixed size record of recent poses, for asking where the robot was at a past time
+ *
+ * Poses are in the odometry frame: inches, and radians clockwise from +y. Recording never
+ * allocates, and once full the oldest pose is overwritten. Lookups binary search the timestamps
+ * and interpolate along the arc between the two poses around the time, the way the robot drives
+ * between odometry updates
+ */
+class PoseHistory {
+    public:
+        /** number of poses kept, 1.28 seconds of 10 ms odometry updates */
+        static constexpr std::size_t CAPACITY = 128;
+
+        /**
+         * @brief Record a pose
+         *
+         * @param time when the robot was at the pose, in milliseconds. A time no later than the
+         * newest pose replaces it
+         * @param pose the pose, theta in radians
+         */
+        void record(std::uint32_t time, const Pose& pose);
+        /**
+         * @brief Forget every pose
+         */
+        void clear();
+        /**
+         * @brief Get the number of poses recorded
+         */
+        std::size_t size() const;
+        /**
+         * @brief Get the time of the oldest pose
+         *
+         * @return std::optional<std::uint32_t> time in milliseconds, std::nullopt if empty
+         */
+        std::optional<std::uint32_t> oldest() const;
+        /**
+         * @brief Get the time of the newest pose
+         *
+         * @return std::optional<std::uint32_t> time in milliseconds, std::nullopt if empty
+         */
+        std::optional<std::uint32_t> newest() const;
+        /**
+         * @brief Get where the robot was at a time
+         *
+         * @param time time in milliseconds
+         * @return std::optional<Pose> the pose, theta in radians. std::nullopt if the time is
+         * before the oldest pose or after the newest one
+         *
+         * @b Example
+         * @code {.cpp}
+         * lemlib::PoseHistory history;
+         * history.record(100, lemlib::Pose(0, 0, 0));
+         * history.record(110, lemlib::Pose(0, 10, 0));
+         * history.at(105); // lemlib::Pose(0, 5, 0)
+         * history.at(90); // std::nullopt
+         * @endcode
+         */
+        std::optional<Pose> at(std::uint32_t time) const;
+        /**
+         * @brief Move the history so the robot was at a pose at a time, keeping the motion since
+         *
+         * Every pose after the time keeps where it is relative to the pose at the time, as if
+         * odometry had been integrating from the corrected pose all along
+         *
+         * @param time when the robot was at the pose, in milliseconds
+         * @param pose where the robot actually was, theta in radians
+         * @return std::optional<Pose> the corrected newest pose, std::nullopt if the time is
+         * outside the history and nothing was changed
+         */
+        std::optional<Pose> correct(std::uint32_t time, const Pose& pose);
+    private:
+        struct Entry {
+                std::uint32_t time = 0;
+                Pose pose = Pose(0, 0, 0);
+        };
+
+        /**
+         * @brief Get an entry by age, 0 being the oldest
+         */
+        const Entry& get(std::size_t index) const;
+        Entry& get(std::size_t index);
+        /**
+         * @brief Find the first entry at or after a time
+         *
+         * @return std::size_t its index by age, or size() if every entry is older
+         */
+        std::size_t lowerBound(std::uint32_t time) const;
+
+        std::array<Entry, CAPACITY> entries;
+        std::size_t head = 0; // physical index of the oldest entry
+        std::size_t count = 0;
+};
+
+/**
+ * @brief Get the motion from one pose to another, in the frame of the first
+ *
+ * @param from the starting pose, theta in radians
+ * @param to the ending pose, theta in radians
+ * @return Pose x to the right and y forwards of the starting pose, theta the change in heading
+ */
+Pose relativePose(const Pose& from, const Pose& to);
+/**
+ * @brief Apply a motion in the frame of a pose, the inverse of relativePose
+ *
+ * @param from the starting pose, theta in radians
+ * @param motion x to the right and y forwards of the starting pose, theta the change in heading
+ * @return Pose the ending pose
+ */
+Pose composePose(const Pose& from, const Pose& motion);
+/**
+ * @brief Interpolate between two poses along a constant curvature arc
+ *
+ * Interpolating x, y and theta separately cuts corners when the robot is turning, while an arc
+ * matches how the robot moves between two nearby samples
+ *
+ * @param from the pose at t = 0, theta in radians
+ * @param to the pose at t = 1, theta in radians
+ * @param t how far along the arc, from 0 to 1
+ * @return Pose the interpolated pose
+ */
+Pose interpolatePose(const Pose& from, const Pose& to, float t);
+} // namespace lemlib
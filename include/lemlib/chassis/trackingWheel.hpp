@@ -4,6 +4,7 @@
 #include "pros/motor_group.hpp"
 #include "pros/adi.hpp"
 #include "pros/rotation.hpp"
+#include "lemlib/sensors.hpp"
 
 namespace lemlib {
 
@@ -151,6 +152,37 @@ class TrackingWheel {
          * }
          */
         float getDistanceTraveled();
+        /**
+         * @brief Get the distance traveled by the tracking wheel, and when it was measured
+         *
+         * Motor groups are read with get_raw_position_all, so the timestamp is when the motors
+         * sampled their encoders. Other sensors don't report a sample time, so they are stamped
+         * with the time they were read
+         *
+         * @param timestamp set to the time the distance was measured, in milliseconds
+         * @return float distance traveled in inches
+         *
+         * @b Example
+         * @code {.cpp}
+         * void initialize() {
+         *     std::uint32_t timestamp;
+         *     const float distance = exampleTrackingWheel.getDistanceTraveled(&timestamp);
+         *     std::cout << "distance: " << distance << " at " << timestamp << " ms" << std::endl;
+         * }
+         * @endcode
+         */
+        float getDistanceTraveled(std::uint32_t* timestamp);
+        /**
+         * @brief Get the distance traveled by the tracking wheel from a SensorScheduler frame
+         *
+         * Motors and rotation sensors the frame doesn't have a sample of, and ADI encoders, are
+         * read directly like getDistanceTraveled(timestamp)
+         *
+         * @param frame the frame to read from
+         * @param timestamp set to the time the distance was measured, in milliseconds
+         * @return float distance traveled in inches
+         */
+        float getDistanceTraveled(const SensorFrame& frame, std::uint32_t* timestamp);
         /**
          * @brief Get the offset of the tracking wheel from the center of rotation
          *
@@ -185,6 +217,14 @@ class TrackingWheel {
          */
         int getType();
     private:
+        /**
+         * @brief Get the distance traveled by the motors since they were powered on
+         *
+         * @param timestamp set to the time the motors sampled their encoders
+         * @return float distance in inches
+         */
+        float getRawMotorDistance(std::uint32_t* timestamp);
+
         float diameter;
         float distance;
         float rpm;
@@ -192,5 +232,6 @@ class TrackingWheel {
         pros::Rotation* rotation = nullptr;
         pros::MotorGroup* motors = nullptr;
         float gearRatio = 1;
+        float rawMotorOffset = 0; // raw motor distance at the last reset
 };
 } // namespace lemlib
\ No newline at end of file
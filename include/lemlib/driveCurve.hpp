@@ -1,3 +1,8 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
 namespace lemlib {
 
 /**
@@ -72,4 +77,171 @@ class ExpoDriveCurve : public DriveCurve {
         const float minOutput = 0;
         const float curveGain = 1;
 };
-} // namespace lemlib
\ No newline at end of file
+
+/**
+ * Double precision exp and log that can run at compile time, for baking curves into tables.
+ *
+ * Both reduce the argument by powers of two and sum a short series, which is within a few ulp of
+ * libm in double precision, so rounding the result to float gives the same float as libm's powf
+ * for all but the rarest inputs. They are slow, they are meant for constant evaluation only.
+ */
+namespace curveMath {
+constexpr double LN_2 = 0.693147180559945309417;
+
+/**
+ * @brief Natural log of x, for x > 0
+ */
+constexpr double log(double x) {
+    // x = m * 2^k with m in [sqrt(1/2), sqrt(2))
+    int k = 0;
+    while (x >= 1.41421356237309504880) {
+        x /= 2;
+        k++;
+    }
+    while (x < 0.70710678118654752440) {
+        x *= 2;
+        k--;
+    }
+    // log(m) = 2 * atanh(s), with s = (m - 1) / (m + 1) and |s| < 0.172
+    const double s = (x - 1) / (x + 1);
+    const double s2 = s * s;
+    double term = s;
+    double sum = 0;
+    for (int n = 1; n < 40; n += 2) {
+        sum += term / n;
+        term *= s2;
+    }
+    return 2 * sum + k * LN_2;
+}
+
+/**
+ * @brief e to the power of x
+ */
+constexpr double exp(double x) {
+    // x = k * log(2) + r with |r| <= log(2) / 2
+    const int k = int(x / LN_2 + (x < 0 ? -0.5 : 0.5));
+    const double r = x - k * LN_2;
+    double term = 1;
+    double sum = 1;
+    for (int n = 1; n < 24; n++) {
+        term *= r / n;
+        sum += term;
+    }
+    for (int i = 0; i < k; i++) sum *= 2;
+    for (int i = 0; i > k; i--) sum /= 2;
+    return sum;
+}
+
+/**
+ * @brief base to the power of exponent in float, like std::pow on floats, for base > 0
+ */
+constexpr float pow(float base, float exponent) { return exp(double(exponent) * log(double(base))); }
+} // namespace curveMath
+
+/**
+ * @brief Output of ExpoDriveCurve for an input, computed the same way but at compile time
+ *
+ * @param input the input to curve
+ * @param deadband range where input is considered to be input
+ * @param minOutput the minimum output that can be returned
+ * @param curve how "curved" the graph is
+ * @return float the curved output
+ */
+constexpr float expoCurve(float input, float deadband, float minOutput, float curve) {
+    const float magnitude = input < 0 ? -input : input;
+    const double sign = input < 0 ? -1 : 1;
+    if (magnitude <= deadband) return 0;
+    // the same steps, in the same precision, as ExpoDriveCurve::curve
+    const float g = magnitude - deadband;
+    const float g127 = 127 - deadband;
+    const float i = curveMath::pow(curve, g - 127) * g * sign;
+    const float i127 = curveMath::pow(curve, g127 - 127) * g127;
+    return (127.0 - minOutput) / (127) * i * 127 / i127 + minOutput * sign;
+}
+
+/**
+ * @brief Table of a curve's output for every joystick value, indexed by the value plus 128
+ */
+using CurveTable = std::array<float, 256>;
+
+/**
+ * @brief Bake a curve into a table
+ *
+ * Runs at compile time when the curve can, so the table costs nothing at runtime
+ *
+ * @param curve anything callable with a float input that returns the float output
+ * @return CurveTable the output for every input from -128 to 127
+ *
+ * @b Example
+ * @code {.cpp}
+ * // a cubic curve, built at compile time
+ * constexpr lemlib::CurveTable cubic =
+ *     lemlib::makeCurveTable([](float input) { return input * input * input / (127 * 127); });
+ * @endcode
+ */
+template <typename F> constexpr CurveTable makeCurveTable(F curve) {
+    CurveTable table {};
+    for (int i = 0; i < 256; i++) table[i] = curve(float(i - 128));
+    return table;
+}
+
+/**
+ * @brief Bake the curve of an ExpoDriveCurve into a table
+ *
+ * @param deadband range where input is considered to be input
+ * @param minOutput the minimum output that can be returned
+ * @param curve how "curved" the graph is
+ * @return CurveTable the output for every input from -128 to 127
+ */
+constexpr CurveTable expoCurveTable(float deadband, float minOutput, float curve) {
+    return makeCurveTable([=](float input) { return expoCurve(input, deadband, minOutput, curve); });
+}
+
+/**
+ * @brief LookupDriveCurve class. Inherits from the DriveCurve class. Reads the output from a table
+ *
+ * The controller's joysticks only report whole numbers from -127 to 127, so a curve only has 255
+ * outputs that matter. Looking them up is a few instructions, where ExpoDriveCurve computes two
+ * powers every call. Inputs are rounded to the nearest whole number
+ */
+class LookupDriveCurve : public DriveCurve {
+    public:
+        /**
+         * @brief Construct a new Lookup Drive Curve object from a table
+         *
+         * @param table output for every input, from makeCurveTable() or expoCurveTable()
+         *
+         * @b Example
+         * @code {.cpp}
+         * // the same curve as lemlib::ExpoDriveCurve(5, 12, 1.132), built at compile time
+         * constinit lemlib::LookupDriveCurve driveCurve(lemlib::expoCurveTable(5, 12, 1.132));
+         * @endcode
+         */
+        constexpr LookupDriveCurve(const CurveTable& table)
+            : table(table) {}
+
+        /**
+         * @brief Construct a new Lookup Drive Curve object by sampling another curve
+         *
+         * For curves that are only known at runtime, e.g. tuned from the controller
+         *
+         * @param curve the curve to sample at every input
+         *
+         * @b Example
+         * @code {.cpp}
+         * lemlib::ExpoDriveCurve expo(deadband, minOutput, gain);
+         * lemlib::LookupDriveCurve driveCurve(expo);
+         * @endcode
+         */
+        explicit LookupDriveCurve(DriveCurve& curve);
+        /**
+         * @brief curve an input
+         *
+         * @param input the input to curve, rounded to the nearest whole number
+         * @return float the curved output
+         */
+        float curve(float input) override;
+    private:
+        CurveTable table;
+};
+} // namespace lemlib
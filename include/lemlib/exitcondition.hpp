@@ -8,14 +8,18 @@ class ExitCondition {
          *
          * @param range the range where the countdown is allowed to start
          * @param time how much time to wait while in range before exiting
+         * @param settleVelocity how slowly the input has to be changing, per second, to count as settled
+         * without waiting out the time. 0 by default, which disables it
          *
          * @b Example
          * @code {.cpp}
          * // create a new exit condition that will exit if the input is within 0.1 of the target for 1000ms
          * ExitCondition ec(0.1, 1000);
+         * // or as soon as it is within 0.1 and changing by less than 0.5 per second
+         * ExitCondition settling(0.1, 1000, 0.5);
          * @endcode
          */
-        ExitCondition(const float range, const int time);
+        ExitCondition(const float range, const int time, const float settleVelocity = 0);
         /**
          * @brief whether the exit condition has been met
          *
@@ -49,6 +53,40 @@ class ExitCondition {
          * @endcode
          */
         bool update(const float input);
+        /**
+         * @brief update the exit condition, with a measured velocity
+         *
+         * With a settleVelocity, the exit condition is also met once the input is in range and
+         * both the measured velocity and the rate of change of the input have stayed under
+         * settleVelocity for SETTLE_TIME. A robot that has already stopped inside the range exits
+         * right away instead of waiting out the time
+         *
+         * @param input the input for the exit condition
+         * @param velocity measured velocity of what the input measures, per second
+         * @return true exit condition met
+         * @return false exit condition not met
+         *
+         * @b Example
+         * @code {.cpp}
+         * // exit once the error is small and the wheels have stopped
+         * ec.update(error, wheelVelocity);
+         * @endcode
+         */
+        bool update(const float input, const float velocity);
+        /**
+         * @brief predict the input some time from now, from how fast it has been changing
+         *
+         * @param input the input now
+         * @param time how far ahead to predict, in milliseconds
+         * @return float the predicted input
+         *
+         * @b Example
+         * @code {.cpp}
+         * // exit a chained turn a tick early if it would overshoot before the next one
+         * if (sgn(ec.predict(error, 10)) != sgn(error)) break;
+         * @endcode
+         */
+        float predict(const float input, const int time) const;
         /**
          * @brief reset the exit condition timer
          *
@@ -59,10 +97,19 @@ class ExitCondition {
          * @endcode
          */
         void reset();
+        /** how long the input has to stay settled before exiting, in milliseconds */
+        static constexpr int SETTLE_TIME = 20;
     protected:
         const float range;
         const int time;
+        const float settleVelocity;
         int startTime = -1;
+        int settleStartTime = -1;
         bool done = false;
+        /** last input and when it was given, to find its rate of change */
+        float lastInput = 0;
+        int lastTime = -1;
+        /** rate of change of the input, per second */
+        float rate = 0;
 };
 } // namespace lemlib
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <optional>
+#include <span>
+
+namespace lemlib {
+/**
+ * @brief Model of the voltage a drivetrain side needs to hold a velocity and acceleration
+ *
+ * voltage = kS * sign(velocity) + kV * velocity + kA * acceleration
+ *
+ * kS overcomes static friction, kV the back EMF of the motors, and kA the inertia of the robot.
+ * Velocities are in inches per second and voltages in volts. Find the gains with
+ * Chassis::characterize, or fitFeedforward on logged data
+ */
+class Feedforward {
+    public:
+        /**
+         * @brief Feedforward constructor
+         *
+         * @param kS volts to overcome static friction
+         * @param kV volts per in/s
+         * @param kA volts per in/s^2
+         *
+         * @b Example
+         * @code {.cpp}
+         * lemlib::Feedforward feedforward(0.8, // kS
+         *                                 0.15, // kV
+         *                                 0.02 // kA
+         * );
+         * @endcode
+         */
+        Feedforward(float kS = 0, float kV = 0, float kA = 0);
+        /**
+         * @brief Calculate the voltage for a velocity and acceleration
+         *
+         * @param velocity in inches per second
+         * @param acceleration in inches per second squared, 0 by default
+         * @return float volts
+         */
+        float calculate(float velocity, float acceleration = 0) const;
+
+        float kS;
+        float kV;
+        float kA;
+};
+
+/**
+ * @brief Feedforward gains for each side of a drivetrain
+ */
+struct DriveFeedforward {
+        Feedforward left;
+        Feedforward right;
+};
+
+/**
+ * @brief One logged point of a characterization run
+ */
+struct CharacterizationSample {
+        /** seconds since the start of the run */
+        float time = 0;
+        /** applied voltage, in volts */
+        float voltage = 0;
+        /** measured velocity, in inches per second */
+        float velocity = 0;
+        /** measured acceleration, in inches per second squared */
+        float acceleration = 0;
+};
+
+/**
+ * @brief Fit feedforward gains to logged samples by least squares
+ *
+ * Samples slower than minVelocity are left out, since static friction doesn't follow the model
+ * when the wheels aren't turning. Quasistatic samples pin down kS and kV, and dynamic samples kA,
+ * so a run should include both
+ *
+ * @param samples logged samples, with acceleration filled in
+ * @param minVelocity slowest sample to use, in inches per second. 0.5 by default
+ * @return std::optional<Feedforward> the gains, or nothing if the samples don't determine them
+ */
+std::optional<Feedforward> fitFeedforward(std::span<const CharacterizationSample> samples, float minVelocity = 0.5);
+} // namespace lemlib
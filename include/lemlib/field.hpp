@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <span>
+
+namespace lemlib {
+/**
+ * @brief A straight wall segment on the field, in inches
+ */
+struct Segment {
+        float x1;
+        float y1;
+        float x2;
+        float y2;
+};
+
+/**
+ * @brief Half the width of the inside of the field perimeter, in inches
+ *
+ * Field coordinates put the origin at the center of the field, the same frame the GPS sensor uses
+ */
+constexpr float FIELD_HALF_WIDTH = 70.2;
+
+/**
+ * @brief The inside faces of the field perimeter
+ */
+constexpr std::array<Segment, 4> FIELD_PERIMETER = {{
+    {-FIELD_HALF_WIDTH, -FIELD_HALF_WIDTH, FIELD_HALF_WIDTH, -FIELD_HALF_WIDTH},
+    {FIELD_HALF_WIDTH, -FIELD_HALF_WIDTH, FIELD_HALF_WIDTH, FIELD_HALF_WIDTH},
+    {FIELD_HALF_WIDTH, FIELD_HALF_WIDTH, -FIELD_HALF_WIDTH, FIELD_HALF_WIDTH},
+    {-FIELD_HALF_WIDTH, FIELD_HALF_WIDTH, -FIELD_HALF_WIDTH, -FIELD_HALF_WIDTH},
+}};
+
+/**
+ * @brief The faces of the two long goals, as a distance sensor sees them
+ *
+ * The long goals run between the alliance walls, 47 inches either side of the center of the
+ * field. Each is modeled as a 48.8 by 4 inch box at sensor height
+ */
+constexpr std::array<Segment, 8> FIELD_LONG_GOALS = {{
+    {-24.4, 45, 24.4, 45},
+    {24.4, 45, 24.4, 49},
+    {24.4, 49, -24.4, 49},
+    {-24.4, 49, -24.4, 45},
+    {-24.4, -49, 24.4, -49},
+    {24.4, -49, 24.4, -45},
+    {24.4, -45, -24.4, -45},
+    {-24.4, -45, -24.4, -49},
+}};
+
+/**
+ * @brief The center goals, as a distance sensor sees them
+ *
+ * The upper and lower center goals cross in an X at the center of the field. A sensor at any
+ * height sees one of them, so each is a single 22.6 inch segment along a diagonal
+ */
+constexpr std::array<Segment, 2> FIELD_CENTER_GOALS = {{
+    {-8, -8, 8, 8},
+    {-8, 8, 8, -8},
+}};
+
+/**
+ * @brief Every static wall on the field: the perimeter, long goals and center goals
+ */
+constexpr auto FIELD_WALLS = [] {
+    std::array<Segment, FIELD_PERIMETER.size() + FIELD_LONG_GOALS.size() + FIELD_CENTER_GOALS.size()> walls {};
+    std::size_t i = 0;
+    for (const Segment& segment : FIELD_PERIMETER) walls[i++] = segment;
+    for (const Segment& segment : FIELD_LONG_GOALS) walls[i++] = segment;
+    for (const Segment& segment : FIELD_CENTER_GOALS) walls[i++] = segment;
+    return walls;
+}();
+
+/**
+ * @brief Find how far a ray travels before it hits a wall
+ *
+ * @param x x position the ray starts at, in inches
+ * @param y y position the ray starts at, in inches
+ * @param theta direction of the ray in radians, clockwise from +y like the robot's heading
+ * @param segments the walls the ray can hit
+ * @param maxRange distance returned if the ray hits nothing, in inches
+ * @return float distance to the closest wall along the ray, in inches
+ *
+ * @b Example
+ * @code {.cpp}
+ * // a ray from the center of the field pointing at the +x wall
+ * lemlib::rayCast(0, 0, M_PI_2, lemlib::FIELD_PERIMETER, 200); // returns 70.2
+ * // a ray pointing at the center of the field stops at the center goals
+ * lemlib::rayCast(0, -30, 0, lemlib::FIELD_WALLS, 200); // returns 30
+ * @endcode
+ */
+float rayCast(float x, float y, float theta, std::span<const Segment> segments, float maxRange);
+} // namespace lemlib
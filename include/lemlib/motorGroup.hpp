@@ -0,0 +1,72 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include "pros/motor_group.hpp"
+
+namespace lemlib {
+/**
+ * @brief Largest motor group the fixed size buffers below can hold
+ */
+constexpr std::size_t MAX_MOTOR_GROUP_SIZE = 8;
+
+/**
+ * @brief Fixed size buffer with room for one value per motor in a motor group
+ *
+ * Meant to live on the stack of a control loop, so reading a motor group doesn't touch the heap
+ */
+template <typename T> using MotorGroupBuffer = std::array<T, MAX_MOTOR_GROUP_SIZE>;
+
+/**
+ * @brief Get the position of every motor in a motor group, without allocating
+ *
+ * pros::MotorGroup::get_position_all returns a new std::vector every call. This reads the same
+ * values one motor at a time into a buffer owned by the caller
+ *
+ * @param motors the motor group to read
+ * @param buffer where to write the positions. Motors past the end of the buffer are not read
+ * @return std::span<double> the part of the buffer that was written, one value per motor
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::MotorGroupBuffer<double> buffer;
+ * for (double position : lemlib::getPositions(leftMotors, buffer)) std::cout << position << std::endl;
+ * @endcode
+ */
+std::span<double> getPositions(const pros::MotorGroup& motors, std::span<double> buffer);
+/**
+ * @brief Get the raw encoder count of every motor in a motor group, without allocating
+ *
+ * @param motors the motor group to read
+ * @param buffer where to write the encoder counts. Motors past the end of the buffer are not read
+ * @param timestamp set to the oldest time any of the motors sampled its encoder, in milliseconds
+ * @return std::span<std::int32_t> the part of the buffer that was written, one value per motor
+ */
+std::span<std::int32_t> getRawPositions(const pros::MotorGroup& motors, std::span<std::int32_t> buffer,
+                                        std::uint32_t* timestamp);
+/**
+ * @brief Get the cartridge of every motor in a motor group, without allocating
+ *
+ * @param motors the motor group to read
+ * @param buffer where to write the cartridges. Motors past the end of the buffer are not read
+ * @return std::span<pros::MotorGears> the part of the buffer that was written, one value per motor
+ */
+std::span<pros::MotorGears> getGearings(const pros::MotorGroup& motors, std::span<pros::MotorGears> buffer);
+/**
+ * @brief Get the velocity of every motor in a motor group, without allocating
+ *
+ * @param motors the motor group to read
+ * @param buffer where to write the velocities, in rpm. Motors past the end of the buffer are not read
+ * @return std::span<double> the part of the buffer that was written, one value per motor
+ */
+std::span<double> getVelocities(const pros::MotorGroup& motors, std::span<double> buffer);
+/**
+ * @brief Get the voltage of every motor in a motor group, without allocating
+ *
+ * @param motors the motor group to read
+ * @param buffer where to write the voltages, in mV. Motors past the end of the buffer are not read
+ * @return std::span<std::int32_t> the part of the buffer that was written, one value per motor
+ */
+std::span<std::int32_t> getVoltages(const pros::MotorGroup& motors, std::span<std::int32_t> buffer);
+} // namespace lemlib
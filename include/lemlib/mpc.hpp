@@ -0,0 +1,127 @@
+#pragma once
+
+#include <array>
+#include <span>
+#include "lemlib/feedforward.hpp"
+
+namespace lemlib {
+/**
+ * @brief Weights and limits of a DriveMpc
+ */
+struct MpcSettings {
+        /** cost of each in/s of wheel velocity error, squared. 1 by default */
+        float velocityWeight = 1;
+        /** cost of each volt of change from one command to the next, squared. 0.05 by default */
+        float smoothingWeight = 0.05;
+        /** highest voltage either side can be given, in volts. 12 by default */
+        float maxVoltage = 12;
+        /** maximum acceleration of either wheel, in inches per second squared. 0 for no limit */
+        float maxAcceleration = 0;
+        /** maximum angular acceleration of the robot, in radians per second squared. 0 for no limit */
+        float maxAngularAcceleration = 0;
+        /** distance between the left and right wheels, in inches. 12 by default */
+        float trackWidth = 12;
+        /** most solver iterations per solve. 40 by default */
+        int maxIterations = 40;
+        /** residual the solver stops at, in volts. 0.01 by default */
+        float tolerance = 0.01;
+};
+
+/**
+ * @brief The first command of a DriveMpc solution
+ */
+struct MpcSolution {
+        /** voltage to apply to the left side now */
+        float leftVoltage;
+        /** voltage to apply to the right side now */
+        float rightVoltage;
+        /** solver iterations it took */
+        int iterations;
+        /** whether the solver reached its tolerance before maxIterations */
+        bool converged;
+};
+
+/**
+ * @brief Model predictive controller for the wheel velocities of a differential drive
+ *
+ * Each side follows the feedforward model, kA * a = V - kS * sign(v) - kV * v, discretized over
+ * one control period. Every solve plans the next HORIZON voltage commands of both sides to track
+ * a reference velocity for each wheel, while keeping the voltages, the wheel accelerations and the
+ * robot's angular acceleration within their limits. Only the first command is applied, and the
+ * rest warm start the next solve.
+ *
+ * The quadratic program is solved with ADMM. The model is fixed, so the matrix the solver factors
+ * is factored once in the constructor, and every matrix lives in the object at a fixed size, so
+ * solving never allocates
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::DriveMpc mpc(feedforward, {.maxAcceleration = 150, .maxAngularAcceleration = 20});
+ * std::array<float, lemlib::DriveMpc::HORIZON> left, right; // reference wheel velocities
+ * const lemlib::MpcSolution solution = mpc.solve(leftVelocity, rightVelocity, left, right);
+ * @endcode
+ */
+class DriveMpc {
+    public:
+        /** number of control periods planned by each solve */
+        static constexpr int HORIZON = 10;
+        /**
+         * @brief DriveMpc constructor
+         *
+         * @param model feedforward gains of each side. kA has to be positive
+         * @param settings weights and limits
+         * @param period time between solves, in seconds. 0.01 by default
+         */
+        DriveMpc(const DriveFeedforward& model, const MpcSettings& settings = {}, float period = 0.01);
+        /**
+         * @brief Plan the next commands
+         *
+         * @param leftVelocity measured velocity of the left wheels, in inches per second
+         * @param rightVelocity measured velocity of the right wheels, in inches per second
+         * @param leftReference velocity the left wheels should have after each of the next HORIZON
+         * periods, in inches per second
+         * @param rightReference velocity the right wheels should have after each of the next
+         * HORIZON periods, in inches per second
+         * @return MpcSolution the voltages to apply now
+         */
+        MpcSolution solve(float leftVelocity, float rightVelocity, std::span<const float, HORIZON> leftReference,
+                          std::span<const float, HORIZON> rightReference);
+        /**
+         * @brief Forget the last solution, so the next solve starts cold and isn't smoothed
+         * against a command that is no longer applied
+         */
+        void reset();
+    private:
+        /** left commands, then right commands */
+        static constexpr int COMMANDS = 2 * HORIZON;
+        /** voltage, wheel acceleration and angular acceleration limits, a block of HORIZON rows each */
+        static constexpr int CONSTRAINTS = 5 * HORIZON;
+
+        struct Side {
+                float decay; // velocity kept from one period to the next
+                float gain; // velocity gained per volt over one period
+                float kS;
+                /** velocity after period i from the command of period j, row major */
+                std::array<float, HORIZON * HORIZON> response;
+        };
+
+        std::array<Side, 2> sides;
+        MpcSettings settings;
+        float period;
+        float rho;
+        /** cost matrix of the commands, row major */
+        std::array<float, COMMANDS * COMMANDS> cost {};
+        /** constraint matrix, rows scaled to unit length, row major */
+        std::array<float, CONSTRAINTS * COMMANDS> constraints {};
+        std::array<float, CONSTRAINTS> rowScale {};
+        /** cholesky factor of cost + sigma * I + rho * constraints' * constraints, lower, row major */
+        std::array<float, COMMANDS * COMMANDS> factor {};
+
+        // warm start
+        std::array<float, COMMANDS> commands {};
+        std::array<float, CONSTRAINTS> z {};
+        std::array<float, CONSTRAINTS> y {};
+        std::array<float, 2> lastCommand {};
+        bool warm = false;
+};
+} // namespace lemlib
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include "lemlib/pose.hpp"
+#include "lemlib/trajectory.hpp"
+
+namespace lemlib {
+/**
+ * @brief Find where a line segment crosses a circle
+ *
+ * @param start start point of the segment
+ * @param end end point of the segment
+ * @param center center of the circle, usually the robot
+ * @param radius radius of the circle, usually the lookahead distance
+ * @return float how far along the segment the crossing is (0 to 1), preferring the one closer to
+ * the end. -1 if the segment doesn't cross the circle
+ */
+float circleIntersect(Pose start, Pose end, Pose center, float radius);
+
+/**
+ * @brief Tracks the robot's progress along a pure pursuit path or a trajectory
+ *
+ * Searching the whole path for the closest point and the lookahead point costs more the longer the
+ * path is. The robot only moves forwards along the path, so the cursor only searches forwards from
+ * where it was last tick, and no further than a couple of lookahead distances along the path,
+ * measured with a prefix sum of the segment lengths built once up front. Each update looks at the
+ * same handful of points however long the path is
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::PathCursor cursor(points, 10);
+ * while (cursor.getClosest() != points.size() - 1) {
+ *     cursor.update(chassis.getPose(true));
+ *     lemlib::Pose target = cursor.getLookahead();
+ * }
+ * @endcode
+ */
+class PathCursor {
+    public:
+        /**
+         * @brief Construct a new cursor at the start of a path
+         *
+         * @param path points of the path. Only x and y are used, and the points must outlive the cursor
+         * @param lookahead lookahead distance, in inches
+         */
+        PathCursor(std::span<const Pose> path, float lookahead);
+        /**
+         * @brief Construct a new cursor at the start of a trajectory
+         *
+         * @param samples samples of the trajectory, which must outlive the cursor. Their distance along the
+         * path is used as is
+         * @param lookahead lookahead distance, in inches
+         */
+        PathCursor(std::span<const TrajectorySample> samples, float lookahead);
+        /**
+         * @brief Move the cursor to where the robot is now
+         *
+         * @param pose the current pose of the robot
+         */
+        void update(const Pose& pose);
+        /**
+         * @brief Get the index of the point closest to the robot
+         *
+         * @return int index into the path or trajectory
+         */
+        int getClosest() const;
+        /**
+         * @brief Get the lookahead point
+         *
+         * If the robot strays further than the lookahead distance from the path, this stays where it
+         * last was
+         *
+         * @return Pose the point, with the index of the segment it's on in theta
+         */
+        Pose getLookahead() const;
+        /**
+         * @brief Get the distance along the path to a point
+         *
+         * @param index index into the path or trajectory
+         * @return float inches from the start of the path
+         */
+        float getDistance(int index) const;
+    private:
+        /**
+         * @brief Get the position of a point, from whichever the cursor was made with
+         *
+         * @param index index into the path or trajectory
+         * @return Pose x and y of the point, theta 0
+         */
+        Pose point(int index) const;
+
+        std::span<const Pose> path;
+        std::span<const TrajectorySample> samples;
+        std::vector<float> distances;
+        float lookahead;
+        int closest = 0;
+        Pose lookaheadPoint;
+};
+} // namespace lemlib
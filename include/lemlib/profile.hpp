@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace lemlib {
+/**
+ * @brief Limits a motion profile has to respect
+ *
+ * Units are up to the motion: inches for driving, degrees for turning
+ */
+struct ProfileConstraints {
+        /** maximum speed, per second. 0 disables profiling */
+        float maxVelocity = 0;
+        /** maximum acceleration, per second squared */
+        float maxAcceleration = 0;
+        /** maximum jerk, per second cubed. 0 gives a trapezoidal profile, anything positive an S-curve */
+        float maxJerk = 0;
+};
+
+/**
+ * @brief Where a motion profile says the robot should be at some time
+ */
+struct ProfileState {
+        float position = 0;
+        float velocity = 0;
+        float acceleration = 0;
+};
+
+/**
+ * @brief Time parameterized profile from rest to rest over a distance
+ *
+ * Without a jerk limit the profile is trapezoidal: full acceleration, cruise, full deceleration.
+ * With one it is a seven phase S-curve, where the acceleration itself ramps in and out. Moves too
+ * short to reach the maximum velocity peak at a lower one. The profile is built once when the
+ * motion starts, and sampling it is a handful of multiplies
+ *
+ * @b Example
+ * @code {.cpp}
+ * // 48 inches, at most 60 in/s, 120 in/s^2 and 600 in/s^3
+ * lemlib::MotionProfile profile(48, {60, 120, 600});
+ * lemlib::ProfileState state = profile.sample(0.5); // half a second in
+ * float total = profile.getDuration();
+ * @endcode
+ */
+class MotionProfile {
+    public:
+        /**
+         * @brief Construct a new profile
+         *
+         * @param distance distance to move. Negative distances move backwards
+         * @param constraints limits of the profile. maxVelocity and maxAcceleration must be positive
+         */
+        MotionProfile(float distance, const ProfileConstraints& constraints);
+        /**
+         * @brief Get the state of the profile at a time
+         *
+         * @param time seconds since the start of the profile. Past the end the profile rests at the distance
+         * @return ProfileState
+         */
+        ProfileState sample(float time) const;
+        /**
+         * @brief Get how long the profile takes
+         *
+         * @return float seconds
+         */
+        float getDuration() const;
+        /**
+         * @brief Get the distance the profile moves
+         */
+        float getDistance() const;
+    private:
+        /**
+         * @brief A phase of constant jerk
+         */
+        struct Phase {
+                float start = 0; // seconds
+                ProfileState state; // at the start of the phase
+                float jerk = 0;
+        };
+
+        static constexpr std::size_t PHASES = 7;
+
+        /**
+         * @brief Append a phase, integrating the state at its start from the previous one
+         */
+        void addPhase(float duration, float acceleration, float jerk);
+
+        float distance;
+        float sign;
+        std::array<Phase, PHASES> phases;
+        std::size_t phaseCount = 0;
+        float duration = 0;
+};
+} // namespace lemlib
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <utility>
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+/**
+ * @brief RAMSETE trajectory tracking controller for a differential drive
+ *
+ * Given where the robot is and where the trajectory says it should be, along with the
+ * trajectory's own velocity and turn rate, RAMSETE gives the velocity and turn rate that bring the
+ * robot back onto the trajectory. The correction grows with the reference velocity, so the robot
+ * converges on the position and the heading of the trajectory together, unlike a carrot point
+ * which only chases a position.
+ *
+ * Everything is in standard form: x and y in inches, headings in radians counterclockwise from
+ * the x axis, like Chassis::getPose(true, true), and turn rates positive counterclockwise
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::Ramsete ramsete;
+ * const auto [velocity, angularVelocity] = ramsete.calculate(pose, reference, 40, 0.5);
+ * @endcode
+ */
+class Ramsete {
+    public:
+        /**
+         * @brief Ramsete constructor
+         *
+         * @param b how aggressively to correct, like a proportional gain, per square inch. 0.003 by
+         * default, a little above the usual 2 per square meter (0.0013) since the drivetrain
+         * reaches the velocities it is given late
+         * @param zeta damping, between 0 and 1. 0.9 by default
+         */
+        Ramsete(float b = 0.003, float zeta = 0.9);
+        /**
+         * @brief Calculate the velocity and turn rate to follow the trajectory
+         *
+         * @param pose pose of the robot, in standard form
+         * @param reference pose the trajectory is at now, in standard form
+         * @param velocity velocity of the trajectory, in inches per second
+         * @param angularVelocity turn rate of the trajectory, in radians per second
+         * @return std::pair<float, float> velocity in inches per second and turn rate in radians
+         * per second
+         */
+        std::pair<float, float> calculate(const Pose& pose, const Pose& reference, float velocity,
+                                          float angularVelocity) const;
+
+        float b;
+        float zeta;
+};
+} // namespace lemlib
@@ -0,0 +1,369 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include "pros/distance.hpp"
+#include "pros/imu.hpp"
+#include "pros/misc.hpp"
+#include "pros/motor_group.hpp"
+#include "pros/optical.hpp"
+#include "pros/rotation.hpp"
+#include "pros/rtos.hpp"
+#include "lemlib/seqlock.hpp"
+
+namespace lemlib {
+/**
+ * @brief Number of smart ports on the brain
+ */
+constexpr std::size_t SMART_PORTS = 21;
+
+/**
+ * @brief Everything read from a motor in one acquisition pass
+ */
+struct MotorSample {
+        /** encoder count, see pros::Motor::get_raw_position */
+        std::int32_t rawPosition = 0;
+        /** when the motor sampled its encoder, in milliseconds */
+        std::uint32_t positionTime = 0;
+        /** cartridge, read once when the motor is added */
+        pros::MotorGears gearing = pros::MotorGears::invalid;
+        /** velocity of the output shaft, in rpm */
+        float velocity = 0;
+        /** applied voltage, in mV */
+        std::int32_t voltage = 0;
+        /** current draw, in mA */
+        std::int32_t current = 0;
+        /** temperature, in degrees celsius */
+        float temperature = 0;
+        /** output torque, in Nm */
+        float torque = 0;
+};
+
+/**
+ * @brief Everything read from an inertial sensor in one acquisition pass
+ */
+struct ImuSample {
+        /** rotation since calibration, in degrees, clockwise positive */
+        float rotation = 0;
+        /** heading from 0 to 360 degrees */
+        float heading = 0;
+};
+
+/**
+ * @brief Everything read from a rotation sensor in one acquisition pass
+ */
+struct RotationSample {
+        /** position, in centidegrees */
+        std::int32_t position = 0;
+        /** velocity, in centidegrees per second */
+        std::int32_t velocity = 0;
+};
+
+/**
+ * @brief Everything read from a distance sensor in one acquisition pass
+ */
+struct DistanceSample {
+        /** distance to the object, in mm. 9999 if nothing is in range */
+        std::int32_t distance = 0;
+        /** confidence from 0 to 63, only reported past 200 mm */
+        std::int32_t confidence = 0;
+};
+
+/**
+ * @brief Everything read from an optical sensor in one acquisition pass
+ */
+struct OpticalSample {
+        /** hue, from 0 to 359.999 degrees */
+        float hue = 0;
+        /** saturation, from 0 to 1 */
+        float saturation = 0;
+        /** brightness, from 0 to 1 */
+        float brightness = 0;
+        /** proximity, from 0 to 255, higher is closer */
+        std::int32_t proximity = 0;
+};
+
+/**
+ * @brief Everything read from a controller in one acquisition pass
+ */
+struct ControllerSample {
+        /** joystick positions from -127 to 127, indexed by pros::controller_analog_e_t */
+        std::array<std::int32_t, 4> analog {};
+        /** one bit per button, bit 0 being pros::E_CONTROLLER_DIGITAL_L1 */
+        std::uint16_t buttons = 0;
+
+        /**
+         * @brief Get whether a button is held
+         *
+         * @param button the button
+         * @return true if the button was held when the controller was read
+         */
+        bool held(pros::controller_digital_e_t button) const {
+            return buttons >> (button - pros::E_CONTROLLER_DIGITAL_L1) & 1;
+        }
+};
+
+/**
+ * @brief Everything read from the battery in one acquisition pass
+ */
+struct BatterySample {
+        /** voltage, in mV. 0 until the battery has been read */
+        std::int32_t voltage = 0;
+        /** voltage through the scheduler's low pass filter, in mV */
+        float filtered = 0;
+        /** current draw, in mA */
+        std::int32_t current = 0;
+};
+
+/**
+ * @brief One coherent set of readings from every device added to a SensorScheduler
+ *
+ * Samples are indexed by smart port minus one. A device keeps its last sample until it is read
+ * again, and sampled holds when that was
+ */
+struct SensorFrame {
+        /** time the acquisition pass that produced this frame started, in milliseconds */
+        std::uint32_t time = 0;
+        /** one bit per port that has been read, bit 0 being port 1 */
+        std::uint32_t present = 0;
+        /** when each port was last read, in milliseconds */
+        std::array<std::uint32_t, SMART_PORTS> sampled {};
+        std::array<MotorSample, SMART_PORTS> motors {};
+        std::array<ImuSample, SMART_PORTS> imus {};
+        std::array<RotationSample, SMART_PORTS> rotations {};
+        std::array<DistanceSample, SMART_PORTS> distances {};
+        std::array<OpticalSample, SMART_PORTS> opticals {};
+        /** indexed by pros::controller_id_e_t */
+        std::array<ControllerSample, 2> controllers {};
+        BatterySample battery;
+
+        /**
+         * @brief Get the sample of the motor on a port
+         *
+         * @param port smart port, 1-21. The sign is ignored, so motor group ports can be passed as is
+         */
+        const MotorSample& motor(std::int8_t port) const { return motors[index(port)]; }
+        /**
+         * @brief Get the sample of the inertial sensor on a port
+         */
+        const ImuSample& imu(std::uint8_t port) const { return imus[index(port)]; }
+        /**
+         * @brief Get the sample of the rotation sensor on a port
+         */
+        const RotationSample& rotation(std::uint8_t port) const { return rotations[index(port)]; }
+        /**
+         * @brief Get the sample of the distance sensor on a port
+         */
+        const DistanceSample& distance(std::uint8_t port) const { return distances[index(port)]; }
+        /**
+         * @brief Get the sample of the optical sensor on a port
+         */
+        const OpticalSample& optical(std::uint8_t port) const { return opticals[index(port)]; }
+        /**
+         * @brief Get the sample of a controller
+         */
+        const ControllerSample& controller(pros::controller_id_e_t id = pros::E_CONTROLLER_MASTER) const {
+            return controllers[id == pros::E_CONTROLLER_PARTNER];
+        }
+        /**
+         * @brief Get whether the device on a port has been read
+         */
+        bool has(std::int8_t port) const { return present >> index(port) & 1; }
+    private:
+        static std::size_t index(std::int8_t port) { return (port < 0 ? -port : port) - 1; }
+};
+
+/**
+ * @brief One task that reads every registered device at its own data rate
+ *
+ * Subsystems that poll devices on their own read the same port several times a cycle, from
+ * loops that aren't lined up with when the devices refresh. The scheduler reads each device
+ * once per refresh instead, and publishes the readings as a SensorFrame. Readers get the latest
+ * frame without locks, and every control loop that reads the same frame sees the same inputs.
+ *
+ * Motors, inertial sensors, controllers and the battery are read every 10 ms, rotation sensors every 5 ms,
+ * distance sensors every 30 ms and optical sensors once per integration time, which is as often
+ * as each of them has something new. The task wakes on every multiple of 5 ms of pros::millis(),
+ * and reads each device on multiples of its period. Odometry wakes on multiples of 10 ms, one
+ * priority lower, so each of its updates reads motors and the IMU from the same tick. Devices are
+ * added before start() is called
+ *
+ * A whole frame is over 1.6 KB, so a reader that only needs a device or two should get just
+ * those samples with getMotor(), getImu() and the like. Each of those reads is from a single
+ * frame, but two calls can straddle a new one. A reader that needs several devices from the
+ * same pass, like odometry, copies the frame into storage of its own with getFrame(frame)
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::SensorScheduler scheduler;
+ * scheduler.addMotors(&leftMotors);
+ * scheduler.addImu(&imu);
+ * scheduler.addController(&master);
+ * scheduler.start();
+ * // in any task
+ * float heading = scheduler.getImu(imu.get_port()).heading;
+ * @endcode
+ */
+class SensorScheduler {
+    public:
+        /**
+         * @brief Construct a new SensorScheduler with nothing registered
+         */
+        SensorScheduler();
+        /**
+         * @brief Read a motor every 10 ms
+         */
+        void addMotor(pros::Motor* motor);
+        /**
+         * @brief Read every motor in a motor group every 10 ms
+         */
+        void addMotors(pros::MotorGroup* motors);
+        /**
+         * @brief Read an inertial sensor every 10 ms
+         */
+        void addImu(pros::Imu* imu);
+        /**
+         * @brief Read a rotation sensor, setting its data rate to match
+         *
+         * @param rotation the rotation sensor
+         * @param period how often to read it, in milliseconds. A multiple of 5, 5 by default
+         */
+        void addRotation(pros::Rotation* rotation, std::uint32_t period = 5);
+        /**
+         * @brief Read a distance sensor every 30 ms
+         */
+        void addDistance(pros::Distance* distance);
+        /**
+         * @brief Read an optical sensor once per integration time
+         *
+         * If the sensor can't report its integration time, it is read every 100 ms, the default
+         */
+        void addOptical(pros::Optical* optical);
+        /**
+         * @brief Read a controller's joysticks and buttons every 10 ms
+         *
+         * @param controller the controller
+         * @param id which controller it is, since pros::Controller doesn't say
+         */
+        void addController(pros::Controller* controller, pros::controller_id_e_t id = pros::E_CONTROLLER_MASTER);
+        /**
+         * @brief Read the battery every 10 ms, and low pass filter its voltage
+         *
+         * The voltage sags and recovers with every change in load, so the filtered voltage is
+         * what to scale motor commands by
+         *
+         * @param timeConstant time constant of the filter, in seconds. 0.25 by default
+         */
+        void addBattery(float timeConstant = 0.25);
+        /**
+         * @brief Start the acquisition task. Does nothing if it's already running
+         */
+        void start();
+        /**
+         * @brief Get whether the acquisition task is running
+         */
+        bool isRunning() const;
+        /**
+         * @brief Read every device that is due and publish a new frame
+         *
+         * The acquisition task calls this every 5 ms. It can be called directly instead of
+         * starting the task, e.g. from a test harness
+         *
+         * @param time the current time, in milliseconds
+         */
+        void poll(std::uint32_t time);
+        /**
+         * @brief Get the latest frame
+         *
+         * @return SensorFrame a copy, which is never torn between two acquisition passes
+         */
+        SensorFrame getFrame() const;
+        /**
+         * @brief Copy the latest frame into existing storage, without a copy on the stack
+         *
+         * @param frame where to copy it to
+         */
+        void getFrame(SensorFrame& frame) const;
+        /**
+         * @brief Get the latest sample of the motor on a port
+         *
+         * @param port smart port, 1-21. The sign is ignored, so motor group ports can be passed as is
+         * @param sampled if not nullptr, set to when the sample was read, in milliseconds
+         */
+        MotorSample getMotor(std::int8_t port, std::uint32_t* sampled = nullptr) const;
+        /**
+         * @brief Get the latest sample of the inertial sensor on a port
+         */
+        ImuSample getImu(std::uint8_t port, std::uint32_t* sampled = nullptr) const;
+        /**
+         * @brief Get the latest sample of the rotation sensor on a port
+         */
+        RotationSample getRotation(std::uint8_t port, std::uint32_t* sampled = nullptr) const;
+        /**
+         * @brief Get the latest sample of the distance sensor on a port
+         */
+        DistanceSample getDistance(std::uint8_t port, std::uint32_t* sampled = nullptr) const;
+        /**
+         * @brief Get the latest sample of the optical sensor on a port
+         */
+        OpticalSample getOptical(std::uint8_t port, std::uint32_t* sampled = nullptr) const;
+        /**
+         * @brief Get the latest sample of a controller
+         */
+        ControllerSample getController(pros::controller_id_e_t id = pros::E_CONTROLLER_MASTER) const;
+        /**
+         * @brief Get the latest sample of the battery
+         */
+        BatterySample getBattery() const;
+        /**
+         * @brief Get whether the device on a port has been read
+         */
+        bool has(std::int8_t port) const;
+        /**
+         * @brief Get how many frames have been published
+         *
+         * Comparing this against a previous value is cheaper than copying the frame to see if
+         * there is anything new
+         */
+        std::uint32_t getVersion() const;
+    private:
+        enum class Kind { MOTOR, IMU, ROTATION, DISTANCE, OPTICAL, CONTROLLER, BATTERY };
+
+        struct Source {
+                Kind kind = Kind::MOTOR;
+                // the device, of the type kind says. Motors are kept as the AbstractMotor they are,
+                // since a MotorGroup is only one through a virtual base
+                union {
+                        pros::AbstractMotor* motor = nullptr;
+                        pros::Imu* imu;
+                        pros::Rotation* rotation;
+                        pros::Distance* distance;
+                        pros::Optical* optical;
+                        pros::Controller* controller;
+                };
+                std::uint8_t index = 0; // motor within a motor group, or controller id
+                std::uint8_t port = 0;
+                std::uint32_t period = 10;
+                std::uint32_t lastRead = 0;
+                bool read = false;
+        };
+
+        static constexpr std::size_t MAX_SOURCES = 32;
+
+        void add(const Source& source);
+        void read(Source& source, std::uint32_t time);
+        /**
+         * @brief Get a port's sample out of the latest frame, and when it was read
+         */
+        template <typename U>
+        U getSample(std::size_t samples, std::int8_t port, std::uint32_t* sampled) const;
+
+        std::array<Source, MAX_SOURCES> sources;
+        std::size_t sourceCount = 0;
+        float batteryTimeConstant = 0.25;
+        // filled by poll(), then published
+        SensorFrame back;
+        SeqLock<SensorFrame> front;
+        pros::Task* task = nullptr;
+};
+} // namespace lemlib
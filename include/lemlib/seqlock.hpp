@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace lemlib {
+/**
+ * @brief A value published by one writer and read by any number of tasks without locks
+ *
+ * The writer fills whichever of two slots readers aren't being pointed at, then bumps a sequence
+ * number to publish it. Readers copy the published slot and check the sequence number didn't
+ * move while they copied. A reader only has to copy again if a whole write finished in the
+ * middle of its copy, and the writer never waits for readers, so a slow reader such as a task
+ * printing to the controller can't hold up odometry.
+ *
+ * Writes must not overlap each other. The slots are stored as atomic words, so reads racing a
+ * write are well defined.
+ *
+ * @tparam T a trivially copyable type, such as lemlib::Pose
+ *
+ * @b Example
+ * @code {.cpp}
+ * lemlib::SeqLock<lemlib::Pose> published(lemlib::Pose(0, 0, 0));
+ * // in the writing task
+ * published.store(lemlib::Pose(1, 2, 3));
+ * // in any other task
+ * lemlib::Pose pose = published.load();
+ * // or just the part that's needed
+ * float x = published.loadPart<float>(offsetof(lemlib::Pose, x));
+ * @endcode
+ */
+template <typename T> class SeqLock {
+        static_assert(std::is_trivially_copyable_v<T>, "SeqLock copies values word by word");
+    public:
+        /**
+         * @brief Construct a new SeqLock
+         *
+         * @param value the value readers see until the first store
+         */
+        explicit SeqLock(const T& value) {
+            write(slots[0], value);
+            write(slots[1], value);
+        }
+
+        /**
+         * @brief Publish a new value. Only one task may store at a time
+         *
+         * @param value the new value
+         */
+        void store(const T& value) {
+            const std::uint32_t published = sequence.load(std::memory_order_relaxed);
+            // keeps the last publish ahead of this write, so a reader can't see the slot change under it
+            std::atomic_thread_fence(std::memory_order_release);
+            write(slots[(published + 1) & 1], value);
+            sequence.store(published + 1, std::memory_order_release);
+        }
+
+        /**
+         * @brief Get the last published value
+         *
+         * @return T a copy that is never torn between two stores
+         */
+        T load() const {
+            while (true) {
+                const std::uint32_t before = sequence.load(std::memory_order_acquire);
+                const T value = read(slots[before & 1]);
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) == before) return value;
+            }
+        }
+
+        /**
+         * @brief Copy the last published value into existing storage
+         *
+         * load() builds the value and its words on the stack, which is a lot for a large T on a
+         * small task stack. This copies straight into value instead
+         *
+         * @param value where to copy it to. Written more than once if a store finishes mid copy
+         */
+        void load(T& value) const {
+            loadParts([&](const auto& copy) {
+                copy(0, &value, sizeof(T));
+                return 0;
+            });
+        }
+
+        /**
+         * @brief Read parts of the last published value without copying the rest of it
+         *
+         * The parts are all from the same store. reader is called again if a store finishes while
+         * it is copying, so it shouldn't do anything but copy
+         *
+         * @param reader called with copy(offset, destination, size), which copies size bytes
+         * starting at a byte offset into T. What it returns is returned
+         * @return what reader returned on the read that wasn't torn
+         */
+        template <typename F> auto loadParts(F reader) const {
+            while (true) {
+                const std::uint32_t before = sequence.load(std::memory_order_acquire);
+                const Slot& slot = slots[before & 1];
+                const auto value =
+                    reader([&](std::size_t offset, void* destination, std::size_t size) {
+                        copy(slot, offset, destination, size);
+                    });
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (sequence.load(std::memory_order_relaxed) == before) return value;
+            }
+        }
+
+        /**
+         * @brief Get one part of the last published value
+         *
+         * @tparam U type of the part
+         * @param offset byte offset of the part into T, e.g. from offsetof
+         * @return U a copy of the part
+         */
+        template <typename U> U loadPart(std::size_t offset) const {
+            static_assert(std::is_trivially_copyable_v<U>, "SeqLock copies values word by word");
+            return loadParts([&](const auto& copy) {
+                U part;
+                copy(offset, &part, sizeof(U));
+                return part;
+            });
+        }
+
+        /**
+         * @brief Get how many values have been stored
+         *
+         * @return std::uint32_t number of stores since construction
+         */
+        std::uint32_t version() const { return sequence.load(std::memory_order_acquire); }
+    private:
+        static constexpr std::size_t WORDS = (sizeof(T) + sizeof(std::uint32_t) - 1) / sizeof(std::uint32_t);
+        using Slot = std::array<std::atomic<std::uint32_t>, WORDS>;
+
+        static void write(Slot& slot, const T& value) {
+            std::array<std::uint32_t, WORDS> words {};
+            std::memcpy(words.data(), &value, sizeof(T));
+            for (std::size_t i = 0; i < WORDS; i++) slot[i].store(words[i], std::memory_order_relaxed);
+        }
+
+        static void copy(const Slot& slot, std::size_t offset, void* destination, std::size_t size) {
+            std::byte* out = static_cast<std::byte*>(destination);
+            for (std::size_t i = offset / sizeof(std::uint32_t); i * sizeof(std::uint32_t) < offset + size; i++) {
+                const std::uint32_t word = slot[i].load(std::memory_order_relaxed);
+                // the bytes of this word that are part of the copy
+                const std::size_t start = std::max(offset, i * sizeof(std::uint32_t));
+                const std::size_t end = std::min(offset + size, (i + 1) * sizeof(std::uint32_t));
+                std::memcpy(out + start - offset,
+                            reinterpret_cast<const std::byte*>(&word) + start - i * sizeof(std::uint32_t), end - start);
+            }
+        }
+
+        static T read(const Slot& slot) {
+            std::array<std::uint32_t, WORDS> words;
+            for (std::size_t i = 0; i < WORDS; i++) words[i] = slot[i].load(std::memory_order_relaxed);
+            std::array<std::byte, sizeof(T)> bytes;
+            std::memcpy(bytes.data(), words.data(), sizeof(T));
+            return std::bit_cast<T>(bytes);
+        }
+
+        std::atomic<std::uint32_t> sequence = 0;
+        std::array<Slot, 2> slots;
+};
+} // namespace lemlib
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+#include "lemlib/asset.hpp"
+#include "lemlib/pose.hpp"
+
+namespace lemlib {
+/**
+ * @brief One point of a time parameterized trajectory
+ *
+ * Samples are stored as is in trajectory assets, so the layout is part of the file format. Every
+ * field is a 4 byte float, so there is no padding and the struct can be read straight out of the
+ * asset
+ */
+struct TrajectorySample {
+        /** x position, in inches */
+        float x;
+        /** y position, in inches */
+        float y;
+        /** heading of the path, in radians, clockwise from the y axis like Chassis::getPose(true) */
+        float heading;
+        /** velocity, in inches per second */
+        float velocity;
+        /** curvature, in 1/inches. Positive curves clockwise */
+        float curvature;
+        /** seconds since the start of the trajectory */
+        float time;
+        /** distance along the path since the start, in inches */
+        float distance;
+};
+
+static_assert(sizeof(TrajectorySample) == 28, "trajectory samples are part of the asset format");
+
+/**
+ * @brief Header at the start of a trajectory asset, followed by count samples
+ */
+struct TrajectoryHeader {
+        /** TRAJECTORY_MAGIC */
+        std::uint32_t magic;
+        /** TRAJECTORY_VERSION */
+        std::uint16_t version;
+        /** sizeof(TrajectorySample) when the asset was written */
+        std::uint16_t sampleSize;
+        /** number of samples after the header */
+        std::uint32_t count;
+};
+
+static_assert(sizeof(TrajectoryHeader) == 12, "the trajectory header is part of the asset format");
+
+/** "LTRJ" read as a little endian integer */
+constexpr std::uint32_t TRAJECTORY_MAGIC = 0x4A52544C;
+constexpr std::uint16_t TRAJECTORY_VERSION = 1;
+
+/**
+ * @brief Read-only view of a trajectory asset
+ *
+ * Trajectories are generated offline by the host generator (make trajectory), which does the
+ * spline fitting and the time optimal velocity passes on a computer instead of the brain. The view
+ * points into the asset, so loading one checks the header and copies nothing
+ *
+ * @b Example
+ * @code {.cpp}
+ * ASSET(skills_traj);
+ *
+ * std::optional<lemlib::Trajectory> trajectory = lemlib::Trajectory::load(skills_traj);
+ * if (trajectory) printf("%f seconds\n", trajectory->duration());
+ * @endcode
+ */
+class Trajectory {
+    public:
+        /**
+         * @brief Load a trajectory from an asset
+         *
+         * @param trajectory the asset, written by the trajectory generator
+         * @return std::optional<Trajectory> view of the samples, or nothing if the asset isn't a
+         * trajectory of this version, is truncated, or isn't aligned to read floats in place
+         */
+        static std::optional<Trajectory> load(const asset& trajectory);
+        /**
+         * @brief Get the samples of the trajectory
+         *
+         * @return std::span<const TrajectorySample> samples, in order along the path
+         */
+        std::span<const TrajectorySample> samples() const;
+        /**
+         * @brief Get how long the trajectory takes
+         *
+         * @return float seconds
+         */
+        float duration() const;
+        /**
+         * @brief Get the length of the path
+         *
+         * @return float inches
+         */
+        float length() const;
+    private:
+        Trajectory(std::span<const TrajectorySample> samples);
+
+        std::span<const TrajectorySample> points;
+};
+
+/**
+ * @brief Limits a generated trajectory has to respect
+ */
+struct TrajectoryConstraints {
+        /** maximum velocity of either wheel, in inches per second */
+        float maxVelocity = 0;
+        /** maximum acceleration along the path, and sideways around curves, in inches per second squared */
+        float maxAcceleration = 0;
+        /** distance between the left and right wheels, in inches */
+        float trackWidth = 0;
+};
+
+/**
+ * @brief Plan the fastest velocity for each sample, starting and ending at rest
+ *
+ * Each sample first gets the fastest velocity the robot can hold there: the outer wheel has to
+ * stay under the maximum velocity, and the sideways acceleration under the maximum acceleration. A
+ * forward pass then limits how quickly the robot can speed up from rest at the start, and a
+ * backward pass how quickly it can slow down to rest at the end. Integrating what's left gives
+ * the time of each sample
+ *
+ * @param samples samples with position, heading, curvature and distance filled in. Velocity and
+ * time are written
+ * @param constraints the limits, maxVelocity and maxAcceleration must be positive
+ */
+void timeParameterize(std::span<TrajectorySample> samples, const TrajectoryConstraints& constraints);
+
+/**
+ * @brief Generate a trajectory from one pose to another
+ *
+ * The path is a cubic Hermite spline, which leaves the start pose along its heading and arrives
+ * at the end pose along its heading. Its tangents are 2 * lead times the distance between the
+ * poses long, so lead shapes the curve about like the carrot point of Chassis::moveToPose
+ *
+ * @param start where the trajectory starts, heading in radians like Chassis::getPose(true)
+ * @param end where the trajectory ends, heading in radians like Chassis::getPose(true)
+ * @param lead how far the path keeps to the start and end headings, 0 to 1
+ * @param constraints the limits of the robot
+ * @param count how many samples to take, at least 2. 64 by default
+ * @return std::vector<TrajectorySample> the samples, evenly spaced in the spline parameter
+ */
+std::vector<TrajectorySample> generateTrajectory(const Pose& start, const Pose& end, float lead,
+                                                 const TrajectoryConstraints& constraints, int count = 64);
+} // namespace lemlib
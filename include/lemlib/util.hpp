@@ -163,4 +163,30 @@ float ema(float current, float previous, float smooth);
  * @endcode
  */
 float getCurvature(Pose pose, Pose other);
+
+/**
+ * @brief Get the output speed of a cartridge
+ *
+ * @param gearset the cartridge
+ * @return float free speed, in rpm. A green cartridge's if it isn't known
+ *
+ * @b Example
+ * @code {.cpp}
+ * cartridgeRpm(pros::MotorGears::blue); // returns 600
+ * @endcode
+ */
+float cartridgeRpm(pros::MotorGears gearset);
+
+/**
+ * @brief Get how many encoder ticks a raw motor position counts per output revolution
+ *
+ * @param gearset the cartridge
+ * @return float ticks per revolution. A green cartridge's if it isn't known
+ *
+ * @b Example
+ * @code {.cpp}
+ * ticksPerRev(pros::MotorGears::blue); // returns 300
+ * @endcode
+ */
+float ticksPerRev(pros::MotorGears gearset);
 } // namespace lemlib
\ No newline at end of file
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <utility>
+#include "lemlib/sensors.hpp"
+
+namespace lemlib {
+/**
+ * @brief Scales motor commands so they do the same thing at any battery voltage
+ *
+ * Motors turn a command into a fraction of the battery voltage, so the same command drives
+ * slower on a tired battery than on a fresh one. VoltageCompensation reads the filtered battery
+ * voltage from a SensorScheduler, which has to have addBattery() called on it, and scales
+ * commands by how far it is below the nominal voltage. Commands are still capped at full power,
+ * so a tired battery can't go faster than it can, but everything short of full power is
+ * repeatable.
+ *
+ * It only holds settings and a pointer to the scheduler, so it can be copied and used from any
+ * task
+ *
+ * @b Example
+ * @code {.cpp}
+ * sensorScheduler.addBattery();
+ * lemlib::VoltageCompensation compensation(&sensorScheduler, 12.8);
+ * chassis.setVoltageCompensation(compensation);
+ * intakeMotor.move(compensation.compensate(100));
+ * @endcode
+ */
+class VoltageCompensation {
+    public:
+        /**
+         * @brief VoltageCompensation constructor
+         *
+         * @param scheduler the scheduler reading the battery
+         * @param nominal voltage commands are meant for, in volts. 12.8 by default, about what a
+         * charged battery reads, so a charged battery runs at full speed
+         * @param maxScale most a command is scaled up by, so a bad reading can't run away. 1.25 by
+         * default
+         */
+        VoltageCompensation(const SensorScheduler* scheduler, float nominal = 12.8, float maxScale = 1.25);
+        /**
+         * @brief Get the filtered battery voltage
+         *
+         * @return float volts, or the nominal voltage if the battery hasn't been read
+         */
+        float getVoltage() const;
+        /**
+         * @brief Get what commands are multiplied by
+         *
+         * @return float the nominal voltage over the battery voltage, from 0 to maxScale
+         */
+        float getScale() const;
+        /**
+         * @brief Scale a command
+         *
+         * @param command motor power or voltage
+         * @param max most the command can be, 127 by default for motor power
+         * @return float the scaled command, within -max to max
+         */
+        float compensate(float command, float max = 127) const;
+        /**
+         * @brief Scale the commands of both sides of a drivetrain
+         *
+         * If either side would go past max, both are scaled back by the same ratio, so the robot
+         * still turns the way it was asked to
+         *
+         * @param left command of the left side
+         * @param right command of the right side
+         * @param max most either command can be, 127 by default for motor power
+         * @return std::pair<float, float> the scaled left and right commands
+         */
+        std::pair<float, float> compensateSides(float left, float right, float max = 127) const;
+    private:
+        const SensorScheduler* scheduler;
+        float nominal;
+        float maxScale;
+};
+} // namespace lemlib
@@ -1,8 +1,9 @@
 #pragma once
 #include "main.h" // IWYU pragma: keep
+#include "lemlib/sensors.hpp"
 
 extern pros::adi::DigitalOut littleWill;
 extern bool littleWillToggle;
 
 void setLittleWill(bool extended);
-void littleWillControl();
\ No newline at end of file
+void littleWillControl(const lemlib::ControllerSample& input);
\ No newline at end of file
@@ -21,9 +21,14 @@
 
 #include <stdarg.h>
 #include <stdbool.h>
+// g++ already defines _GNU_SOURCE on hosts with glibc, and the C++ headers rely on it staying defined
+#ifndef _GNU_SOURCE
 #define _GNU_SOURCE
 #include <stdio.h>
 #undef _GNU_SOURCE
+#else
+#include <stdio.h>
+#endif
 #include <stdint.h>
 
 #include "pros/colors.h"  // c color macros
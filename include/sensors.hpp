@@ -0,0 +1,10 @@
+#pragma once
+#include "main.h" // IWYU pragma: keep
+#include "lemlib/sensors.hpp"
+#include "lemlib/voltageCompensation.hpp"
+
+// Reads the drive, intake, imu and controller once per refresh so every subsystem sees the same inputs
+extern lemlib::SensorScheduler sensorScheduler;
+
+// Scales drive and intake commands by the battery voltage read by sensorScheduler
+extern lemlib::VoltageCompensation voltageCompensation;
@@ -0,0 +1,104 @@
+#include "main.h" // IWYU pragma: keep
+#include "actuators.hpp"
+
+namespace {
+void write(pros::AbstractMotor* motor, std::int32_t power) { motor->move(power); }
+
+void write(pros::adi::DigitalOut* output, bool value) { output->set_value(value); }
+} // namespace
+
+ActuatorCache::ActuatorCache() {}
+
+template <typename Device, typename Value, std::size_t N>
+void ActuatorCache::stage(std::array<Output<Device, Value>, N>& outputs, std::size_t& count, Device* device,
+                          Value value) {
+    std::size_t i = 0;
+    while (i < count && outputs[i].device != device) i++;
+    if (i == count) {
+        // out of room, so write it through rather than drop it
+        if (count == N) {
+            stats.issued++;
+            write(device, value);
+            return;
+        }
+        outputs[count++].device = device;
+    }
+    // a command replaced before it was written never reaches the device
+    if (outputs[i].staged) stats.suppressed++;
+    outputs[i].pending = value;
+    outputs[i].staged = true;
+}
+
+void ActuatorCache::move(pros::AbstractMotor* motor, std::int32_t power) {
+    mutex.take();
+    stage(motors, motorCount, motor, power);
+    mutex.give();
+    if (task == nullptr) flush();
+}
+
+void ActuatorCache::set(pros::adi::DigitalOut* output, bool value) {
+    mutex.take();
+    stage(digitalOuts, digitalOutCount, output, value);
+    mutex.give();
+    if (task == nullptr) flush();
+}
+
+template <typename Device, typename Value, std::size_t N>
+void ActuatorCache::writeChanged(std::array<Output<Device, Value>, N>& outputs, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) {
+        Output<Device, Value>& output = outputs[i];
+        if (!output.staged) continue;
+        output.staged = false;
+        if (output.known && output.pending == output.written) {
+            stats.suppressed++;
+            continue;
+        }
+        write(output.device, output.pending);
+        output.written = output.pending;
+        output.known = true;
+        stats.issued++;
+    }
+}
+
+void ActuatorCache::flush() {
+    mutex.take();
+    writeChanged(motors, motorCount);
+    writeChanged(digitalOuts, digitalOutCount);
+    mutex.give();
+}
+
+void ActuatorCache::start(std::uint32_t period) {
+    if (task != nullptr) return;
+    task = new pros::Task(
+        [this, period] {
+            std::uint32_t now = pros::millis();
+            while (true) {
+                flush();
+                pros::Task::delay_until(&now, period);
+            }
+        },
+        TASK_PRIORITY_DEFAULT + 1, TASK_STACK_DEPTH_DEFAULT, "Actuators");
+}
+
+void ActuatorCache::invalidate() {
+    // stage what was last written, so the next flush writes it again even if nothing sets it
+    const auto forget = [](auto& outputs, std::size_t count) {
+        for (std::size_t i = 0; i < count; i++) {
+            if (!outputs[i].known) continue;
+            if (!outputs[i].staged) outputs[i].pending = outputs[i].written;
+            outputs[i].staged = true;
+            outputs[i].known = false;
+        }
+    };
+    mutex.take();
+    forget(motors, motorCount);
+    forget(digitalOuts, digitalOutCount);
+    mutex.give();
+}
+
+ActuatorStats ActuatorCache::getStats() {
+    mutex.take();
+    const ActuatorStats copy = stats;
+    mutex.give();
+    return copy;
+}
@@ -0,0 +1,105 @@
+#include "main.h" // IWYU pragma: keep
+#include "blockCounter.hpp"
+#include "intake.hpp"
+#include "sensors.hpp"
+
+pros::Distance blockSensor(18); // Port 18, facing across the path at the indexer
+
+namespace {
+// A block is in front of the sensor once the reading drops under BLOCK_NEAR, and has left once it
+// rises past BLOCK_FAR, so a reading hovering on one threshold can't count twice. There is no
+// wait between blocks on top of that: the sensor refreshes every 30 ms, and at full speed a block
+// is only in view for one or two readings, so one far reading is all the gap there is to see
+const int BLOCK_NEAR = 50;          // mm
+const int BLOCK_FAR = 80;           // mm
+const uint32_t THROUGHPUT_WINDOW = 1000; // ms of blocks the throughput is averaged over
+
+pros::Mutex blockMutex;
+int blocksStored = 0;
+int blocksScored = 0;
+bool blockPresent = false;  // a block was in front of the sensor at the last reading
+uint32_t lastReading = 0;   // when the sensor was last read by the scheduler, in ms
+// when each of the most recent blocks passed, in ms, oldest first
+uint32_t passTimes[16] = {};
+int passCount = 0;
+} // namespace
+
+void updateBlockCounter() {
+    const uint8_t port = blockSensor.get_port();
+    // only new readings count, the sensor refreshes slower than the frames do
+    if (!sensorScheduler.has(port)) return;
+    uint32_t sampled;
+    const int32_t distance = sensorScheduler.getDistance(port, &sampled).distance;
+    if (sampled == lastReading) return;
+    lastReading = sampled;
+
+    blockMutex.take();
+    if (!blockPresent && distance < BLOCK_NEAR) {
+        // leading edge of a block, which way it counts depends on where the intake is sending it
+        blockPresent = true;
+        const IntakeState state = getIntakeState();
+        if (state == IntakeState::STORE) blocksStored++;
+        else if (state == IntakeState::LONG || state == IntakeState::UPPER_MID) blocksScored++;
+        if (passCount == 16) {
+            for (int i = 1; i < 16; i++) passTimes[i - 1] = passTimes[i];
+            passCount--;
+        }
+        passTimes[passCount++] = lastReading;
+    } else if (blockPresent && distance > BLOCK_FAR) {
+        blockPresent = false;
+    }
+    blockMutex.give();
+}
+
+void startBlockCounter() {
+    static pros::Task* blockTask = nullptr;
+    if (blockTask != nullptr) return;
+    blockTask = new pros::Task([] {
+        // wake with the scheduler, which reads the sensor as often as it refreshes
+        uint32_t now = pros::millis();
+        while (true) {
+            updateBlockCounter();
+            pros::Task::delay_until(&now, 5);
+        }
+    }, "Block Counter");
+}
+
+int getBlocksStored() {
+    blockMutex.take();
+    const int count = blocksStored;
+    blockMutex.give();
+    return count;
+}
+
+int getBlocksScored() {
+    blockMutex.take();
+    const int count = blocksScored;
+    blockMutex.give();
+    return count;
+}
+
+float getBlockThroughput() {
+    const uint32_t now = pros::millis();
+    blockMutex.take();
+    int recent = 0;
+    for (int i = 0; i < passCount; i++) recent += now - passTimes[i] <= THROUGHPUT_WINDOW;
+    blockMutex.give();
+    return recent * 1000.0f / THROUGHPUT_WINDOW;
+}
+
+void resetBlockCount() {
+    blockMutex.take();
+    blocksStored = 0;
+    blocksScored = 0;
+    passCount = 0;
+    blockMutex.give();
+}
+
+bool waitUntilScored(int count, int timeout) {
+    const uint32_t start = pros::millis();
+    while (getBlocksScored() < count) {
+        if (pros::millis() - start >= uint32_t(timeout)) return false;
+        pros::delay(10);
+    }
+    return true;
+}
@@ -0,0 +1,74 @@
+#include "main.h" // IWYU pragma: keep
+#include "colorSortTask.hpp"
+#include "sensors.hpp"
+
+pros::Optical sortSensor(20); // Port 20, at the bottom of the indexer
+
+namespace {
+// Measured along the intake, from the optical sensor to where the hood splits the path
+ColorSorter colorSorter({.distanceToEjector = 6, // inches from the sensor to the hood
+                         .rollerDiameter = 2, // inches, the indexer rollers
+                         .slip = 0.9, // blocks move a little slower than the rollers
+                         .ejectLatency = 20, // ms for the hood to move, or the indexer to reverse
+                         .blockLength = 3, // inches
+                         .nominalRpm = 600}); // the indexer at full power
+
+const int MAX_EJECT_TIME = 300; // ms, so a bogged down indexer can't hold the ejector out
+
+pros::Mutex sortMutex;
+EjectMethod ejectMethod = EjectMethod::HOOD;
+int blocksEjected = 0;
+} // namespace
+
+void setColorSort(BlockColor reject, EjectMethod method) {
+    sortMutex.take();
+    colorSorter.setReject(reject);
+    ejectMethod = method;
+    sortMutex.give();
+}
+
+int getBlocksEjected() {
+    sortMutex.take();
+    const int count = blocksEjected;
+    sortMutex.give();
+    return count;
+}
+
+namespace {
+// One decision, run every time the scheduler publishes a frame
+void updateColorSort(uint32_t& lastReading) {
+    const uint8_t port = sortSensor.get_port();
+    uint32_t sampled;
+    const lemlib::OpticalSample sample = sensorScheduler.getOptical(port, &sampled);
+    const bool fresh = sensorScheduler.has(port) && sampled != lastReading;
+    lastReading = sampled;
+    sortMutex.take();
+    // blocks only travel towards the hood while the intake runs them up. Anything else, such as
+    // an unjam, moves them in ways the sorter can't follow
+    if (isIntakeRunningUp()) {
+        const float rpm = sensorScheduler.getMotor(indexer.get_port()).velocity;
+        if (colorSorter.update(fresh ? &sample : nullptr, rpm, pros::millis())) {
+            // only as long as the block takes to pass, so the one behind it is kept
+            ejectBlock(ejectMethod, std::min(int(colorSorter.getEjectTime(rpm)), MAX_EJECT_TIME));
+            blocksEjected++;
+        }
+    } else {
+        colorSorter.reset();
+    }
+    sortMutex.give();
+}
+} // namespace
+
+void startColorSort() {
+    static pros::Task* sortTask = nullptr;
+    if (sortTask != nullptr) return;
+    // just below the scheduler and odometry, so a decision follows each new frame within the tick
+    sortTask = new pros::Task([] {
+        uint32_t lastReading = 0;
+        uint32_t now = pros::millis();
+        while (true) {
+            updateColorSort(lastReading);
+            pros::Task::delay_until(&now, 5);
+        }
+    }, TASK_PRIORITY_MAX - 3, TASK_STACK_DEPTH_DEFAULT, "Color Sort");
+}
@@ -0,0 +1,74 @@
+#include "main.h" // IWYU pragma: keep
+#include <algorithm>
+#include <cmath>
+#include "colorSorter.hpp"
+
+BlockColor classifyBlock(const lemlib::OpticalSample& sample, const ColorModel& model) {
+    if (sample.proximity < model.minProximity || sample.saturation < model.minSaturation) return BlockColor::NONE;
+    if (sample.hue >= model.redMinHue || sample.hue <= model.redMaxHue) return BlockColor::RED;
+    if (sample.hue >= model.blueMinHue && sample.hue <= model.blueMaxHue) return BlockColor::BLUE;
+    return BlockColor::NONE;
+}
+
+ColorSorter::ColorSorter(const ColorSortSettings& settings, const ColorModel& model)
+    : settings(settings),
+      model(model) {}
+
+void ColorSorter::setReject(BlockColor color) { reject = color; }
+
+BlockColor ColorSorter::getReject() const { return reject; }
+
+bool ColorSorter::update(const lemlib::OpticalSample* sample, float rollerRpm, std::uint32_t time) {
+    const float dt = started ? (time - lastTime) / 1000.0f : 0;
+    lastTime = time;
+    started = true;
+
+    // move every block along by how far the roller carried it
+    const float speed = blockSpeed(rollerRpm);
+    for (int i = 0; i < blockCount; i++) blocks[i].remaining -= speed * dt;
+
+    // a new block arrives in front of the sensor, and every reading while it's there votes on its color
+    if (sample != nullptr) {
+        const bool present = sample->proximity >= model.minProximity;
+        if (present && !inView && blockCount < MAX_BLOCKS) blocks[blockCount++] = {settings.distanceToEjector};
+        inView = present;
+        if (present && blockCount > 0) {
+            const BlockColor color = classifyBlock(*sample, model);
+            blocks[blockCount - 1].red += color == BlockColor::RED;
+            blocks[blockCount - 1].blue += color == BlockColor::BLUE;
+        }
+    }
+
+    // the oldest block is the closest to the ejector. Fire once it's the ejector's latency away
+    bool fire = false;
+    const float lead = speed * settings.ejectLatency / 1000;
+    while (blockCount > 0 && blocks[0].remaining <= lead) {
+        const Block& block = blocks[0];
+        // a tied vote could be either color, so it's safer to keep the block than to eject one of ours
+        const bool decided = block.red + block.blue >= settings.minReadings && block.red != block.blue;
+        const BlockColor color = block.red > block.blue ? BlockColor::RED : BlockColor::BLUE;
+        if (reject != BlockColor::NONE && decided && color == reject) fire = true;
+        // the block is past the point where anything can be done about it
+        for (int i = 1; i < blockCount; i++) blocks[i - 1] = blocks[i];
+        blockCount--;
+    }
+    return fire;
+}
+
+float ColorSorter::getEjectTime(float rollerRpm) const {
+    // long enough to clear a block at the usual speed, even if the measured speed says otherwise. The
+    // ejector takes ejectLatency to move both ways, so the latency doesn't shorten the time it's in place
+    const float nominalSpeed = blockSpeed(settings.nominalRpm);
+    const float minimum = nominalSpeed > 0 ? settings.blockLength / nominalSpeed * 1000 : settings.ejectLatency;
+    const float speed = blockSpeed(rollerRpm);
+    return speed > 0 ? std::max(settings.blockLength / speed * 1000, minimum) : minimum;
+}
+
+float ColorSorter::blockSpeed(float rollerRpm) const {
+    return rollerRpm / 60 * settings.rollerDiameter * M_PI * settings.slip;
+}
+
+void ColorSorter::reset() {
+    blockCount = 0;
+    inView = false;
+}
@@ -1,6 +1,7 @@
 #include "main.h" // IWYU pragma: keep
 #include "intake.hpp"
 #include "descore.hpp"
+#include "actuators.hpp"
 
 pros::adi::DigitalOut wing('E', false);
 
@@ -8,12 +9,12 @@ bool wingToggle = false;
 
 void setWing(bool extended) {
     wingToggle = extended;
-    wing.set_value(extended);
+    actuators.set(&wing, extended);
 }
 
 
-void descoreControl() {
-    if (master.get_digital(pros::E_CONTROLLER_DIGITAL_L2)) {
+void descoreControl(const lemlib::ControllerSample& input) {
+    if (input.held(pros::E_CONTROLLER_DIGITAL_L2)) {
         setWing(true);
     } else {
         setWing(false);
@@ -1,5 +1,8 @@
 #include "main.h" // IWYU pragma: keep
+#include <cmath>
 #include "intake.hpp"
+#include "sensors.hpp"
+#include "actuators.hpp"
 
 // Intake Motors/Sensors
 pros::Motor bottomIntake(19, pros::MotorGears::blue);    // Port 19, 11W Blue Motor
@@ -20,78 +23,237 @@ bool indexerPistonToggle = false;   // Tracks indexer piston state
 // Pneumatic control functions
 void setFloatingPiston(bool extended) {
     floatingPistonToggle = extended;
-    floatingPiston.set_value(extended);
+    actuators.set(&floatingPiston, extended);
 }
 
 void setHoodPiston(bool extended) {
     hoodPistonToggle = extended;
-    hoodPiston.set_value(extended);
+    actuators.set(&hoodPiston, extended);
 }
 
 void setIndexerPiston(bool extended) {
     indexerPistonToggle = extended;
-    indexerPiston.set_value(extended);
+    actuators.set(&indexerPiston, extended);
 }
 
-void intakeStore(int voltage) {
-    setFloatingPiston(true);
-    setHoodPiston(false);
-    setIndexerPiston(false);
-    bottomIntake.move(voltage);
-    indexer.move(voltage);
+void runIntake(int voltage) {
+    // scaled by the battery voltage, so the rollers spin the same on any charge
+    const int power = std::lround(voltageCompensation.compensate(voltage));
+    actuators.move(&bottomIntake, power);
+    actuators.move(&indexer, power);
 }
 
-void outtakeLong(int voltage) {
-    setFloatingPiston(true);
-    setHoodPiston(true);
-    setIndexerPiston(false);
-    bottomIntake.move(voltage);
-    indexer.move(voltage);
+// Intake state machine
+//////////////////////////////////////////////////////////////
+
+namespace {
+// What each state does with the pistons and rollers
+struct IntakeOutputs {
+    bool floating;
+    bool hood;
+    int indexer; // 1 extended, 0 retracted, -1 left as it is
+    int direction; // roller direction, 0 to stop
+    // whether a stall is a jam. Storing pushes blocks against the closed hood, so the rollers stall
+    // once the hopper is full, and reversing would spit the stored blocks back out the front
+    bool unjam;
+};
+
+IntakeOutputs intakeOutputs(IntakeState state) {
+    switch (state) {
+        case IntakeState::STORE: return {true, false, 0, 1, false};
+        case IntakeState::LONG: return {true, true, 0, 1, true};
+        case IntakeState::UPPER_MID: return {true, false, 1, 1, true};
+        case IntakeState::LOWER_MID: return {false, false, 0, -1, true};
+        case IntakeState::OUTTAKE: return {true, false, 0, -1, true};
+        default: return {true, false, -1, 0, false};
+    }
+}
+
+// Jam detection. A roller that is asked to spin but has barely moved for JAM_TIME while pushing
+// hard is jammed, and both rollers run backwards for UNJAM_TIME before the state resumes
+const int JAM_VELOCITY = 60;         // rpm, a tenth of a blue cartridge
+const int JAM_CURRENT = 2000;        // mA, the motors limit at 2500
+const float JAM_TORQUE = 0.25;       // Nm
+const int JAM_TIME = 250;            // ms stalled before it counts as a jam
+const int SPINUP_TIME = 200;         // ms after a state starts before checking, the rollers are still speeding up
+const int UNJAM_TIME = 150;          // ms spent reversing
+
+pros::Mutex intakeMutex;
+IntakeState intakeState = IntakeState::STOP;  // state asked for
+int intakeVoltage = 0;                        // power asked for, 0 to 127
+bool unjamming = false;                       // reversing out of a jam, intakeState resumes after
+uint32_t stateStart = 0;                      // when the rollers last started in intakeState, in ms
+uint32_t stalledSince = 0;                    // when the rollers first looked stalled, 0 if they don't
+uint32_t unjamStart = 0;                      // when the current unjam started, in ms
+int jamCount = 0;                             // jams cleared since startup
+bool ejecting = false;                        // throwing out a block, intakeState resumes after
+uint32_t ejectEnd = 0;                        // when the current ejection ends, in ms
+
+// Write a state's pistons and rollers. Called with intakeMutex held
+void applyIntakeState(IntakeState state, int voltage) {
+    const IntakeOutputs outputs = intakeOutputs(state);
+    setFloatingPiston(outputs.floating);
+    setHoodPiston(outputs.hood);
+    if (outputs.indexer != -1) setIndexerPiston(outputs.indexer == 1);
+    runIntake(outputs.direction * voltage);
+}
+} // namespace
+
+void setIntakeState(IntakeState state, int voltage) {
+    intakeMutex.take();
+    if (state != intakeState || voltage != intakeVoltage) {
+        intakeState = state;
+        intakeVoltage = voltage;
+        unjamming = false;
+        ejecting = false;
+        stalledSince = 0;
+        stateStart = pros::millis();
+        applyIntakeState(state, voltage);
+    }
+    intakeMutex.give();
+}
+
+IntakeState getIntakeState() {
+    intakeMutex.take();
+    const IntakeState state = intakeState;
+    intakeMutex.give();
+    return state;
 }
 
-void outtakeUpperMid(int voltage) {
-    setFloatingPiston(true);
-    setHoodPiston(false);
-    setIndexerPiston(true);
-    bottomIntake.move(voltage);
-    indexer.move(voltage);
+bool isIntakeUnjamming() {
+    intakeMutex.take();
+    const bool reversing = unjamming;
+    intakeMutex.give();
+    return reversing;
 }
 
-void outtakeLowerMid(int voltage) {
-    setFloatingPiston(false);
-    setHoodPiston(false);
-    setIndexerPiston(false);
-    bottomIntake.move(-voltage);
-    indexer.move(-voltage);
+void ejectBlock(EjectMethod method, int duration) {
+    intakeMutex.take();
+    // only a block on its way up can be thrown out, and an unjam already has the rollers
+    if (unjamming || intakeOutputs(intakeState).direction <= 0) {
+        intakeMutex.give();
+        return;
+    }
+    if (method == EjectMethod::HOOD) {
+        setHoodPiston(!intakeOutputs(intakeState).hood);
+    } else {
+        actuators.move(&indexer, std::lround(voltageCompensation.compensate(-intakeVoltage)));
+    }
+    ejecting = true;
+    ejectEnd = pros::millis() + duration;
+    intakeMutex.give();
+    // the block is nearly there, so write now instead of waiting for the next flush
+    actuators.flush();
 }
 
-void outtake(int voltage) {
-    // Retract both pistons and run all motors in reverse
-    setFloatingPiston(true);
-    setHoodPiston(false);
-    setIndexerPiston(false);
-    bottomIntake.move(-voltage);
-    indexer.move(-voltage);
+bool isIntakeRunningUp() {
+    intakeMutex.take();
+    const bool up = intakeOutputs(intakeState).direction > 0 && !unjamming;
+    intakeMutex.give();
+    return up;
 }
 
-void intakeStop() {
-    setFloatingPiston(true);
-    setHoodPiston(false);
-    bottomIntake.move(0);
-    indexer.move(0);
+bool isIntakeEjecting() {
+    intakeMutex.take();
+    const bool throwing = ejecting;
+    intakeMutex.give();
+    return throwing;
 }
 
-void intakeControl() { 
+int getIntakeJamCount() {
+    intakeMutex.take();
+    const int count = jamCount;
+    intakeMutex.give();
+    return count;
+}
+
+namespace {
+// Whether a roller is pushing against something instead of turning
+bool isStalled(const lemlib::MotorSample& motor) {
+    return std::abs(motor.velocity) < JAM_VELOCITY &&
+           (std::abs(motor.current) > JAM_CURRENT || std::abs(motor.torque) > JAM_TORQUE);
+}
+
+// One tick of the state machine, run every 10 ms by the intake task
+void updateIntake() {
+    const uint32_t now = pros::millis();
+    intakeMutex.take();
+    if (ejecting) {
+        // done throwing the block out, back to what was asked for
+        if (int32_t(now - ejectEnd) >= 0) {
+            ejecting = false;
+            stateStart = now;
+            applyIntakeState(intakeState, intakeVoltage);
+        }
+    } else if (unjamming) {
+        // done reversing, go back to what was asked for and give the rollers time to spin up again
+        if (now - unjamStart >= UNJAM_TIME) {
+            unjamming = false;
+            stateStart = now;
+            applyIntakeState(intakeState, intakeVoltage);
+        }
+    } else {
+        const IntakeOutputs outputs = intakeOutputs(intakeState);
+        const int direction = outputs.direction;
+        if (outputs.unjam && direction != 0 && intakeVoltage != 0 && now - stateStart >= SPINUP_TIME) {
+            const bool stalled =
+                isStalled(sensorScheduler.getMotor(bottomIntake.get_port())) ||
+                isStalled(sensorScheduler.getMotor(indexer.get_port()));
+            if (!stalled) stalledSince = 0;
+            else if (stalledSince == 0) stalledSince = now;
+            else if (now - stalledSince >= JAM_TIME) {
+                // run the rollers the other way to spit out whatever is stuck, the pistons stay put
+                unjamming = true;
+                unjamStart = now;
+                stalledSince = 0;
+                jamCount++;
+                runIntake(-direction * intakeVoltage);
+            }
+        }
+        // compensate again every tick, so a long run keeps its speed as the battery sags. The
+        // actuator cache drops the writes that don't change anything
+        if (!unjamming) runIntake(direction * intakeVoltage);
+    }
+    intakeMutex.give();
+}
+} // namespace
+
+void startIntakeTask() {
+    static pros::Task* intakeTask = nullptr;
+    if (intakeTask != nullptr) return;
+    intakeTask = new pros::Task([] {
+        uint32_t now = pros::millis();
+        while (true) {
+            updateIntake();
+            pros::Task::delay_until(&now, 10);
+        }
+    }, "Intake");
+}
+
+// Intake functions, each just asks the state machine for a state and returns
+void intakeStore(int voltage) { setIntakeState(IntakeState::STORE, voltage); }
+
+void outtakeLong(int voltage) { setIntakeState(IntakeState::LONG, voltage); }
+
+void outtakeUpperMid(int voltage) { setIntakeState(IntakeState::UPPER_MID, voltage); }
+
+void outtakeLowerMid(int voltage) { setIntakeState(IntakeState::LOWER_MID, voltage); }
+
+void outtake(int voltage) { setIntakeState(IntakeState::OUTTAKE, voltage); }
+
+void intakeStop() { setIntakeState(IntakeState::STOP, 0); }
+
+void intakeControl(const lemlib::ControllerSample& input) {
     // Intake control logic can be implemented here
-    if (master.get_digital(pros::E_CONTROLLER_DIGITAL_R1)) {
+    if (input.held(pros::E_CONTROLLER_DIGITAL_R1)) {
         intakeStore(127);
-    } else if (master.get_digital(pros::E_CONTROLLER_DIGITAL_L1)) {
+    } else if (input.held(pros::E_CONTROLLER_DIGITAL_L1)) {
         outtakeLong(127);
-    } else if (master.get_digital(pros::E_CONTROLLER_DIGITAL_DOWN)) {
+    } else if (input.held(pros::E_CONTROLLER_DIGITAL_DOWN)) {
         outtakeUpperMid(127);
-    } else if (master.get_digital(pros::E_CONTROLLER_DIGITAL_R2)) {
+    } else if (input.held(pros::E_CONTROLLER_DIGITAL_R2)) {
         outtake(127);
-    } else if (master.get_digital(pros::E_CONTROLLER_DIGITAL_B)) {
+    } else if (input.held(pros::E_CONTROLLER_DIGITAL_B)) {
         outtakeLowerMid(127);
     } else {
         intakeStop();
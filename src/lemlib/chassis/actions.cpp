@@ -0,0 +1,74 @@
+#include <algorithm>
+#include <mutex>
+#include "lemlib/chassis/actions.hpp"
+
+namespace lemlib {
+namespace {
+// callbacks fired is reserved for, even when fewer actions are registered when the motion starts
+constexpr std::size_t MIN_FIRED = 8;
+} // namespace
+
+void ActionScheduler::add(Action action) {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    actions.push_back(std::move(action));
+}
+
+void ActionScheduler::atDistance(float distance, std::function<void()> action) {
+    add({.trigger = Trigger::DISTANCE, .threshold = distance, .callback = std::move(action)});
+}
+
+void ActionScheduler::atRemaining(float distance, std::function<void()> action) {
+    add({.trigger = Trigger::REMAINING, .threshold = distance, .callback = std::move(action)});
+}
+
+void ActionScheduler::atTime(int time, std::function<void()> action) {
+    add({.trigger = Trigger::TIME, .threshold = float(time), .callback = std::move(action)});
+}
+
+void ActionScheduler::when(std::function<bool(const Pose&)> condition, std::function<void()> action) {
+    add({.trigger = Trigger::POSE, .threshold = 0, .condition = std::move(condition), .callback = std::move(action)});
+}
+
+void ActionScheduler::begin() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    startTime = pros::millis();
+    // room for every action to fire on the same tick, so update doesn't allocate in the motion loop
+    fired.reserve(std::max<std::size_t>(actions.size(), MIN_FIRED));
+}
+
+void ActionScheduler::update(float traveled, float remaining, const Pose& pose) {
+    // take the actions that fire out from under the lock, so a callback can register another.
+    // Only the motion's task calls update, so fired isn't shared
+    {
+        std::lock_guard<pros::Mutex> lock(mutex);
+        const float elapsed = pros::millis() - startTime;
+        for (auto it = actions.begin(); it != actions.end();) {
+            bool crossed = false;
+            switch (it->trigger) {
+                case Trigger::DISTANCE: crossed = traveled >= it->threshold; break;
+                case Trigger::REMAINING: crossed = remaining <= it->threshold; break;
+                case Trigger::TIME: crossed = elapsed >= it->threshold; break;
+                case Trigger::POSE: crossed = it->condition(pose); break;
+            }
+            if (crossed) {
+                fired.push_back(std::move(it->callback));
+                it = actions.erase(it);
+            } else {
+                it++;
+            }
+        }
+    }
+    for (const std::function<void()>& callback : fired) callback();
+    fired.clear();
+}
+
+void ActionScheduler::clear() {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    actions.clear();
+}
+
+bool ActionScheduler::empty() const {
+    std::lock_guard<pros::Mutex> lock(mutex);
+    return actions.empty();
+}
+} // namespace lemlib
@@ -0,0 +1,311 @@
+#include <math.h>
+#include <algorithm>
+#include <tuple>
+#include "pros/imu.hpp"
+#include "pros/misc.h"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/util.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "lemlib/motorGroup.hpp"
+
+namespace {
+/**
+ * @brief Check the limits of a motion profile, so one that would divide by zero is never built
+ *
+ * @param constraints the limits
+ * @param name which profile they are for, for the log
+ * @return lemlib::ProfileConstraints the limits, or no profile at all if they aren't usable
+ */
+lemlib::ProfileConstraints checkProfile(const lemlib::ProfileConstraints& constraints, const char* name) {
+    if (constraints.maxVelocity == 0) return constraints;
+    // written so NaN fails too
+    if (constraints.maxVelocity > 0 && constraints.maxAcceleration > 0 && constraints.maxJerk >= 0)
+        return constraints;
+    lemlib::infoSink()->error("{} profile needs a positive velocity and acceleration, and a jerk of at least 0. "
+                              "Got {}, {}, {}, driving without a profile",
+                              name, constraints.maxVelocity, constraints.maxAcceleration, constraints.maxJerk);
+    return {};
+}
+} // namespace
+
+lemlib::OdomSensors::OdomSensors(TrackingWheel* vertical1, TrackingWheel* vertical2, TrackingWheel* horizontal1,
+                                 TrackingWheel* horizontal2, pros::Imu* imu)
+    : vertical1(vertical1),
+      vertical2(vertical2),
+      horizontal1(horizontal1),
+      horizontal2(horizontal2),
+      imu(imu) {}
+
+lemlib::Drivetrain::Drivetrain(pros::MotorGroup* leftMotors, pros::MotorGroup* rightMotors, float trackWidth,
+                               float wheelDiameter, float rpm, float horizontalDrift)
+    : leftMotors(leftMotors),
+      rightMotors(rightMotors),
+      trackWidth(trackWidth),
+      wheelDiameter(wheelDiameter),
+      rpm(rpm),
+      horizontalDrift(horizontalDrift) {}
+
+lemlib::ExpoDriveCurve lemlib::defaultDriveCurve = lemlib::ExpoDriveCurve(0, 0, 1);
+
+lemlib::Chassis::Chassis(Drivetrain drivetrain, ControllerSettings linearSettings, ControllerSettings angularSettings,
+                         OdomSensors sensors, DriveCurve* throttleCurve, DriveCurve* steerCurve)
+    : lateralPID(linearSettings.kP, linearSettings.kI, linearSettings.kD, linearSettings.windupRange, true),
+      angularPID(angularSettings.kP, angularSettings.kI, angularSettings.kD, angularSettings.windupRange, true),
+      lateralSettings(linearSettings),
+      angularSettings(angularSettings),
+      drivetrain(drivetrain),
+      sensors(sensors),
+      throttleCurve(throttleCurve),
+      steerCurve(steerCurve),
+      lateralLargeExit(lateralSettings.largeError, lateralSettings.largeErrorTimeout),
+      lateralSmallExit(lateralSettings.smallError, lateralSettings.smallErrorTimeout, lateralSettings.settleVelocity),
+      angularLargeExit(angularSettings.largeError, angularSettings.largeErrorTimeout),
+      angularSmallExit(angularSettings.smallError, angularSettings.smallErrorTimeout, angularSettings.settleVelocity) {}
+
+void lemlib::Chassis::calibrate(bool calibrateImu) {
+    // calibrate the IMU if it exists and the user doesn't specify otherwise
+    if (sensors.imu != nullptr && calibrateImu) {
+        int attempt = 1;
+        // calibrate inertial, and if calibration fails, then repeat 5 times or until successful
+        while (attempt <= 5) {
+            sensors.imu->reset();
+            // wait until IMU is calibrated
+            do pros::delay(10);
+            while (sensors.imu->get_status() != pros::ImuStatus::error && sensors.imu->is_calibrating());
+            // exit if imu has been calibrated
+            if (!std::isnan(sensors.imu->get_heading()) && !std::isinf(sensors.imu->get_heading())) break;
+            // indicate error
+            pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, "---");
+            infoSink()->warn("IMU failed to calibrate! Attempt #{}", attempt);
+            attempt++;
+        }
+        // check if calibration attempts were successful
+        if (attempt > 5) {
+            sensors.imu = nullptr;
+            infoSink()->error("IMU calibration failed, defaulting to tracking wheels / motor encoders");
+        }
+    }
+    // initialize odom
+    if (sensors.vertical1 == nullptr)
+        sensors.vertical1 = new lemlib::TrackingWheel(drivetrain.leftMotors, drivetrain.wheelDiameter,
+                                                      -(drivetrain.trackWidth / 2), drivetrain.rpm);
+    if (sensors.vertical2 == nullptr)
+        sensors.vertical2 = new lemlib::TrackingWheel(drivetrain.rightMotors, drivetrain.wheelDiameter,
+                                                      drivetrain.trackWidth / 2, drivetrain.rpm);
+    sensors.vertical1->reset();
+    sensors.vertical2->reset();
+    if (sensors.horizontal1 != nullptr) sensors.horizontal1->reset();
+    if (sensors.horizontal2 != nullptr) sensors.horizontal2->reset();
+    setSensors(sensors, drivetrain);
+    init();
+    // rumble to controller to indicate success
+    pros::c::controller_rumble(pros::E_CONTROLLER_MASTER, ".");
+}
+
+void lemlib::Chassis::setPose(float x, float y, float theta, bool radians) {
+    lemlib::setPose(lemlib::Pose(x, y, theta), radians);
+}
+
+void lemlib::Chassis::setPose(Pose pose, bool radians) { lemlib::setPose(pose, radians); }
+
+lemlib::Pose lemlib::Chassis::getPose(bool radians, bool standardPos) {
+    Pose pose = lemlib::getPose(true);
+    if (standardPos) pose.theta = M_PI_2 - pose.theta;
+    if (!radians) pose.theta = radToDeg(pose.theta);
+    return pose;
+}
+
+void lemlib::Chassis::resetLocalPosition() {
+    float theta = this->getPose().theta;
+    lemlib::setPose(lemlib::Pose(0, 0, theta), false);
+}
+
+void lemlib::Chassis::setLateralProfile(const ProfileConstraints& constraints, float kA) {
+    lateralProfile = checkProfile(constraints, "Lateral");
+    lateralProfileKA = kA;
+}
+
+void lemlib::Chassis::setAngularProfile(const ProfileConstraints& constraints, float kA) {
+    angularProfile = checkProfile(constraints, "Angular");
+    angularProfileKA = kA;
+}
+
+void lemlib::Chassis::setFeedforward(const DriveFeedforward& feedforward) { driveFeedforward = feedforward; }
+
+void lemlib::Chassis::setRamsete(const Ramsete& ramsete, const TrajectoryConstraints& constraints) {
+    this->ramsete = ramsete;
+    ramseteConstraints = constraints;
+}
+
+void lemlib::Chassis::setMpc(const MpcSettings& settings) {
+    if (!driveFeedforward) {
+        infoSink()->error("Chassis::setMpc needs a feedforward model, call setFeedforward first");
+        return;
+    }
+    MpcSettings adjusted = settings;
+    adjusted.trackWidth = drivetrain.trackWidth;
+    mpc.emplace(*driveFeedforward, adjusted);
+}
+
+void lemlib::Chassis::setVoltageCompensation(const VoltageCompensation& compensation) {
+    voltageCompensation = compensation;
+}
+
+float lemlib::Chassis::freeSpeed() const {
+    // the wheels spin at the drivetrain rpm when the motors get full power
+    return drivetrain.rpm / 60 * drivetrain.wheelDiameter * M_PI;
+}
+
+float lemlib::Chassis::feedforward(float velocity) const { return velocity / freeSpeed() * 127; }
+
+void lemlib::Chassis::moveDrivetrain(float leftPower, float rightPower, float leftAcceleration,
+                                     float rightAcceleration) {
+    commandedPower = {leftPower, rightPower};
+    if (!driveFeedforward) {
+        movePower(leftPower, rightPower);
+        return;
+    }
+    if (mpc) {
+        // carry on accelerating over the horizon, the controller plans how to get there
+        std::array<float, DriveMpc::HORIZON> left;
+        std::array<float, DriveMpc::HORIZON> right;
+        for (int i = 0; i < DriveMpc::HORIZON; i++) {
+            left[i] = leftPower / 127 * freeSpeed() + leftAcceleration * (i + 1) * 0.01f;
+            right[i] = rightPower / 127 * freeSpeed() + rightAcceleration * (i + 1) * 0.01f;
+        }
+        // the last solution is stale if the drivetrain has been driven some other way since
+        const std::uint32_t now = pros::millis();
+        if (now - lastMpcSolve > 20) mpc->reset();
+        lastMpcSolve = now;
+        const auto [leftVelocity, rightVelocity] = wheelVelocities();
+        const MpcSolution solution = mpc->solve(leftVelocity, rightVelocity, left, right);
+        moveVoltage(solution.leftVoltage, solution.rightVoltage);
+        return;
+    }
+    // the power asks for a fraction of the free speed, and each side's model knows the voltage for it
+    const float leftVoltage = driveFeedforward->left.calculate(leftPower / 127 * freeSpeed(), leftAcceleration);
+    const float rightVoltage = driveFeedforward->right.calculate(rightPower / 127 * freeSpeed(), rightAcceleration);
+    moveVoltage(std::clamp(leftVoltage, -12.0f, 12.0f), std::clamp(rightVoltage, -12.0f, 12.0f));
+}
+
+void lemlib::Chassis::movePower(float leftPower, float rightPower) {
+    if (voltageCompensation)
+        std::tie(leftPower, rightPower) = voltageCompensation->compensateSides(leftPower, rightPower);
+    drivetrain.leftMotors->move(leftPower);
+    drivetrain.rightMotors->move(rightPower);
+}
+
+void lemlib::Chassis::moveVoltage(float leftVoltage, float rightVoltage) {
+    if (voltageCompensation)
+        std::tie(leftVoltage, rightVoltage) = voltageCompensation->compensateSides(leftVoltage, rightVoltage, 12);
+    drivetrain.leftMotors->move_voltage(leftVoltage * 1000);
+    drivetrain.rightMotors->move_voltage(rightVoltage * 1000);
+}
+
+std::pair<float, float> lemlib::Chassis::wheelVelocities() {
+    const SensorScheduler* scheduler = getSensorScheduler();
+    if (scheduler == nullptr || !scheduler->isRunning())
+        return {wheelVelocity(*drivetrain.leftMotors, nullptr), wheelVelocity(*drivetrain.rightMotors, nullptr)};
+    // exit conditions and the MPC all measure the same tick, so only copy the frame once per new one
+    const std::uint32_t version = scheduler->getVersion();
+    if (version != velocityVersion) {
+        scheduler->getFrame(velocityFrame);
+        velocityVersion = version;
+        measuredVelocities = {wheelVelocity(*drivetrain.leftMotors, &velocityFrame),
+                              wheelVelocity(*drivetrain.rightMotors, &velocityFrame)};
+    }
+    return measuredVelocities;
+}
+
+float lemlib::Chassis::wheelVelocity(const pros::MotorGroup& motors, const SensorFrame* frame) const {
+    // average the motors, each scaled from its cartridge to the wheel
+    float sum = 0;
+    std::size_t count = 0;
+    if (frame != nullptr) {
+        count = motors.size();
+        for (std::size_t i = 0; i < count; i++) {
+            const std::int8_t port = motors.get_port(i);
+            if (!frame->has(port)) return wheelVelocity(motors, nullptr);
+            const MotorSample& sample = frame->motor(port);
+            sum += sample.velocity / cartridgeRpm(sample.gearing) * drivetrain.rpm;
+        }
+    } else {
+        MotorGroupBuffer<double> velocityBuffer;
+        MotorGroupBuffer<pros::MotorGears> gearsetBuffer;
+        const std::span<double> velocities = getVelocities(motors, velocityBuffer);
+        const std::span<pros::MotorGears> gearsets = getGearings(motors, gearsetBuffer);
+        count = velocities.size();
+        for (std::size_t i = 0; i < count; i++) sum += velocities[i] / cartridgeRpm(gearsets[i]) * drivetrain.rpm;
+    }
+    if (count == 0) return 0;
+    return sum / count / 60 * drivetrain.wheelDiameter * M_PI;
+}
+
+float lemlib::Chassis::lateralVelocity() {
+    const auto [left, right] = wheelVelocities();
+    return (left + right) / 2;
+}
+
+float lemlib::Chassis::angularVelocity() {
+    const auto [left, right] = wheelVelocities();
+    return radToDeg((left - right) / drivetrain.trackWidth);
+}
+
+void lemlib::Chassis::updateActions(float remaining) {
+    // skip reading the pose when there is nothing to check it against
+    if (actions.empty()) return;
+    actions.update(distTraveled, remaining, getPose());
+}
+
+void lemlib::Chassis::setBrakeMode(pros::motor_brake_mode_e mode) {
+    drivetrain.leftMotors->set_brake_mode_all(mode);
+    drivetrain.rightMotors->set_brake_mode_all(mode);
+}
+
+void lemlib::Chassis::waitUntil(float dist) {
+    // do while to give the thread time to start
+    do pros::delay(10);
+    while (distTraveled <= dist && distTraveled != -1);
+}
+
+void lemlib::Chassis::waitUntilDone() {
+    do pros::delay(10);
+    while (distTraveled != -1);
+}
+
+void lemlib::Chassis::requestMotionStart() {
+    if (this->isInMotion()) this->motionQueued = true; // indicate a motion is queued
+    else this->motionRunning = true; // indicate motion is running
+
+    // wait until this motion is at front of "queue"
+    this->mutex.take(TIMEOUT_MAX);
+
+    // this->motionRunning should be true
+    // and this->motionQueued should be false
+    // indicating this motion is running
+}
+
+void lemlib::Chassis::endMotion() {
+    // move the "queue" forward 1
+    this->motionRunning = this->motionQueued;
+    this->motionQueued = false;
+
+    // permit queued motion to run
+    this->mutex.give();
+}
+
+void lemlib::Chassis::cancelMotion() {
+    this->motionRunning = false;
+    pros::delay(10); // give time for motion to stop
+}
+
+void lemlib::Chassis::cancelAllMotions() {
+    this->motionRunning = false;
+    this->motionQueued = false;
+    this->cancelAllCount++;
+    pros::delay(10); // give time for motion to stop
+}
+
+bool lemlib::Chassis::isInMotion() const { return this->motionRunning; }
@@ -0,0 +1,144 @@
+#include <cmath>
+#include "lemlib/chassis/ekf.hpp"
+#include "lemlib/field.hpp"
+
+namespace lemlib {
+namespace {
+// distance sensors don't see further than this, in inches
+constexpr float MAX_RANGE = 78;
+// step used to differentiate the distance sensor model numerically
+constexpr float POSITION_STEP = 0.05;
+constexpr float ANGLE_STEP = 0.002;
+
+/**
+ * @brief Wrap an angle to [-pi, pi]
+ */
+float wrap(float angle) { return std::remainder(angle, 2 * float(M_PI)); }
+
+/**
+ * @brief Predict what a distance sensor reads from a pose
+ */
+float expectedDistance(const Pose& pose, const Pose& offset) {
+    const float sinTheta = std::sin(pose.theta);
+    const float cosTheta = std::cos(pose.theta);
+    const float x = pose.x + offset.x * cosTheta + offset.y * sinTheta;
+    const float y = pose.y - offset.x * sinTheta + offset.y * cosTheta;
+    return rayCast(x, y, pose.theta + offset.theta, FIELD_WALLS, MAX_RANGE);
+}
+} // namespace
+
+Ekf::Ekf(const EkfSettings& settings)
+    : settings(settings),
+      pose(0, 0, 0) {
+    setPose(Pose(0, 0, 0), 0);
+}
+
+void Ekf::setPose(Pose pose, std::uint32_t time) {
+    this->pose = pose;
+    // the new pose is trusted, but not so much that the first measurements are ignored
+    covariance = {0.25, 0, 0, 0, 0.25, 0, 0, 0, 0.0003};
+    history[historyHead] = {time, pose};
+    historySize = 1;
+}
+
+Pose Ekf::getPose() const { return pose; }
+
+std::array<float, 9> Ekf::getCovariance() const { return covariance; }
+
+void Ekf::predict(float localX, float localY, float deltaTheta, std::uint32_t time) {
+    const float avgHeading = pose.theta + deltaTheta / 2;
+    const float sinHeading = std::sin(avgHeading);
+    const float cosHeading = std::cos(avgHeading);
+    pose.x += localY * sinHeading - localX * cosHeading;
+    pose.y += localY * cosHeading + localX * sinHeading;
+    pose.theta += deltaTheta;
+
+    // jacobian of the motion model with respect to the state, only the heading column isn't identity
+    const float dxdTheta = localY * cosHeading + localX * sinHeading;
+    const float dydTheta = -localY * sinHeading + localX * cosHeading;
+    std::array<float, 9>& p = covariance;
+    // P = F P F^T, expanded for F = [1 0 a; 0 1 b; 0 0 1]
+    const float p02 = p[2] + dxdTheta * p[8];
+    const float p12 = p[5] + dydTheta * p[8];
+    const float p00 = p[0] + 2 * dxdTheta * p[2] + dxdTheta * dxdTheta * p[8];
+    const float p01 = p[1] + dxdTheta * p[5] + dydTheta * p[2] + dxdTheta * dydTheta * p[8];
+    const float p11 = p[4] + 2 * dydTheta * p[5] + dydTheta * dydTheta * p[8];
+
+    // process noise grows with how far the robot moved and turned
+    const float distance = std::hypot(localX, localY);
+    const float translation = settings.translationNoise * distance;
+    const float rotation = settings.rotationNoise * std::fabs(deltaTheta) + settings.driftNoise * distance;
+    p = {p00 + translation * translation, p01, p02, p01, p11 + translation * translation, p12, p02, p12,
+         p[8] + rotation * rotation};
+
+    historyHead = (historyHead + 1) % history.size();
+    history[historyHead] = {time, pose};
+    if (historySize < history.size()) historySize++;
+}
+
+bool Ekf::update(float innovation, const std::array<float, 3>& h, float variance, std::size_t age) {
+    const std::array<float, 9>& p = covariance;
+    // P H^T
+    const std::array<float, 3> ph = {p[0] * h[0] + p[1] * h[1] + p[2] * h[2], p[3] * h[0] + p[4] * h[1] + p[5] * h[2],
+                                      p[6] * h[0] + p[7] * h[1] + p[8] * h[2]};
+    const float s = h[0] * ph[0] + h[1] * ph[1] + h[2] * ph[2] + variance;
+    if (innovation * innovation > settings.gate * settings.gate * s) return false;
+
+    const std::array<float, 3> gain = {ph[0] / s, ph[1] / s, ph[2] / s};
+    pose.x += gain[0] * innovation;
+    pose.y += gain[1] * innovation;
+    pose.theta += gain[2] * innovation;
+    // the estimates since the measurement was taken were off by the same amount. Delayed measurements
+    // after this one are compared against them, and would apply this correction again otherwise
+    for (std::size_t i = 0; i <= age; i++) {
+        Pose& past = history[(historyHead + history.size() - i) % history.size()].pose;
+        past.x += gain[0] * innovation;
+        past.y += gain[1] * innovation;
+        past.theta += gain[2] * innovation;
+    }
+    // P = P - K H P, and since P is symmetric H P = (P H^T)^T
+    for (int row = 0; row < 3; row++)
+        for (int col = 0; col < 3; col++) covariance[row * 3 + col] -= gain[row] * ph[col];
+    return true;
+}
+
+std::size_t Ekf::snapshotAt(std::uint32_t time) const {
+    // walk back from the newest estimate until one is at or before the time
+    for (std::size_t i = 0; i < historySize; i++) {
+        if (int32_t(snapshot(i).time - time) <= 0) return i;
+    }
+    return historySize - 1;
+}
+
+const Ekf::Snapshot& Ekf::snapshot(std::size_t age) const {
+    return history[(historyHead + history.size() - age) % history.size()];
+}
+
+bool Ekf::correctHeading(float theta, float noise, std::uint32_t time) {
+    const std::size_t age = snapshotAt(time);
+    return update(wrap(theta - snapshot(age).pose.theta), {0, 0, 1}, noise * noise, age);
+}
+
+bool Ekf::correctPosition(float x, float y, float noise, std::uint32_t time) {
+    const std::size_t age = snapshotAt(time);
+    // x and y are independent, so they can be applied one after the other. Either can pass the gate alone.
+    // The snapshot moves with the x correction, so y is compared against the corrected estimate
+    const bool xAccepted = update(x - snapshot(age).pose.x, {1, 0, 0}, noise * noise, age);
+    const bool yAccepted = update(y - snapshot(age).pose.y, {0, 1, 0}, noise * noise, age);
+    return xAccepted || yAccepted;
+}
+
+bool Ekf::correctDistance(const Pose& offset, float distance, std::uint32_t time) {
+    const std::size_t age = snapshotAt(time);
+    const Pose past = snapshot(age).pose;
+    const float expected = expectedDistance(past, offset);
+    if (expected >= MAX_RANGE) return false;
+    // the wall the ray hits changes the model, so differentiate it numerically
+    const std::array<float, 3> jacobian = {
+        (expectedDistance(Pose(past.x + POSITION_STEP, past.y, past.theta), offset) - expected) / POSITION_STEP,
+        (expectedDistance(Pose(past.x, past.y + POSITION_STEP, past.theta), offset) - expected) / POSITION_STEP,
+        (expectedDistance(Pose(past.x, past.y, past.theta + ANGLE_STEP), offset) - expected) / ANGLE_STEP};
+    const float noise = std::fmax(settings.distanceNoise * distance, settings.minDistanceNoise);
+    return update(distance - expected, jacobian, noise * noise, age);
+}
+} // namespace lemlib
@@ -0,0 +1,178 @@
+#include <cmath>
+#include "lemlib/chassis/mcl.hpp"
+#include "lemlib/field.hpp"
+
+namespace lemlib {
+namespace {
+// distance sensors don't see further than this, in inches
+constexpr float MAX_RANGE = 78;
+
+/**
+ * @brief Wrap an angle to [-pi, pi]
+ */
+float wrap(float angle) { return std::remainder(angle, 2 * float(M_PI)); }
+} // namespace
+
+Mcl::Mcl(const MclSettings& settings)
+    : settings(settings),
+      estimate(0, 0, 0),
+      x(settings.particles),
+      y(settings.particles),
+      theta(settings.particles),
+      weight(settings.particles, 1.0f / settings.particles),
+      sinTheta(settings.particles),
+      cosTheta(settings.particles),
+      rayX(settings.particles),
+      rayY(settings.particles),
+      rayDx(settings.particles),
+      rayDy(settings.particles),
+      expected(settings.particles),
+      resampledX(settings.particles),
+      resampledY(settings.particles),
+      resampledTheta(settings.particles) {}
+
+void Mcl::setPose(Pose pose) {
+    for (std::size_t i = 0; i < x.size(); i++) {
+        x[i] = pose.x + settings.initialSpread * unit(random);
+        y[i] = pose.y + settings.initialSpread * unit(random);
+        theta[i] = pose.theta + settings.initialHeadingSpread * unit(random);
+        weight[i] = 1.0f / x.size();
+    }
+    estimate = pose;
+    motionSinceCorrection = 0;
+    turnSinceCorrection = 0;
+}
+
+Pose Mcl::getPose() const { return estimate; }
+
+float Mcl::getEffectiveSize() const {
+    float sumSquares = 0;
+    for (float w : weight) sumSquares += w * w;
+    return 1 / sumSquares;
+}
+
+void Mcl::predict(float localX, float localY, float deltaTheta) {
+    // the noise grows with how far the robot moved and turned, like the odometry error does
+    const float distance = std::hypot(localX, localY);
+    const float translation = settings.translationNoise * distance;
+    const float rotation = settings.rotationNoise * std::fabs(deltaTheta) + settings.driftNoise * distance;
+    motionSinceCorrection += distance;
+    turnSinceCorrection += std::fabs(deltaTheta);
+    if (distance == 0 && deltaTheta == 0) return;
+
+    for (std::size_t i = 0; i < x.size(); i++) {
+        const float stepX = localX + translation * unit(random);
+        const float stepY = localY + translation * unit(random);
+        const float stepTheta = deltaTheta + rotation * unit(random);
+        const float avgHeading = theta[i] + stepTheta / 2;
+        const float sinHeading = std::sin(avgHeading);
+        const float cosHeading = std::cos(avgHeading);
+        x[i] += stepY * sinHeading - stepX * cosHeading;
+        y[i] += stepY * cosHeading + stepX * sinHeading;
+        theta[i] += stepTheta;
+    }
+    updateEstimate();
+}
+
+void Mcl::castRays(const Pose& offset) {
+    const std::size_t n = x.size();
+    const float sinOffset = std::sin(offset.theta);
+    const float cosOffset = std::cos(offset.theta);
+    // where the sensor is and where it points, for every particle
+    for (std::size_t i = 0; i < n; i++) {
+        rayX[i] = x[i] + offset.x * cosTheta[i] + offset.y * sinTheta[i];
+        rayY[i] = y[i] - offset.x * sinTheta[i] + offset.y * cosTheta[i];
+        rayDx[i] = sinTheta[i] * cosOffset + cosTheta[i] * sinOffset;
+        rayDy[i] = cosTheta[i] * cosOffset - sinTheta[i] * sinOffset;
+        expected[i] = MAX_RANGE;
+    }
+    // one wall at a time against every particle, so the inner loop has no branches
+    for (const Segment& segment : FIELD_WALLS) {
+        const float ex = segment.x2 - segment.x1;
+        const float ey = segment.y2 - segment.y1;
+        for (std::size_t i = 0; i < n; i++) {
+            // solve origin + t * direction = start + u * (end - start), see rayCast
+            const float denominator = rayDx[i] * ey - rayDy[i] * ex;
+            const float ox = segment.x1 - rayX[i];
+            const float oy = segment.y1 - rayY[i];
+            const float t = (ox * ey - oy * ex) / denominator;
+            const float u = (ox * rayDy[i] - oy * rayDx[i]) / denominator;
+            // a parallel wall divides by zero, which fails every comparison
+            const bool hit = t >= 0 && u >= 0 && u <= 1 && t < expected[i];
+            expected[i] = hit ? t : expected[i];
+        }
+    }
+}
+
+bool Mcl::correct(std::span<const Pose> offsets, std::span<const float> distances) {
+    if (motionSinceCorrection < settings.updateDistance && turnSinceCorrection < settings.updateAngle) return false;
+    const std::size_t n = x.size();
+    for (std::size_t i = 0; i < n; i++) {
+        sinTheta[i] = std::sin(theta[i]);
+        cosTheta[i] = std::cos(theta[i]);
+    }
+
+    bool used = false;
+    for (std::size_t sensor = 0; sensor < offsets.size() && sensor < distances.size(); sensor++) {
+        const float distance = distances[sensor];
+        if (std::isnan(distance)) continue;
+        castRays(offsets[sensor]);
+        // gaussian around the ray cast, with a floor for readings of things that aren't on the map
+        const float noise = std::fmax(settings.distanceNoise * distance, settings.minDistanceNoise);
+        const float scale = -0.5f / (noise * noise);
+        for (std::size_t i = 0; i < n; i++) {
+            const float error = distance - expected[i];
+            weight[i] *= std::exp(scale * error * error) + settings.outlierChance;
+        }
+        used = true;
+    }
+    if (!used) return false;
+    motionSinceCorrection = 0;
+    turnSinceCorrection = 0;
+
+    float sum = 0;
+    for (float w : weight) sum += w;
+    if (sum <= 0 || !std::isfinite(sum)) { // no particle is anywhere near, keep them and start over
+        for (float& w : weight) w = 1.0f / n;
+    } else {
+        for (float& w : weight) w /= sum;
+    }
+    if (getEffectiveSize() < settings.resampleThreshold * n) resample();
+    updateEstimate();
+    return true;
+}
+
+void Mcl::resample() {
+    // low variance resampling: one random number, then evenly spaced picks along the weights
+    const std::size_t n = x.size();
+    const float step = 1.0f / n;
+    float target = std::uniform_real_distribution<float>(0, step)(random);
+    float cumulative = weight[0];
+    std::size_t source = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        while (target > cumulative && source < n - 1) cumulative += weight[++source];
+        resampledX[i] = x[source];
+        resampledY[i] = y[source];
+        resampledTheta[i] = theta[source];
+        target += step;
+    }
+    x.swap(resampledX);
+    y.swap(resampledY);
+    theta.swap(resampledTheta);
+    for (float& w : weight) w = step;
+}
+
+void Mcl::updateEstimate() {
+    // headings aren't wrapped, so average them relative to the last estimate
+    const float reference = estimate.theta;
+    float meanX = 0;
+    float meanY = 0;
+    float meanTheta = 0;
+    for (std::size_t i = 0; i < x.size(); i++) {
+        meanX += weight[i] * x[i];
+        meanY += weight[i] * y[i];
+        meanTheta += weight[i] * wrap(theta[i] - reference);
+    }
+    estimate = Pose(meanX, meanY, reference + meanTheta);
+}
+} // namespace lemlib
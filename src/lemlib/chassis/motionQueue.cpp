@@ -0,0 +1,95 @@
+#include "lemlib/chassis/motionQueue.hpp"
+
+namespace lemlib {
+namespace {
+/**
+ * @brief Make a motion hand off to the next one, chaining it unless it already chains on its own
+ */
+template <typename Params> Params blend(Params params, bool chained, float minSpeed, float exitRange) {
+    params.handoff = chained;
+    if (!chained || params.minSpeed != 0) return params;
+    params.minSpeed = minSpeed;
+    if (params.earlyExitRange == 0) params.earlyExitRange = exitRange;
+    return params;
+}
+} // namespace
+
+MotionQueue::MotionQueue(Chassis& chassis, BlendSettings settings)
+    : chassis(chassis),
+      settings(settings) {}
+
+MotionQueue& MotionQueue::moveToPoint(float x, float y, int timeout, MoveToPointParams params) {
+    motions.push_back([=, this](bool chained) {
+        chassis.moveToPoint(x, y, timeout,
+                            blend(params, chained, settings.minSpeed, settings.lateralExitRange), false);
+    });
+    return *this;
+}
+
+MotionQueue& MotionQueue::moveToPose(float x, float y, float theta, int timeout, MoveToPoseParams params) {
+    motions.push_back([=, this](bool chained) {
+        chassis.moveToPose(x, y, theta, timeout,
+                           blend(params, chained, settings.minSpeed, settings.lateralExitRange), false);
+    });
+    return *this;
+}
+
+MotionQueue& MotionQueue::turnToHeading(float theta, int timeout, TurnToHeadingParams params) {
+    motions.push_back([=, this](bool chained) {
+        chassis.turnToHeading(theta, timeout, blend(params, chained, settings.minSpeed, settings.angularExitRange),
+                              false);
+    });
+    return *this;
+}
+
+MotionQueue& MotionQueue::turnToPoint(float x, float y, int timeout, TurnToPointParams params) {
+    motions.push_back([=, this](bool chained) {
+        chassis.turnToPoint(x, y, timeout, blend(params, chained, settings.minSpeed, settings.angularExitRange),
+                            false);
+    });
+    return *this;
+}
+
+MotionQueue& MotionQueue::swingToHeading(float theta, DriveSide lockedSide, int timeout,
+                                         SwingToHeadingParams params) {
+    motions.push_back([=, this](bool chained) {
+        chassis.swingToHeading(theta, lockedSide, timeout,
+                               blend(params, chained, settings.minSpeed, settings.angularExitRange), false);
+    });
+    return *this;
+}
+
+MotionQueue& MotionQueue::swingToPoint(float x, float y, DriveSide lockedSide, int timeout,
+                                       SwingToPointParams params) {
+    motions.push_back([=, this](bool chained) {
+        chassis.swingToPoint(x, y, lockedSide, timeout,
+                             blend(params, chained, settings.minSpeed, settings.angularExitRange), false);
+    });
+    return *this;
+}
+
+void MotionQueue::run(bool async) {
+    // if the function is async, run it in a new task
+    if (async) {
+        running = true;
+        pros::Task task([this]() { run(false); });
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+    running = true;
+    const std::uint32_t cancelAllCount = chassis.cancelAllCount;
+    for (std::size_t i = 0; i < motions.size(); i++) {
+        // cancelAllMotions stops the queue, cancelMotion only the current motion
+        if (chassis.cancelAllCount != cancelAllCount) break;
+        motions[i](i + 1 < motions.size());
+    }
+    running = false;
+}
+
+void MotionQueue::waitUntilDone() const {
+    do pros::delay(10);
+    while (running);
+}
+
+void MotionQueue::clear() { motions.clear(); }
+} // namespace lemlib
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/util.hpp"
+#include "pros/misc.hpp"
+
+namespace {
+/**
+ * @brief Fill in velocity and acceleration from positions, by central differences
+ *
+ * @param samples samples of one test
+ * @param positions position of each sample, in inches
+ */
+void differentiate(std::vector<lemlib::CharacterizationSample>& samples, const std::vector<float>& positions) {
+    const std::size_t size = samples.size();
+    const auto neighbors = [size](std::size_t i) { return std::pair(i == 0 ? 0 : i - 1, i + 1 == size ? i : i + 1); };
+    for (std::size_t i = 0; i < size; i++) {
+        const auto [before, after] = neighbors(i);
+        samples[i].velocity = (positions[after] - positions[before]) / (samples[after].time - samples[before].time);
+    }
+    for (std::size_t i = 0; i < size; i++) {
+        const auto [before, after] = neighbors(i);
+        samples[i].acceleration =
+            (samples[after].velocity - samples[before].velocity) / (samples[after].time - samples[before].time);
+    }
+}
+} // namespace
+
+std::optional<lemlib::DriveFeedforward> lemlib::Chassis::characterize(CharacterizeParams params) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return std::nullopt;
+
+    // measure each side with its own motors, the tracking wheels could be anywhere
+    TrackingWheel leftWheel(drivetrain.leftMotors, drivetrain.wheelDiameter, -drivetrain.trackWidth / 2,
+                            drivetrain.rpm);
+    TrackingWheel rightWheel(drivetrain.rightMotors, drivetrain.wheelDiameter, drivetrain.trackWidth / 2,
+                             drivetrain.rpm);
+    std::vector<CharacterizationSample> leftSamples;
+    std::vector<CharacterizationSample> rightSamples;
+    const std::uint32_t start = pros::millis();
+
+    // apply a voltage to both sides for a while, logging where each side is
+    const auto test = [&](const std::function<float(float)>& voltage, float duration) {
+        std::vector<CharacterizationSample> left;
+        std::vector<CharacterizationSample> right;
+        std::vector<float> leftPositions;
+        std::vector<float> rightPositions;
+        const std::uint32_t testStart = pros::millis();
+        std::uint32_t now = testStart;
+        while (this->motionRunning && now - testStart < duration * 1000) {
+            // through moveVoltage, so the gains are fit in the same nominal volts they are used in. Past
+            // what the battery can deliver the command is clamped, so log what was really applied
+            const float limit = voltageCompensation ? 12 / voltageCompensation->getScale() : 12;
+            const float applied = std::clamp(voltage((now - testStart) / 1000.0f), -limit, limit);
+            moveVoltage(applied, applied);
+            const float time = (now - start) / 1000.0f;
+            left.push_back({.time = time, .voltage = applied});
+            right.push_back({.time = time, .voltage = applied});
+            leftPositions.push_back(leftWheel.getDistanceTraveled());
+            rightPositions.push_back(rightWheel.getDistanceTraveled());
+            pros::Task::delay_until(&now, 10);
+        }
+        // come to a stop before the next test
+        drivetrain.leftMotors->move(0);
+        drivetrain.rightMotors->move(0);
+        pros::delay(1000);
+        differentiate(left, leftPositions);
+        differentiate(right, rightPositions);
+        leftSamples.insert(leftSamples.end(), left.begin(), left.end());
+        rightSamples.insert(rightSamples.end(), right.begin(), right.end());
+    };
+
+    // quasistatic forwards, then dynamic backwards, so the robot ends up near where it started
+    test([&](float time) { return params.rampRate * time; }, params.rampTime);
+    test([&](float) { return -params.stepVoltage; }, params.stepTime);
+
+    for (std::size_t i = 0; i < leftSamples.size(); i++) {
+        const CharacterizationSample& left = leftSamples[i];
+        const CharacterizationSample& right = rightSamples[i];
+        telemetrySink()->info("{},{},{},{},{},{},{}", left.time, left.voltage, left.velocity, left.acceleration,
+                              right.voltage, right.velocity, right.acceleration);
+    }
+
+    const std::optional<Feedforward> left = fitFeedforward(leftSamples);
+    const std::optional<Feedforward> right = fitFeedforward(rightSamples);
+    this->endMotion();
+    if (!left || !right) {
+        infoSink()->warn("Characterization failed, the drivetrain barely moved");
+        return std::nullopt;
+    }
+    infoSink()->info("Left kS: {}, kV: {}, kA: {}", left->kS, left->kV, left->kA);
+    infoSink()->info("Right kS: {}, kV: {}, kA: {}", right->kS, right->kV, right->kA);
+    return DriveFeedforward {*left, *right};
+}
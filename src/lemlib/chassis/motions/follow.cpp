@@ -0,0 +1,275 @@
+#include <cmath>
+#include <string>
+#include <vector>
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/pathCursor.hpp"
+#include "lemlib/util.hpp"
+#include "pros/misc.hpp"
+
+/**
+ * @brief function that returns elements in a file line, separated by a delimiter
+ *
+ * @param input the raw string
+ * @param delimiter string separating the elements in the line
+ * @return std::vector<std::string> array of elements read from the file
+ */
+std::vector<std::string> readElement(const std::string& input, const std::string& delimiter) {
+    std::string token;
+    std::string s = input;
+    std::vector<std::string> output;
+    size_t pos = 0;
+
+    // main loop
+    while ((pos = s.find(delimiter)) != std::string::npos) { // while there are still delimiters in the string
+        token = s.substr(0, pos); // processed substring
+        output.push_back(token);
+        s.erase(0, pos + delimiter.length()); // remove the read substring
+    }
+
+    output.push_back(s); // add the last element to the returned string
+
+    return output;
+}
+
+/**
+ * @brief parse the points of a path asset
+ *
+ * @param path the path asset, one "x, y, velocity" point per line, terminated by "endData"
+ * @return std::vector<lemlib::Pose> the points, with the velocity stored in theta
+ */
+std::vector<lemlib::Pose> getData(const asset& path) {
+    std::vector<lemlib::Pose> robotPath;
+    std::vector<std::string> pointInput;
+    lemlib::Pose pathPoint(0, 0, 0);
+
+    // format data from the asset
+    const std::string data(reinterpret_cast<char*>(path.buf), path.size);
+    std::vector<std::string> dataLines = readElement(data, "\n");
+
+    // read the points until 'endData' is read
+    for (std::string line : dataLines) {
+        lemlib::infoSink()->debug("read raw line {}", line);
+        if (line == "endData" || line == "endData\r") break;
+        pointInput = readElement(line, ", "); // parse line
+        // check if the line was read correctly
+        if (pointInput.size() != 3) {
+            lemlib::infoSink()->error("Failed to read path file! Are you using the right format? Raw line: {}", line);
+            break;
+        }
+        pathPoint.x = std::stof(pointInput.at(0)); // x position
+        pathPoint.y = std::stof(pointInput.at(1)); // y position
+        pathPoint.theta = std::stof(pointInput.at(2)); // velocity
+        robotPath.push_back(pathPoint); // save data
+        lemlib::infoSink()->debug("read point {}", pathPoint);
+    }
+
+    return robotPath;
+}
+
+/**
+ * @brief Get the curvature of a circle that intersects the robot and the lookahead point
+ *
+ * @param pos the position of the robot
+ * @param heading the heading of the robot
+ * @param lookahead the lookahead point
+ * @return float curvature
+ */
+float findLookaheadCurvature(lemlib::Pose pose, float heading, lemlib::Pose lookahead) {
+    // calculate whether the robot is on the left or right side of the circle
+    float side = lemlib::sgn(std::sin(heading) * (lookahead.x - pose.x) - std::cos(heading) * (lookahead.y - pose.y));
+    // calculate center point and radius
+    float a = -std::tan(heading);
+    float c = std::tan(heading) * pose.x - pose.y;
+    float x = std::fabs(a * lookahead.x + lookahead.y + c) / std::sqrt((a * a) + 1);
+    float d = std::hypot(lookahead.x - pose.x, lookahead.y - pose.y);
+
+    // return curvature
+    return side * ((2 * x) / (d * d));
+}
+
+void lemlib::Chassis::follow(const asset& path, float lookahead, int timeout, bool forwards, bool async) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([&]() { follow(path, lookahead, timeout, forwards, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    std::vector<lemlib::Pose> pathPoints = getData(path); // get list of path points
+    if (pathPoints.size() == 0) {
+        infoSink()->error("No points in path! Do you have the right format? Skipping motion");
+        // set distTraveled to -1 to indicate that the function has finished
+        distTraveled = -1;
+        // give the mutex back
+        this->endMotion();
+        return;
+    }
+    Pose pose = this->getPose(true);
+    Pose lastPose = pose;
+    PathCursor cursor(pathPoints, lookahead);
+    float curvature;
+    float targetVel;
+    const int compState = pros::competition::get_status();
+    distTraveled = 0;
+    actions.begin();
+
+    // loop until the robot is within the end tolerance
+    for (int i = 0; i < timeout / 10 && pros::competition::get_status() == compState && this->motionRunning; i++) {
+        // get the current position of the robot
+        pose = this->getPose(true);
+        if (!forwards) pose.theta -= M_PI;
+
+        // update completion vars
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        // find the closest point and the lookahead point, searching forwards from last tick
+        cursor.update(pose);
+        // if the robot is at the end of the path, then stop
+        if (pathPoints.at(cursor.getClosest()).theta == 0) break;
+
+        // get the curvature of the arc between the robot and the lookahead point
+        const float curvatureHeading = M_PI / 2 - pose.theta;
+        curvature = findLookaheadCurvature(pose, curvatureHeading, cursor.getLookahead());
+
+        // get the target velocity of the robot
+        targetVel = pathPoints.at(cursor.getClosest()).theta;
+
+        // calculate target left and right velocities
+        float targetLeftVel = targetVel * (2 + curvature * drivetrain.trackWidth) / 2;
+        float targetRightVel = targetVel * (2 - curvature * drivetrain.trackWidth) / 2;
+
+        // ratio the speeds to respect the max speed
+        const float ratio = std::max(std::fabs(targetLeftVel), std::fabs(targetRightVel)) / 127;
+        if (ratio > 1) {
+            targetLeftVel /= ratio;
+            targetRightVel /= ratio;
+        }
+
+        // move the drivetrain
+        if (forwards) {
+            moveDrivetrain(targetLeftVel, targetRightVel);
+        } else {
+            moveDrivetrain(-targetRightVel, -targetLeftVel);
+        }
+
+        // run the actions whose triggers were crossed this tick
+        updateActions(cursor.getDistance(pathPoints.size() - 1) - cursor.getDistance(cursor.getClosest()));
+
+        pros::delay(10);
+    }
+
+    // stop the robot
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    commandedPower = {0, 0};
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    actions.clear();
+    this->endMotion();
+}
+
+void lemlib::Chassis::followTrajectory(const asset& trajectory, float lookahead, int timeout, bool forwards,
+                                       bool async) {
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([&]() { followTrajectory(trajectory, lookahead, timeout, forwards, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    const std::optional<Trajectory> loaded = Trajectory::load(trajectory);
+    if (!loaded) {
+        infoSink()->error("Could not load trajectory! Skipping motion");
+        // set distTraveled to -1 to indicate that the function has finished
+        distTraveled = -1;
+        // give the mutex back
+        this->endMotion();
+        return;
+    }
+    const std::span<const TrajectorySample> samples = loaded->samples();
+    const int last = samples.size() - 1;
+    Pose pose = this->getPose(true);
+    Pose lastPose = pose;
+    PathCursor cursor(samples, lookahead);
+    const int compState = pros::competition::get_status();
+    // the sample the robot should be at by now. Time only moves forwards, so it does too
+    int timed = 0;
+    distTraveled = 0;
+    actions.begin();
+
+    // loop until the robot reaches the end of the trajectory
+    for (int i = 0; i < timeout / 10 && pros::competition::get_status() == compState && this->motionRunning; i++) {
+        // get the current position of the robot
+        pose = this->getPose(true);
+        if (!forwards) pose.theta -= M_PI;
+
+        // update completion vars
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        // find the closest sample and the lookahead point, searching forwards from last tick
+        cursor.update(pose);
+        const int closestPoint = cursor.getClosest();
+        // if the robot is at the end of the trajectory, then stop
+        if (closestPoint == last) break;
+
+        // get the curvature of the arc between the robot and the lookahead point
+        const float curvature = findLookaheadCurvature(pose, M_PI / 2 - pose.theta, cursor.getLookahead());
+
+        // the velocity planned where the robot is, or where it should be by now if that is faster.
+        // The trajectory starts at rest, so the planned time gets the robot moving
+        const float elapsed = i * 0.01;
+        while (timed < last && samples[timed + 1].time <= elapsed) timed++;
+        const int planned = samples[closestPoint].velocity > samples[timed].velocity ? closestPoint : timed;
+        const float targetVel = this->feedforward(samples[planned].velocity);
+        // the acceleration planned from that sample to the next, for the feedforward's kA and the MPC
+        const float dt = planned < last ? samples[planned + 1].time - samples[planned].time : 0;
+        const float acceleration = dt > 0 ? (samples[planned + 1].velocity - samples[planned].velocity) / dt : 0;
+
+        // calculate target left and right velocities and accelerations
+        float targetLeftVel = targetVel * (2 + curvature * drivetrain.trackWidth) / 2;
+        float targetRightVel = targetVel * (2 - curvature * drivetrain.trackWidth) / 2;
+        float leftAcceleration = acceleration * (2 + curvature * drivetrain.trackWidth) / 2;
+        float rightAcceleration = acceleration * (2 - curvature * drivetrain.trackWidth) / 2;
+
+        // ratio the speeds to respect the max speed
+        const float ratio = std::max(std::fabs(targetLeftVel), std::fabs(targetRightVel)) / 127;
+        if (ratio > 1) {
+            targetLeftVel /= ratio;
+            targetRightVel /= ratio;
+            leftAcceleration /= ratio;
+            rightAcceleration /= ratio;
+        }
+
+        // move the drivetrain
+        if (forwards) {
+            moveDrivetrain(targetLeftVel, targetRightVel, leftAcceleration, rightAcceleration);
+        } else {
+            moveDrivetrain(-targetRightVel, -targetLeftVel, -rightAcceleration, -leftAcceleration);
+        }
+
+        // run the actions whose triggers were crossed this tick
+        updateActions(loaded->length() - samples[closestPoint].distance);
+
+        pros::delay(10);
+    }
+
+    // stop the robot
+    drivetrain.leftMotors->move(0);
+    drivetrain.rightMotors->move(0);
+    commandedPower = {0, 0};
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    actions.clear();
+    this->endMotion();
+}
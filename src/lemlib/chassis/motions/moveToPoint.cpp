@@ -0,0 +1,170 @@
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "pros/misc.hpp"
+
+void lemlib::Chassis::moveToPoint(float x, float y, int timeout, MoveToPointParams params, bool async) {
+    params.earlyExitRange = fabs(params.earlyExitRange);
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // only once this motion owns the mutex, so the one before it still stops or hands off as it was told
+    handoff = params.handoff;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([&]() { moveToPoint(x, y, timeout, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+
+    // reset PIDs and exit conditions
+    lateralPID.reset();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    angularPID.reset();
+
+    // initialize vars used between iterations
+    Pose lastPose = getPose();
+    distTraveled = 0;
+    actions.begin();
+    Timer timer(timeout);
+    bool close = false;
+    // start from what the last motion was commanding, so a handoff doesn't dip. 0 if it stopped
+    float prevLateralOut = (commandedPower.first + commandedPower.second) / 2; // previous lateral power
+    float prevAngularOut = (commandedPower.first - commandedPower.second) / 2; // previous angular power
+    std::optional<bool> prevSide = std::nullopt;
+
+    // calculate target pose in standard form
+    Pose target(x, y);
+    target.theta = lastPose.angle(target);
+
+    // plan a profile along the line to the target, with maxSpeed scaling its top speed
+    std::optional<MotionProfile> profile = std::nullopt;
+    if (lateralProfile.maxVelocity > 0) {
+        ProfileConstraints constraints = lateralProfile;
+        constraints.maxVelocity *= std::fabs(params.maxSpeed) / 127;
+        const float distance = lastPose.distance(target);
+        profile.emplace(params.forwards ? distance : -distance, constraints);
+    }
+    const std::uint32_t startTime = pros::millis();
+
+    // main loop
+    while (!timer.isDone() && ((!lateralSmallExit.getExit() && !lateralLargeExit.getExit()) || !close) &&
+           this->motionRunning) {
+        // update position
+        const Pose pose = getPose(true, true);
+
+        // update distance traveled
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        // calculate distance to the target point
+        const float distTarget = pose.distance(target);
+
+        // check if the robot is close enough to the target to start settling
+        if (distTarget < 7.5 && close == false) {
+            close = true;
+            params.maxSpeed = fmax(fabs(prevLateralOut), 60);
+        }
+
+        // motion chaining
+        const bool side =
+            (pose.y - target.y) * -sin(target.theta) <= (pose.x - target.x) * cos(target.theta) + params.earlyExitRange;
+        if (prevSide == std::nullopt) prevSide = side;
+        const bool sameSide = side == prevSide;
+        // exit if close
+        if (!sameSide && params.minSpeed != 0) break;
+        prevSide = side;
+
+        // calculate error
+        const float adjustedRobotTheta = params.forwards ? pose.theta : pose.theta + M_PI;
+        const float angularError = close ? 0 : angleError(adjustedRobotTheta, pose.angle(target));
+        float lateralError = pose.distance(target) * cos(angleError(pose.theta, pose.angle(target)));
+
+        // exit a tick early if the robot would cross the exit line or overshoot before the next one
+        const float predictedLateral = lateralSmallExit.predict(lateralError, 10);
+        const bool crossing = fabs(lateralError) >= params.earlyExitRange && fabs(predictedLateral) < params.earlyExitRange;
+        if (params.minSpeed != 0 && (crossing || sgn(predictedLateral) != sgn(lateralError))) break;
+
+        // update exit conditions
+        lateralSmallExit.update(lateralError, lateralVelocity());
+        lateralLargeExit.update(lateralError);
+
+        // get output from PIDs
+        float lateralOut;
+        float lateralAcceleration = 0; // for the drivetrain's model, if there is one
+        if (profile) {
+            // feedforward drives the profile, PID corrects the distance from where it says to be
+            const ProfileState setpoint = profile->sample((pros::millis() - startTime) / 1000.0f);
+            const float profileRemaining = profile->getDistance() - setpoint.position;
+            // the drivetrain's own model replaces the profile's kA once there is one
+            const float kA = driveFeedforward ? 0 : lateralProfileKA;
+            if (driveFeedforward) lateralAcceleration = setpoint.acceleration;
+            lateralOut = feedforward(setpoint.velocity) + kA * setpoint.acceleration +
+                         lateralPID.update(lateralError - profileRemaining);
+        } else {
+            lateralOut = lateralPID.update(lateralError);
+        }
+        float angularOut = angularPID.update(radToDeg(angularError));
+
+        // apply restrictions on angular speed
+        angularOut = std::clamp(angularOut, -params.maxSpeed, params.maxSpeed);
+        angularOut = slew(angularOut, prevAngularOut, angularSettings.slew);
+
+        // apply restrictions on lateral speed
+        lateralOut = std::clamp(lateralOut, -params.maxSpeed, params.maxSpeed);
+        // constrain lateral output by max accel
+        // the profile already limits acceleration
+        if (!close && !profile) lateralOut = slew(lateralOut, prevLateralOut, lateralSettings.slew);
+
+        // prevent moving in the wrong direction
+        if (params.forwards && !close) lateralOut = std::fmax(lateralOut, 0);
+        else if (!params.forwards && !close) lateralOut = std::fmin(lateralOut, 0);
+
+        // constrain lateral output by the minimum speed
+        if (params.forwards && lateralOut < fabs(params.minSpeed) && lateralOut > 0) lateralOut = fabs(params.minSpeed);
+        if (!params.forwards && -lateralOut < fabs(params.minSpeed) && lateralOut < 0)
+            lateralOut = -fabs(params.minSpeed);
+
+        // update previous output
+        prevAngularOut = angularOut;
+        prevLateralOut = lateralOut;
+
+        infoSink()->debug("Angular Out: {}, Lateral Out: {}", angularOut, lateralOut);
+
+        // ratio the speeds to respect the max speed
+        float leftPower = lateralOut + angularOut;
+        float rightPower = lateralOut - angularOut;
+        const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / params.maxSpeed;
+        if (ratio > 1) {
+            leftPower /= ratio;
+            rightPower /= ratio;
+            lateralAcceleration /= ratio;
+        }
+
+        // move the drivetrain
+        moveDrivetrain(leftPower, rightPower, lateralAcceleration, lateralAcceleration);
+
+        // run the actions whose triggers were crossed this tick
+        updateActions(distTarget);
+
+        // delay to save resources
+        pros::delay(10);
+    }
+
+    // stop the drivetrain, unless a queued motion carries on from here
+    if (!handoff || !this->motionRunning) {
+        drivetrain.leftMotors->move(0);
+        drivetrain.rightMotors->move(0);
+        commandedPower = {0, 0};
+    }
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    actions.clear();
+    this->endMotion();
+}
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <cmath>
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+
+void lemlib::Chassis::moveToPoseRamsete(float x, float y, float theta, int timeout, MoveToPoseParams params) {
+    // fill in the constraints that weren't set, and slow down for maxSpeed
+    TrajectoryConstraints constraints = ramseteConstraints;
+    if (constraints.maxVelocity == 0)
+        constraints.maxVelocity = lateralProfile.maxVelocity != 0 ? lateralProfile.maxVelocity : 0.8 * freeSpeed();
+    if (constraints.maxAcceleration == 0)
+        constraints.maxAcceleration =
+            lateralProfile.maxAcceleration != 0 ? lateralProfile.maxAcceleration : 2 * freeSpeed();
+    if (constraints.trackWidth == 0) constraints.trackWidth = drivetrain.trackWidth;
+    constraints.maxVelocity *= std::clamp(params.maxSpeed, 0.0f, 127.0f) / 127;
+
+    // plan the trajectory along the direction of travel, which is the back of the robot when reversing
+    Pose start = getPose(true);
+    Pose end(x, y, degToRad(theta));
+    if (!params.forwards) {
+        start.theta += M_PI;
+        end.theta += M_PI;
+    }
+    const std::vector<TrajectorySample> samples = generateTrajectory(start, end, params.lead, constraints);
+    const int last = samples.size() - 1;
+    const float duration = samples.back().time;
+    Pose target(x, y, M_PI_2 - degToRad(theta));
+    if (!params.forwards) target.theta = fmod(target.theta + M_PI, 2 * M_PI);
+
+    // reset PIDs and exit conditions, which settle the robot on the target once the trajectory is over
+    lateralPID.reset();
+    lateralLargeExit.reset();
+    lateralSmallExit.reset();
+    angularPID.reset();
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+
+    // initialize vars used between iterations
+    Pose lastPose = getPose();
+    distTraveled = 0;
+    actions.begin();
+    Timer timer(timeout);
+    int index = 0;
+    bool lateralSettled = false;
+
+    // main loop
+    while (!timer.isDone() && (!lateralSettled || (!angularLargeExit.getExit() && !angularSmallExit.getExit())) &&
+           this->motionRunning) {
+        // update position
+        Pose pose = getPose(true, true);
+
+        // update distance traveled
+        distTraveled += pose.distance(lastPose);
+        lastPose = pose;
+
+        // calculate distance to the target point
+        const float distTarget = pose.distance(target);
+
+        // exit when close enough if another motion follows
+        const float elapsed = timer.getTimePassed() / 1000.0;
+        if (params.minSpeed != 0 && (distTarget < params.earlyExitRange || elapsed >= duration)) break;
+        if (!params.forwards) pose.theta += M_PI;
+
+        // once the trajectory is over, settle on the target with the PIDs, like moveToPose does
+        if (elapsed >= duration) {
+            if (lateralLargeExit.getExit() && lateralSmallExit.getExit()) lateralSettled = true;
+            const float angularError = angleError(pose.theta, target.theta);
+            float lateralError = distTarget * cos(angleError(pose.theta, pose.angle(target)));
+            if (!params.forwards) lateralError = -lateralError;
+            lateralSmallExit.update(lateralError, lateralVelocity());
+            lateralLargeExit.update(lateralError);
+            angularSmallExit.update(radToDeg(angularError), angularVelocity());
+            angularLargeExit.update(radToDeg(angularError));
+            const float lateralOut = std::clamp(lateralPID.update(lateralError), -params.maxSpeed, params.maxSpeed);
+            const float angularOut =
+                std::clamp(angularPID.update(radToDeg(angularError)), -params.maxSpeed, params.maxSpeed);
+            moveDrivetrain(lateralOut + angularOut, lateralOut - angularOut);
+            updateActions(distTarget);
+            pros::delay(10);
+            continue;
+        }
+
+        // interpolate where the trajectory is now
+        while (index < last - 1 && samples[index + 1].time <= elapsed) index++;
+        const TrajectorySample& a = samples[index];
+        const TrajectorySample& b = samples[index + 1];
+        const float dt = b.time - a.time;
+        const float t = dt > 0 ? std::clamp((elapsed - a.time) / dt, 0.0f, 1.0f) : 1;
+        const float velocity = a.velocity + (b.velocity - a.velocity) * t;
+        const float acceleration = dt > 0 ? (b.velocity - a.velocity) / dt : 0;
+        const float curvature = a.curvature + (b.curvature - a.curvature) * t;
+        // headings in standard form. The trajectory's curvature is positive clockwise
+        const Pose reference(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t,
+                             M_PI_2 - (a.heading + angleError(b.heading, a.heading) * t));
+
+        // get the velocity and turn rate that bring the robot back onto the trajectory
+        const auto [linear, angular] = ramsete.calculate(pose, reference, velocity, -velocity * curvature);
+
+        infoSink()->debug("linear: {} angular: {}", linear, angular);
+
+        // convert to wheel velocities and accelerations, then the velocities to power
+        const float angularAcceleration = -acceleration * curvature;
+        float leftPower = feedforward(linear - angular * drivetrain.trackWidth / 2);
+        float rightPower = feedforward(linear + angular * drivetrain.trackWidth / 2);
+        float leftAcceleration = acceleration - angularAcceleration * drivetrain.trackWidth / 2;
+        float rightAcceleration = acceleration + angularAcceleration * drivetrain.trackWidth / 2;
+
+        // ratio the speeds to respect the max speed
+        const float ratio = std::max(std::fabs(leftPower), std::fabs(rightPower)) / params.maxSpeed;
+        if (ratio > 1) {
+            leftPower /= ratio;
+            rightPower /= ratio;
+            leftAcceleration /= ratio;
+            rightAcceleration /= ratio;
+        }
+
+        // move the drivetrain. Reversing swaps the sides, since the back of the robot leads
+        if (params.forwards) moveDrivetrain(leftPower, rightPower, leftAcceleration, rightAcceleration);
+        else moveDrivetrain(-rightPower, -leftPower, -rightAcceleration, -leftAcceleration);
+
+        // run the actions whose triggers were crossed this tick
+        updateActions(distTarget);
+
+        // delay to save resources
+        pros::delay(10);
+    }
+
+    // stop the drivetrain, unless a queued motion carries on from here
+    if (!handoff || !this->motionRunning) {
+        drivetrain.leftMotors->move(0);
+        drivetrain.rightMotors->move(0);
+        commandedPower = {0, 0};
+    }
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    actions.clear();
+    this->endMotion();
+}
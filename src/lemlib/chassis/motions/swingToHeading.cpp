@@ -0,0 +1,120 @@
+#include <cmath>
+#include <optional>
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "pros/misc.hpp"
+
+void lemlib::Chassis::swingToHeading(float theta, DriveSide lockedSide, int timeout, SwingToHeadingParams params,
+                                     bool async) {
+    params.minSpeed = fabs(params.minSpeed);
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // only once this motion owns the mutex, so the one before it still stops or hands off as it was told
+    handoff = params.handoff;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([&]() { swingToHeading(theta, lockedSide, timeout, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+    float targetTheta;
+    float deltaTheta;
+    float motorPower;
+    // start from what the last motion was commanding the swinging side, so a handoff doesn't dip
+    float prevMotorPower = lockedSide == DriveSide::LEFT ? -commandedPower.second : commandedPower.first;
+    float startTheta = getPose().theta;
+    bool settling = false;
+    std::optional<float> prevRawDeltaTheta = std::nullopt;
+    std::optional<float> prevDeltaTheta = std::nullopt;
+    distTraveled = 0;
+    actions.begin();
+    Timer timer(timeout);
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    angularPID.reset();
+    // hold the locked side in place for the duration of the swing
+    pros::MotorGroup* lockedMotors = lockedSide == DriveSide::LEFT ? drivetrain.leftMotors : drivetrain.rightMotors;
+    const pros::MotorBrake brakeMode = lockedMotors->get_brake_mode();
+    lockedMotors->set_brake_mode_all(pros::E_MOTOR_BRAKE_HOLD);
+
+    // main loop
+    while (!timer.isDone() && !angularLargeExit.getExit() && !angularSmallExit.getExit() && this->motionRunning) {
+        // update variables
+        Pose pose = getPose();
+
+        // update completion vars
+        distTraveled = fabs(angleError(pose.theta, startTheta, false));
+
+        targetTheta = theta;
+
+        // check if settling
+        const float rawDeltaTheta = angleError(targetTheta, pose.theta, false);
+        if (prevRawDeltaTheta == std::nullopt) prevRawDeltaTheta = rawDeltaTheta;
+        if (sgn(rawDeltaTheta) != sgn(prevRawDeltaTheta.value())) settling = true;
+        prevRawDeltaTheta = rawDeltaTheta;
+
+        // calculate deltaTheta
+        if (settling) deltaTheta = angleError(targetTheta, pose.theta, false);
+        else deltaTheta = angleError(targetTheta, pose.theta, false, params.direction);
+        if (prevDeltaTheta == std::nullopt) prevDeltaTheta = deltaTheta;
+
+        // motion chaining
+        if (params.minSpeed != 0 && fabs(deltaTheta) < params.earlyExitRange) break;
+        if (params.minSpeed != 0 && sgn(deltaTheta) != sgn(prevDeltaTheta.value())) break;
+        // or a tick early, if the robot would get there or overshoot before the next one
+        const float predictedDeltaTheta = angularSmallExit.predict(deltaTheta, 10);
+        if (params.minSpeed != 0 &&
+            (fabs(predictedDeltaTheta) < params.earlyExitRange || sgn(predictedDeltaTheta) != sgn(deltaTheta)))
+            break;
+        prevDeltaTheta = deltaTheta;
+
+        // calculate the speed
+        motorPower = angularPID.update(deltaTheta);
+        angularLargeExit.update(deltaTheta);
+        angularSmallExit.update(deltaTheta, angularVelocity());
+
+        // cap the speed
+        if (motorPower > params.maxSpeed) motorPower = params.maxSpeed;
+        else if (motorPower < -params.maxSpeed) motorPower = -params.maxSpeed;
+        if (fabs(deltaTheta) > 20) motorPower = slew(motorPower, prevMotorPower, angularSettings.slew);
+        if (motorPower < 0 && motorPower > -params.minSpeed) motorPower = -params.minSpeed;
+        else if (motorPower > 0 && motorPower < params.minSpeed) motorPower = params.minSpeed;
+        prevMotorPower = motorPower;
+
+        infoSink()->debug("Swing Motor Power: {} ", motorPower);
+
+        // move the drivetrain, scaled by the battery voltage
+        const float power = voltageCompensation ? voltageCompensation->compensate(motorPower) : motorPower;
+        if (lockedSide == DriveSide::LEFT) {
+            drivetrain.rightMotors->move(-power);
+            drivetrain.leftMotors->brake();
+            commandedPower = {0, -motorPower};
+        } else {
+            drivetrain.leftMotors->move(power);
+            drivetrain.rightMotors->brake();
+            commandedPower = {motorPower, 0};
+        }
+
+        // run the actions whose triggers were crossed this tick
+        updateActions(fabs(deltaTheta));
+
+        pros::delay(10);
+    }
+
+    // stop the drivetrain, unless a queued motion carries on from here, and restore the brake mode
+    // of the locked side
+    lockedMotors->set_brake_mode_all(brakeMode);
+    if (!handoff || !this->motionRunning) {
+        drivetrain.leftMotors->move(0);
+        drivetrain.rightMotors->move(0);
+        commandedPower = {0, 0};
+    }
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    actions.clear();
+    this->endMotion();
+}
@@ -0,0 +1,127 @@
+#include <cmath>
+#include <optional>
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/logger/logger.hpp"
+#include "lemlib/timer.hpp"
+#include "lemlib/util.hpp"
+#include "pros/misc.hpp"
+
+void lemlib::Chassis::turnToHeading(float theta, int timeout, TurnToHeadingParams params, bool async) {
+    params.minSpeed = fabs(params.minSpeed);
+    this->requestMotionStart();
+    // were all motions cancelled?
+    if (!this->motionRunning) return;
+    // only once this motion owns the mutex, so the one before it still stops or hands off as it was told
+    handoff = params.handoff;
+    // if the function is async, run it in a new task
+    if (async) {
+        pros::Task task([&]() { turnToHeading(theta, timeout, params, false); });
+        this->endMotion();
+        pros::delay(10); // delay to give the task time to start
+        return;
+    }
+    float targetTheta;
+    float deltaTheta;
+    float motorPower;
+    // start from what the last motion was commanding, so a handoff doesn't dip. 0 if it stopped
+    float prevMotorPower = (commandedPower.first - commandedPower.second) / 2;
+    float startTheta = getPose().theta;
+    bool settling = false;
+    std::optional<float> prevRawDeltaTheta = std::nullopt;
+    std::optional<float> prevDeltaTheta = std::nullopt;
+    distTraveled = 0;
+    actions.begin();
+    Timer timer(timeout);
+    angularLargeExit.reset();
+    angularSmallExit.reset();
+    angularPID.reset();
+
+    // plan a profile over the whole turn, with maxSpeed scaling its top speed
+    std::optional<MotionProfile> profile = std::nullopt;
+    if (angularProfile.maxVelocity > 0) {
+        ProfileConstraints constraints = angularProfile;
+        constraints.maxVelocity *= std::fabs(params.maxSpeed) / 127.0f;
+        profile.emplace(angleError(theta, startTheta, false, params.direction), constraints);
+    }
+    const std::uint32_t startTime = pros::millis();
+
+    // main loop
+    while (!timer.isDone() && !angularLargeExit.getExit() && !angularSmallExit.getExit() && this->motionRunning) {
+        // update variables
+        Pose pose = getPose();
+
+        // update completion vars
+        distTraveled = fabs(angleError(pose.theta, startTheta, false));
+
+        targetTheta = theta;
+
+        // check if settling
+        const float rawDeltaTheta = angleError(targetTheta, pose.theta, false);
+        if (prevRawDeltaTheta == std::nullopt) prevRawDeltaTheta = rawDeltaTheta;
+        if (sgn(rawDeltaTheta) != sgn(prevRawDeltaTheta.value())) settling = true;
+        prevRawDeltaTheta = rawDeltaTheta;
+
+        // calculate deltaTheta
+        if (settling) deltaTheta = angleError(targetTheta, pose.theta, false);
+        else deltaTheta = angleError(targetTheta, pose.theta, false, params.direction);
+        if (prevDeltaTheta == std::nullopt) prevDeltaTheta = deltaTheta;
+
+        // motion chaining
+        if (params.minSpeed != 0 && fabs(deltaTheta) < params.earlyExitRange) break;
+        if (params.minSpeed != 0 && sgn(deltaTheta) != sgn(prevDeltaTheta.value())) break;
+        // or a tick early, if the robot would get there or overshoot before the next one
+        const float predictedDeltaTheta = angularSmallExit.predict(deltaTheta, 10);
+        if (params.minSpeed != 0 &&
+            (fabs(predictedDeltaTheta) < params.earlyExitRange || sgn(predictedDeltaTheta) != sgn(deltaTheta)))
+            break;
+        prevDeltaTheta = deltaTheta;
+
+        // calculate the speed
+        float wheelAcceleration = 0; // for the drivetrain's model, if there is one
+        if (profile) {
+            // feedforward drives the profile, PID corrects the angle from where it says to be
+            const ProfileState setpoint = profile->sample((pros::millis() - startTime) / 1000.0f);
+            const float profileRemaining = profile->getDistance() - setpoint.position;
+            const float wheelVelocity = degToRad(setpoint.velocity) * drivetrain.trackWidth / 2;
+            // the drivetrain's own model replaces the profile's kA once there is one
+            const float kA = driveFeedforward ? 0 : angularProfileKA;
+            if (driveFeedforward) wheelAcceleration = degToRad(setpoint.acceleration) * drivetrain.trackWidth / 2;
+            motorPower = feedforward(wheelVelocity) + kA * setpoint.acceleration +
+                         angularPID.update(deltaTheta - profileRemaining);
+        } else {
+            motorPower = angularPID.update(deltaTheta);
+        }
+        angularLargeExit.update(deltaTheta);
+        angularSmallExit.update(deltaTheta, angularVelocity());
+
+        // cap the speed. A capped speed isn't accelerating any more
+        if (fabs(motorPower) > params.maxSpeed) wheelAcceleration = 0;
+        if (motorPower > params.maxSpeed) motorPower = params.maxSpeed;
+        else if (motorPower < -params.maxSpeed) motorPower = -params.maxSpeed;
+        if (fabs(deltaTheta) > 20 && !profile) motorPower = slew(motorPower, prevMotorPower, angularSettings.slew);
+        if (motorPower < 0 && motorPower > -params.minSpeed) motorPower = -params.minSpeed;
+        else if (motorPower > 0 && motorPower < params.minSpeed) motorPower = params.minSpeed;
+        prevMotorPower = motorPower;
+
+        infoSink()->debug("Turn Motor Power: {} ", motorPower);
+
+        // move the drivetrain
+        moveDrivetrain(motorPower, -motorPower, wheelAcceleration, -wheelAcceleration);
+
+        // run the actions whose triggers were crossed this tick
+        updateActions(fabs(deltaTheta));
+
+        pros::delay(10);
+    }
+
+    // stop the drivetrain, unless a queued motion carries on from here
+    if (!handoff || !this->motionRunning) {
+        drivetrain.leftMotors->move(0);
+        drivetrain.rightMotors->move(0);
+        commandedPower = {0, 0};
+    }
+    // set distTraveled to -1 to indicate that the function has finished
+    distTraveled = -1;
+    actions.clear();
+    this->endMotion();
+}
@@ -0,0 +1,550 @@
+// The implementation below is mostly based off of
+// the document written by 5225A (Pilons)
+// Here is a link to the original document
+// http://thepilons.ca/wp-content/uploads/2018/10/Tracking.pdf
+
+#include <math.h>
+#include <atomic>
+#include <cmath>
+#include <optional>
+#include "pros/rtos.hpp"
+#include "lemlib/seqlock.hpp"
+#include "lemlib/trig.hpp"
+#include "lemlib/util.hpp"
+#include "lemlib/chassis/odom.hpp"
+#include "lemlib/chassis/chassis.hpp"
+#include "lemlib/chassis/trackingWheel.hpp"
+
+// tracking thread
+pros::Task* trackingTask = nullptr;
+// how often the tracking thread updates odometry, in milliseconds
+constexpr std::uint32_t ODOM_PERIOD = 10;
+
+// global variables
+lemlib::OdomSensors odomSensors(nullptr, nullptr, nullptr, nullptr, nullptr); // the sensors to be used for odometry
+lemlib::Drivetrain drive(nullptr, nullptr, 0, 0, 0, 0); // the drivetrain to be used for odometry
+lemlib::Pose odomPose(0, 0, 0); // the pose of the robot
+lemlib::Pose odomSpeed(0, 0, 0); // the speed of the robot
+lemlib::Pose odomLocalSpeed(0, 0, 0); // the local speed of the robot
+std::uint32_t odomTime = 0; // when the sensors behind odomPose were sampled
+
+/**
+ * @brief Everything odometry publishes to other tasks
+ */
+struct OdomState {
+        lemlib::Pose pose;
+        lemlib::Pose speed;
+        lemlib::Pose localSpeed;
+        std::uint32_t time;
+};
+
+// the variables above belong to whichever task holds odomMutex, other tasks read this copy of them
+lemlib::SeqLock<OdomState> odomState({odomPose, odomSpeed, odomLocalSpeed, odomTime});
+// only taken by tasks that change the pose, so reading it never waits
+pros::Mutex odomMutex;
+// every pose odometry published recently, for measurements that arrive late
+lemlib::PoseHistory poseHistory;
+
+float prevVertical = 0;
+float prevVertical1 = 0;
+float prevVertical2 = 0;
+float prevHorizontal = 0;
+float prevHorizontal1 = 0;
+float prevHorizontal2 = 0;
+float prevImu = 0;
+
+// extended Kalman filter, only used once enabled
+lemlib::Ekf ekf;
+lemlib::EkfSensors ekfSensors;
+lemlib::EkfSettings ekfSettings;
+std::vector<std::uint32_t> ekfDistanceSampled; // when each distance sensor's last fused reading was taken
+std::uint32_t ekfGpsSampled = 0; // when the last fused GPS reading was taken
+bool ekfEnabled = false;
+float imuOffset = 0; // difference between the IMU rotation and the filtered heading
+bool imuOffsetValid = false;
+// particle filter, only created once enabled
+lemlib::Mcl* mcl = nullptr;
+std::vector<lemlib::MclDistanceSensor> mclSensors;
+std::vector<lemlib::Pose> mclOffsets; // sensor offsets with theta in radians
+std::vector<float> mclDistances; // latest readings in inches, reused every update
+std::vector<std::uint32_t> mclSampled; // when each sensor's reading in the last correction was taken
+std::vector<std::uint32_t> mclReadTimes; // when each sensor's latest reading was taken, reused every update
+bool mclEnabled = false;
+// device readings published by the acquisition task, if odometry is reading from one
+// atomic so control loops can see which one without waiting on odomMutex
+std::atomic<const lemlib::SensorScheduler*> odomScheduler = nullptr;
+lemlib::SensorFrame sensorFrame; // the frame this update reads, only touched by the odometry task
+bool useFrame = false;
+std::uint32_t prevSampleTime = 0;
+bool primed = false; // whether the previous sensor values have been read
+
+void lemlib::setSensors(lemlib::OdomSensors sensors, lemlib::Drivetrain drivetrain) {
+    odomSensors = sensors;
+    drive = drivetrain;
+}
+
+/**
+ * @brief Let other tasks see the current pose and speeds
+ *
+ * Must be called with odomMutex held
+ */
+void publish() { odomState.store({odomPose, odomSpeed, odomLocalSpeed, odomTime}); }
+
+void lemlib::setSensorScheduler(const SensorScheduler* scheduler) {
+    // between updates, so an update reads every sensor one way or the other
+    odomMutex.take();
+    odomScheduler = scheduler;
+    odomMutex.give();
+}
+
+const lemlib::SensorScheduler* lemlib::getSensorScheduler() { return odomScheduler; }
+
+/**
+ * @brief Read a tracking wheel, from the sensor frame if there is one
+ *
+ * @param timestamp set to when the distance was measured. nullptr reads the wheel the way
+ * horizontal wheels always have, without a timestamp
+ */
+float readWheel(lemlib::TrackingWheel* wheel, std::uint32_t* timestamp) {
+    if (useFrame) return wheel->getDistanceTraveled(sensorFrame, timestamp);
+    if (timestamp == nullptr) return wheel->getDistanceTraveled();
+    return wheel->getDistanceTraveled(timestamp);
+}
+
+/**
+ * @brief Read a distance sensor if it has a reading that hasn't been used yet
+ *
+ * Distance sensors refresh every 30 ms, slower than odometry updates. A reading from the sensor
+ * frame is new when the scheduler read it after the last one used. A direct read can't tell, so it
+ * counts as new once the sensor has had time to refresh
+ *
+ * @param sampled when the last reading used was taken, in milliseconds. Set to when this one was
+ * @param confidence set to the confidence of the reading, from 0 to 63
+ * @return std::optional<std::int32_t> distance in mm, std::nullopt if there is no new reading
+ */
+std::optional<std::int32_t> readNewDistance(pros::Distance* sensor, std::uint32_t* sampled,
+                                            std::int32_t* confidence) {
+    constexpr std::uint32_t DISTANCE_PERIOD = 30;
+    const std::uint8_t port = sensor->get_port();
+    if (useFrame && sensorFrame.has(port)) {
+        if (sensorFrame.sampled[port - 1] == *sampled) return std::nullopt;
+        *sampled = sensorFrame.sampled[port - 1];
+        const lemlib::DistanceSample& sample = sensorFrame.distance(port);
+        *confidence = sample.confidence;
+        return sample.distance;
+    }
+    const std::uint32_t now = pros::millis();
+    if (now - *sampled < DISTANCE_PERIOD) return std::nullopt;
+    *sampled = now;
+    const std::int32_t distance = sensor->get();
+    *confidence = sensor->get_confidence();
+    return distance;
+}
+
+/**
+ * @brief Check whether the GPS has a reading that hasn't been used yet
+ *
+ * The GPS reports every 20 ms by default, slower than odometry updates. It isn't read by the sensor
+ * scheduler, so like a direct distance read, a reading counts as new once the GPS has had time to refresh
+ *
+ * @param sampled when the last reading used was taken, in milliseconds. Set to when this one was
+ * @return true if there is a new reading
+ */
+bool gpsRefreshed(std::uint32_t* sampled) {
+    constexpr std::uint32_t GPS_PERIOD = 20;
+    const std::uint32_t now = pros::millis();
+    if (now - *sampled < GPS_PERIOD) return false;
+    *sampled = now;
+    return true;
+}
+
+lemlib::Pose lemlib::getPose(bool radians) { return getPose(radians, nullptr); }
+
+lemlib::Pose lemlib::getPose(bool radians, std::uint32_t* timestamp) {
+    // one load, so the pose and its timestamp come from the same update
+    const OdomState state = odomState.load();
+    if (timestamp != nullptr) *timestamp = state.time;
+    if (radians) return state.pose;
+    else return lemlib::Pose(state.pose.x, state.pose.y, radToDeg(state.pose.theta));
+}
+
+void lemlib::setPose(lemlib::Pose pose, bool radians) {
+    odomMutex.take();
+    if (radians) odomPose = pose;
+    else odomPose = lemlib::Pose(pose.x, pose.y, degToRad(pose.theta));
+    ekf.setPose(odomPose, odomTime);
+    imuOffsetValid = false;
+    if (mcl != nullptr) mcl->setPose(odomPose);
+    // the old poses are in a different frame now
+    poseHistory.clear();
+    poseHistory.record(odomTime, odomPose);
+    publish();
+    odomMutex.give();
+}
+
+std::optional<lemlib::Pose> lemlib::getPoseAt(std::uint32_t time, bool radians) {
+    odomMutex.take();
+    std::optional<Pose> pose = poseHistory.at(time);
+    odomMutex.give();
+    if (pose && !radians) pose->theta = radToDeg(pose->theta);
+    return pose;
+}
+
+bool lemlib::correctPose(Pose pose, std::uint32_t time, bool radians) {
+    if (!radians) pose.theta = degToRad(pose.theta);
+    odomMutex.take();
+    const std::optional<Pose> corrected = poseHistory.correct(time, pose);
+    if (corrected) {
+        odomPose = *corrected;
+        ekf.setPose(odomPose, odomTime);
+        imuOffsetValid = false;
+        if (mcl != nullptr) mcl->setPose(odomPose);
+        publish();
+    }
+    odomMutex.give();
+    return corrected.has_value();
+}
+
+void lemlib::enableEkf(const EkfSensors& sensors, const EkfSettings& settings) {
+    odomMutex.take();
+    ekfSensors = sensors;
+    ekfSettings = settings;
+    ekfDistanceSampled.assign(sensors.distanceSensors.size(), 0);
+    ekfGpsSampled = 0;
+    ekf = Ekf(settings);
+    ekf.setPose(odomPose, odomTime);
+    imuOffsetValid = false;
+    ekfEnabled = true;
+    mclEnabled = false;
+    odomMutex.give();
+}
+
+void lemlib::disableEkf() {
+    odomMutex.take();
+    ekfEnabled = false;
+    odomMutex.give();
+}
+
+void lemlib::enableMcl(const std::vector<MclDistanceSensor>& sensors, const MclSettings& settings) {
+    odomMutex.take();
+    delete mcl;
+    mcl = new Mcl(settings);
+    mcl->setPose(odomPose);
+    mclSensors = sensors;
+    mclOffsets.clear();
+    for (const MclDistanceSensor& sensor : sensors)
+        mclOffsets.emplace_back(sensor.offset.x, sensor.offset.y, degToRad(sensor.offset.theta));
+    mclDistances.assign(sensors.size(), NAN);
+    mclSampled.assign(sensors.size(), 0);
+    mclReadTimes.assign(sensors.size(), 0);
+    ekfEnabled = false;
+    mclEnabled = true;
+    odomMutex.give();
+}
+
+void lemlib::disableMcl() {
+    odomMutex.take();
+    mclEnabled = false;
+    odomMutex.give();
+}
+
+/**
+ * @brief Correct the EKF with every sensor that has a measurement
+ *
+ * @param imuRaw IMU rotation in radians
+ * @param fuseImu whether to correct with the IMU, false if it already drove the prediction
+ * @param time when the odometry sensors were sampled
+ */
+void fuseSensors(float imuRaw, bool fuseImu, std::uint32_t time) {
+    constexpr float INCHES_PER_METER = 39.3701;
+    constexpr float INCHES_PER_MM = 1 / 25.4;
+
+    // the IMU measures rotation from wherever it was calibrated, so line it up with the filter first
+    if (odomSensors.imu != nullptr && fuseImu) {
+        if (!imuOffsetValid) {
+            imuOffset = ekf.getPose().theta - imuRaw;
+            imuOffsetValid = true;
+        }
+        ekf.correctHeading(imuRaw + imuOffset, ekfSettings.imuNoise, time);
+    }
+
+    // like distance readings, each GPS reading is fused once
+    if (ekfSensors.gps != nullptr && gpsRefreshed(&ekfGpsSampled)) {
+        const pros::gps_status_s_t status = ekfSensors.gps->get_position_and_orientation();
+        const float error = ekfSensors.gps->get_error() * INCHES_PER_METER;
+        const float heading = ekfSensors.gps->get_heading();
+        // the GPS reports PROS_ERR_F while it can't see the field code
+        if (std::isfinite(status.x) && std::isfinite(status.y) && std::isfinite(error)) {
+            const std::uint32_t gpsTime = ekfGpsSampled - ekfSensors.gpsLatency;
+            ekf.correctPosition(status.x * INCHES_PER_METER, status.y * INCHES_PER_METER,
+                                std::fmax(error, ekfSettings.gpsNoise), gpsTime);
+            if (std::isfinite(heading)) {
+                ekf.correctHeading(lemlib::degToRad(heading), ekfSettings.gpsHeadingNoise, gpsTime);
+            }
+        }
+    }
+
+    // each reading is fused once, dated by when it was taken. Fusing it again every update would make
+    // the filter several times too sure of it
+    for (std::size_t i = 0; i < ekfSensors.distanceSensors.size(); i++) {
+        const lemlib::EkfDistanceSensor& sensor = ekfSensors.distanceSensors[i];
+        std::int32_t confidence;
+        const std::optional<std::int32_t> distance =
+            readNewDistance(sensor.sensor, &ekfDistanceSampled[i], &confidence);
+        if (!distance) continue;
+        // 9999 means nothing is in range. Confidence is only reported past 200 mm
+        if (*distance <= 0 || *distance >= 2000) continue;
+        if (*distance > 200 && confidence < 32) continue;
+        const lemlib::Pose offset(sensor.offset.x, sensor.offset.y, lemlib::degToRad(sensor.offset.theta));
+        ekf.correctDistance(offset, *distance * INCHES_PER_MM, ekfDistanceSampled[i] - sensor.latency);
+    }
+}
+
+/**
+ * @brief Weigh the particles with every distance sensor that has a reading new since the last correction
+ *
+ * Weighing them with the same reading again would narrow the particles down on the same evidence
+ */
+void localize() {
+    constexpr float INCHES_PER_MM = 1 / 25.4;
+    for (std::size_t i = 0; i < mclSensors.size(); i++) {
+        std::int32_t confidence;
+        mclReadTimes[i] = mclSampled[i];
+        const std::int32_t distance = readNewDistance(mclSensors[i].sensor, &mclReadTimes[i], &confidence).value_or(0);
+        // 9999 means nothing is in range. Confidence is only reported past 200 mm
+        const bool valid = distance > 0 && distance < 2000 && (distance <= 200 || confidence >= 32);
+        mclDistances[i] = valid ? distance * INCHES_PER_MM : NAN;
+    }
+    // the filter waits until the robot has moved far enough, so a reading is only used up once it corrects
+    if (mcl->correct(mclOffsets, mclDistances)) mclSampled = mclReadTimes;
+}
+
+lemlib::Pose lemlib::getSpeed(bool radians) {
+    const Pose speed = odomState.load().speed;
+    if (radians) return speed;
+    else return lemlib::Pose(speed.x, speed.y, radToDeg(speed.theta));
+}
+
+lemlib::Pose lemlib::getLocalSpeed(bool radians) {
+    const Pose localSpeed = odomState.load().localSpeed;
+    if (radians) return localSpeed;
+    else return lemlib::Pose(localSpeed.x, localSpeed.y, radToDeg(localSpeed.theta));
+}
+
+lemlib::Pose lemlib::estimatePose(float time, bool radians) {
+    // get current position and speed, from the same update
+    const OdomState state = odomState.load();
+    Pose curPose = state.pose;
+    Pose localSpeed = state.localSpeed;
+    // calculate the change in local position
+    Pose deltaLocalPose = localSpeed * time;
+
+    // calculate the future pose
+    const float avgHeading = curPose.theta + deltaLocalPose.theta / 2;
+    Pose futurePose = curPose;
+    futurePose.x += deltaLocalPose.y * sin(avgHeading);
+    futurePose.y += deltaLocalPose.y * cos(avgHeading);
+    futurePose.x += deltaLocalPose.x * -cos(avgHeading);
+    futurePose.y += deltaLocalPose.x * sin(avgHeading);
+    if (!radians) futurePose.theta = radToDeg(futurePose.theta);
+
+    return futurePose;
+}
+
+lemlib::Pose lemlib::integrateArc(const Pose& pose, float arcX, float arcY, float deltaHeading, Pose* chord) {
+    // the chord of an arc through angle a is its length times sin(a / 2) / (a / 2)
+    const float scale = fastSinc(deltaHeading / 2);
+    const float localX = arcX * scale;
+    const float localY = arcY * scale;
+    if (chord != nullptr) *chord = Pose(localX, localY, deltaHeading);
+    // the chord points along the heading halfway through the arc
+    const auto [sinHeading, cosHeading] = fastSinCos(pose.theta + deltaHeading / 2);
+    return Pose(pose.x + localY * sinHeading - localX * cosHeading, pose.y + localY * cosHeading + localX * sinHeading,
+                pose.theta + deltaHeading);
+}
+
+/**
+ * @brief Integrate the latest sensor readings into the pose. Must be called with odomMutex held
+ */
+void integrate() {
+    // get the current sensor values, along with when they were sampled
+    float vertical1Raw = 0;
+    float vertical2Raw = 0;
+    float horizontal1Raw = 0;
+    float horizontal2Raw = 0;
+    float imuRaw = 0;
+    std::uint32_t vertical1Time = pros::millis();
+    std::uint32_t vertical2Time = vertical1Time;
+    if (odomSensors.vertical1 != nullptr) vertical1Raw = readWheel(odomSensors.vertical1, &vertical1Time);
+    if (odomSensors.vertical2 != nullptr) vertical2Raw = readWheel(odomSensors.vertical2, &vertical2Time);
+    if (odomSensors.horizontal1 != nullptr) horizontal1Raw = readWheel(odomSensors.horizontal1, nullptr);
+    if (odomSensors.horizontal2 != nullptr) horizontal2Raw = readWheel(odomSensors.horizontal2, nullptr);
+    if (odomSensors.imu != nullptr) {
+        const std::uint8_t port = odomSensors.imu->get_port();
+        const double rotation =
+            useFrame && sensorFrame.has(port) ? sensorFrame.imu(port).rotation : odomSensors.imu->get_rotation();
+        imuRaw = lemlib::degToRad(rotation);
+    }
+
+    // calculate the change in sensor values
+    float deltaVertical1 = vertical1Raw - prevVertical1;
+    float deltaVertical2 = vertical2Raw - prevVertical2;
+    float deltaHorizontal1 = horizontal1Raw - prevHorizontal1;
+    float deltaHorizontal2 = horizontal2Raw - prevHorizontal2;
+    float deltaImu = imuRaw - prevImu;
+
+    // the first read only sets the previous values, raw motor positions count from power on
+    if (!primed) deltaVertical1 = deltaVertical2 = deltaHorizontal1 = deltaHorizontal2 = deltaImu = 0;
+
+    // update the previous sensor values
+    prevVertical1 = vertical1Raw;
+    prevVertical2 = vertical2Raw;
+    prevHorizontal1 = horizontal1Raw;
+    prevHorizontal2 = horizontal2Raw;
+    prevImu = imuRaw;
+
+    // calculate the heading of the robot
+    // Priority:
+    // 1. Horizontal tracking wheels
+    // 2. Vertical tracking wheels
+    // 3. Inertial Sensor
+    // 4. Drivetrain
+    float heading = odomPose.theta;
+    bool headingFromImu = false;
+    // calculate the heading using the horizontal tracking wheels
+    if (odomSensors.horizontal1 != nullptr && odomSensors.horizontal2 != nullptr)
+        heading -= (deltaHorizontal1 - deltaHorizontal2) /
+                   (odomSensors.horizontal1->getOffset() - odomSensors.horizontal2->getOffset());
+    // else, if both vertical tracking wheels aren't substituted by the drivetrain, use them
+    else if (odomSensors.vertical1 != nullptr && odomSensors.vertical2 != nullptr &&
+             !odomSensors.vertical1->getType() && !odomSensors.vertical2->getType())
+        heading -= (deltaVertical1 - deltaVertical2) /
+                   (odomSensors.vertical1->getOffset() - odomSensors.vertical2->getOffset());
+    // else, if the inertial sensor exists, use it
+    else if (odomSensors.imu != nullptr) {
+        heading += deltaImu;
+        headingFromImu = true;
+    }
+    // else, use the the substituted tracking wheels
+    else if (odomSensors.vertical1 != nullptr && odomSensors.vertical2 != nullptr)
+        heading -= (deltaVertical1 - deltaVertical2) /
+                   (odomSensors.vertical1->getOffset() - odomSensors.vertical2->getOffset());
+    float deltaHeading = heading - odomPose.theta;
+
+    // choose tracking wheels to use
+    // Prioritize non-powered tracking wheels
+    lemlib::TrackingWheel* verticalWheel = nullptr;
+    lemlib::TrackingWheel* horizontalWheel = nullptr;
+    if (!odomSensors.vertical1->getType()) verticalWheel = odomSensors.vertical1;
+    else if (!odomSensors.vertical2->getType()) verticalWheel = odomSensors.vertical2;
+    else verticalWheel = odomSensors.vertical1;
+    if (odomSensors.horizontal1 != nullptr) horizontalWheel = odomSensors.horizontal1;
+    else if (odomSensors.horizontal2 != nullptr) horizontalWheel = odomSensors.horizontal2;
+    // reuse the values read above, so every wheel is sampled once per update
+    float rawVertical = verticalWheel == odomSensors.vertical2 ? vertical2Raw : vertical1Raw;
+    float rawHorizontal = horizontalWheel == odomSensors.horizontal2 ? horizontal2Raw : horizontal1Raw;
+    const std::uint32_t sampleTime = verticalWheel == odomSensors.vertical2 ? vertical2Time : vertical1Time;
+    float horizontalOffset = 0;
+    float verticalOffset = 0;
+    if (verticalWheel != nullptr) verticalOffset = verticalWheel->getOffset();
+    if (horizontalWheel != nullptr) horizontalOffset = horizontalWheel->getOffset();
+
+    // calculate change in x and y
+    float deltaX = 0;
+    float deltaY = 0;
+    if (verticalWheel != nullptr && primed) deltaY = rawVertical - prevVertical;
+    if (horizontalWheel != nullptr && primed) deltaX = rawHorizontal - prevHorizontal;
+    prevVertical = rawVertical;
+    prevHorizontal = rawHorizontal;
+    // time between this sample and the last one, which isn't always the loop period
+    const float dt = primed ? (sampleTime - prevSampleTime) / 1000.0f : 0;
+    prevSampleTime = sampleTime;
+    primed = true;
+
+    // save previous pose
+    lemlib::Pose prevPose = odomPose;
+
+    // the wheels are off the tracking center, so they also roll while the robot turns in place
+    lemlib::Pose chord(0, 0, 0);
+    odomPose = lemlib::integrateArc(odomPose, deltaX + horizontalOffset * deltaHeading,
+                                    deltaY + verticalOffset * deltaHeading, deltaHeading, &chord);
+    odomPose.theta = heading;
+    odomTime = sampleTime;
+    const float localX = chord.x;
+    const float localY = chord.y;
+
+    // the odometry step becomes the filter's prediction
+    if (ekfEnabled) {
+        // the filter corrects with the IMU, so the same reading can't also be its prediction. Predict
+        // the heading from the vertical wheels instead, the drive encoders if that's what they are
+        float predictedHeading = deltaHeading;
+        bool fuseImu = true;
+        if (headingFromImu && odomSensors.vertical1 != nullptr && odomSensors.vertical2 != nullptr) {
+            predictedHeading = -(deltaVertical1 - deltaVertical2) /
+                               (odomSensors.vertical1->getOffset() - odomSensors.vertical2->getOffset());
+        } else if (headingFromImu) {
+            fuseImu = false;
+        }
+        // the wheels' turning terms and the arc come from the heading change too, so rebuild the chord
+        // from the predicted one. Otherwise the translation still depends on the IMU
+        lemlib::Pose predictedChord = chord;
+        if (fuseImu && headingFromImu) {
+            lemlib::integrateArc(prevPose, deltaX + horizontalOffset * predictedHeading,
+                                 deltaY + verticalOffset * predictedHeading, predictedHeading, &predictedChord);
+        }
+        ekf.predict(predictedChord.x, predictedChord.y, predictedHeading, sampleTime);
+        fuseSensors(imuRaw, fuseImu, sampleTime);
+        odomPose = ekf.getPose();
+    }
+
+    // or move the particles, and weigh them against the field
+    if (mclEnabled) {
+        mcl->predict(localX, localY, deltaHeading);
+        localize();
+        odomPose = mcl->getPose();
+    }
+
+    // the encoders haven't been sampled since the last update, so there is no new speed
+    if (dt <= 0) return;
+
+    // calculate speed
+    odomSpeed.x = lemlib::ema((odomPose.x - prevPose.x) / dt, odomSpeed.x, 0.95);
+    odomSpeed.y = lemlib::ema((odomPose.y - prevPose.y) / dt, odomSpeed.y, 0.95);
+    odomSpeed.theta = lemlib::ema((odomPose.theta - prevPose.theta) / dt, odomSpeed.theta, 0.95);
+
+    // calculate local speed
+    odomLocalSpeed.x = lemlib::ema(localX / dt, odomLocalSpeed.x, 0.95);
+    odomLocalSpeed.y = lemlib::ema(localY / dt, odomLocalSpeed.y, 0.95);
+    odomLocalSpeed.theta = lemlib::ema(deltaHeading / dt, odomLocalSpeed.theta, 0.95);
+}
+
+void lemlib::update() {
+    odomMutex.take();
+    // every sensor this update reads comes from one frame, if there is an acquisition task
+    const lemlib::SensorScheduler* scheduler = odomScheduler;
+    useFrame = scheduler != nullptr && scheduler->isRunning();
+    // odometry needs every device from the same pass, so it copies the whole frame, into its own storage
+    if (useFrame) scheduler->getFrame(sensorFrame);
+    integrate();
+    poseHistory.record(odomTime, odomPose);
+    publish();
+    odomMutex.give();
+}
+
+void lemlib::init() {
+    if (trackingTask == nullptr) {
+        // delay_until keeps the period fixed no matter how long update() takes, and the high
+        // priority stops motion and user tasks from delaying a sample. Starting on a multiple of the
+        // period lines it up with the sensor scheduler's ticks, so each update reads a fresh frame
+        trackingTask = new pros::Task(
+            [=] {
+                std::uint32_t now = (pros::millis() + ODOM_PERIOD - 1) / ODOM_PERIOD * ODOM_PERIOD;
+                pros::delay(now - pros::millis());
+                while (true) {
+                    update();
+                    pros::Task::delay_until(&now, ODOM_PERIOD);
+                }
+            },
+            TASK_PRIORITY_MAX - 2, TASK_STACK_DEPTH_DEFAULT, "LemLib Odometry");
+    }
+}
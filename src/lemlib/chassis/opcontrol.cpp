@@ -0,0 +1,58 @@
+#include <cmath>
+#include "lemlib/chassis/chassis.hpp"
+
+void lemlib::Chassis::tank(int left, int right, bool disableDriveCurve) {
+    // If drive curve is disabled, use the raw input
+    if (disableDriveCurve) {
+        movePower(left, right);
+    } else {
+        movePower(throttleCurve->curve(left), throttleCurve->curve(right));
+    }
+}
+
+void lemlib::Chassis::arcade(int throttle, int turn, bool disableDriveCurve, float desaturateBias) {
+    // use drive curves if they are enabled
+    if (!disableDriveCurve) {
+        throttle = throttleCurve->curve(throttle);
+        turn = steerCurve->curve(turn);
+    }
+
+    // desaturate motors based on joyBias
+    if (std::abs(throttle) + std::abs(turn) > 127) {
+        const int oldThrottle = throttle;
+        const int oldTurn = turn;
+        throttle *= (1 - desaturateBias * std::abs(oldTurn / 127.0));
+        turn *= (1 - (1 - desaturateBias) * std::abs(oldThrottle / 127.0));
+    }
+
+    const float leftPower = throttle + turn;
+    const float rightPower = throttle - turn;
+
+    movePower(leftPower, rightPower);
+}
+
+void lemlib::Chassis::curvature(int throttle, int turn, bool disableDriveCurve) {
+    // If we're not moving forwards change to arcade drive
+    if (throttle == 0) {
+        arcade(throttle, turn, disableDriveCurve);
+        return;
+    }
+
+    // use drive curves if they are enabled
+    if (!disableDriveCurve) {
+        throttle = throttleCurve->curve(throttle);
+        turn = steerCurve->curve(turn);
+    }
+
+    float leftPower = throttle + (std::abs(throttle) * turn) / 127.0;
+    float rightPower = throttle - (std::abs(throttle) * turn) / 127.0;
+
+    // normalize the outputs so the ratio between the sides is kept
+    const float maxPower = std::max(std::abs(leftPower), std::abs(rightPower));
+    if (maxPower > 127) {
+        leftPower = 127.0 * leftPower / maxPower;
+        rightPower = 127.0 * rightPower / maxPower;
+    }
+
+    movePower(leftPower, rightPower);
+}
@@ -0,0 +1,114 @@
+#include <cmath>
+#include <utility>
+#include "lemlib/chassis/poseHistory.hpp"
+
+namespace lemlib {
+namespace {
+/**
+ * @brief Get sin(x) / x and (1 - cos(x)) / x, without dividing by zero near a straight line
+ */
+std::pair<float, float> arcFactors(float x) {
+    if (std::fabs(x) < 1e-4f) return {1 - x * x / 6, x / 2};
+    return {std::sin(x) / x, (1 - std::cos(x)) / x};
+}
+} // namespace
+
+Pose relativePose(const Pose& from, const Pose& to) {
+    const float dx = to.x - from.x;
+    const float dy = to.y - from.y;
+    const float sinTheta = std::sin(from.theta);
+    const float cosTheta = std::cos(from.theta);
+    return Pose(dx * cosTheta - dy * sinTheta, dx * sinTheta + dy * cosTheta, to.theta - from.theta);
+}
+
+Pose composePose(const Pose& from, const Pose& motion) {
+    const float sinTheta = std::sin(from.theta);
+    const float cosTheta = std::cos(from.theta);
+    return Pose(from.x + motion.x * cosTheta + motion.y * sinTheta, from.y - motion.x * sinTheta + motion.y * cosTheta,
+                from.theta + motion.theta);
+}
+
+Pose interpolatePose(const Pose& from, const Pose& to, float t) {
+    const Pose motion = relativePose(from, to);
+    // a turn of theta along an arc moves the robot by V(theta) times the straight line motion
+    // [forwards, left] = [a -b; b a] [v, w], where a, b = arcFactors(theta) and left turns are positive
+    const float turn = -motion.theta;
+    const auto [a, b] = arcFactors(turn);
+    const float forwards = motion.y;
+    const float left = -motion.x;
+    const float scale = 1 / (a * a + b * b);
+    const float v = (a * forwards + b * left) * scale;
+    const float w = (a * left - b * forwards) * scale;
+    // then go t of the way along the same arc
+    const auto [at, bt] = arcFactors(turn * t);
+    const float partForwards = t * (at * v - bt * w);
+    const float partLeft = t * (bt * v + at * w);
+    return composePose(from, Pose(-partLeft, partForwards, motion.theta * t));
+}
+
+void PoseHistory::record(std::uint32_t time, const Pose& pose) {
+    if (count > 0 && int32_t(time - get(count - 1).time) <= 0) {
+        get(count - 1) = {time, pose};
+        return;
+    }
+    if (count < CAPACITY) {
+        count++;
+    } else {
+        head = (head + 1) % CAPACITY;
+    }
+    get(count - 1) = {time, pose};
+}
+
+void PoseHistory::clear() {
+    head = 0;
+    count = 0;
+}
+
+std::size_t PoseHistory::size() const { return count; }
+
+std::optional<std::uint32_t> PoseHistory::oldest() const {
+    if (count == 0) return std::nullopt;
+    return get(0).time;
+}
+
+std::optional<std::uint32_t> PoseHistory::newest() const {
+    if (count == 0) return std::nullopt;
+    return get(count - 1).time;
+}
+
+const PoseHistory::Entry& PoseHistory::get(std::size_t index) const { return entries[(head + index) % CAPACITY]; }
+
+PoseHistory::Entry& PoseHistory::get(std::size_t index) { return entries[(head + index) % CAPACITY]; }
+
+std::size_t PoseHistory::lowerBound(std::uint32_t time) const {
+    std::size_t low = 0;
+    std::size_t high = count;
+    while (low < high) {
+        const std::size_t middle = (low + high) / 2;
+        if (int32_t(get(middle).time - time) < 0) low = middle + 1;
+        else high = middle;
+    }
+    return low;
+}
+
+std::optional<Pose> PoseHistory::at(std::uint32_t time) const {
+    const std::size_t after = lowerBound(time);
+    if (after == count) return std::nullopt; // newer than every pose
+    const Entry& next = get(after);
+    if (next.time == time) return next.pose;
+    if (after == 0) return std::nullopt; // older than every pose
+    const Entry& previous = get(after - 1);
+    return interpolatePose(previous.pose, next.pose, float(time - previous.time) / float(next.time - previous.time));
+}
+
+std::optional<Pose> PoseHistory::correct(std::uint32_t time, const Pose& pose) {
+    const std::optional<Pose> past = at(time);
+    if (!past) return std::nullopt;
+    // replay the motion recorded since the time on top of the corrected pose
+    for (std::size_t i = lowerBound(time); i < count; i++) {
+        Entry& entry = get(i);
+        entry.pose = composePose(pose, relativePose(*past, entry.pose));
+    }
+    return get(count - 1).pose;
+}
+} // namespace lemlib
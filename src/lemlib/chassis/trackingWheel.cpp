@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <math.h>
+#include "lemlib/chassis/trackingWheel.hpp"
+#include "lemlib/motorGroup.hpp"
+#include "lemlib/util.hpp"
+#include "pros/abstract_motor.hpp"
+#include "pros/rtos.hpp"
+
+using namespace lemlib;
+
+lemlib::TrackingWheel::TrackingWheel(pros::adi::Encoder* encoder, float wheelDiameter, float distance,
+                                     float gearRatio) {
+    this->encoder = encoder;
+    this->diameter = wheelDiameter;
+    this->distance = distance;
+    this->gearRatio = gearRatio;
+}
+
+lemlib::TrackingWheel::TrackingWheel(pros::Rotation* encoder, float wheelDiameter, float distance, float gearRatio) {
+    this->rotation = encoder;
+    this->diameter = wheelDiameter;
+    this->distance = distance;
+    this->gearRatio = gearRatio;
+}
+
+lemlib::TrackingWheel::TrackingWheel(pros::MotorGroup* motors, float wheelDiameter, float distance, float rpm) {
+    this->motors = motors;
+    this->motors->set_encoder_units_all(pros::MotorEncoderUnits::rotations);
+    this->diameter = wheelDiameter;
+    this->distance = distance;
+    this->rpm = rpm;
+}
+
+void lemlib::TrackingWheel::reset() {
+    if (this->encoder != nullptr) this->encoder->reset();
+    if (this->rotation != nullptr) this->rotation->reset_position();
+    if (this->motors != nullptr) {
+        this->motors->tare_position_all();
+        this->rawMotorOffset = this->getRawMotorDistance(nullptr);
+    }
+}
+
+float lemlib::TrackingWheel::getDistanceTraveled() {
+    if (this->encoder != nullptr) {
+        return (float(this->encoder->get_value()) * this->diameter * M_PI / 360) / this->gearRatio;
+    } else if (this->rotation != nullptr) {
+        return (float(this->rotation->get_position()) * this->diameter * M_PI / 36000) / this->gearRatio;
+    } else if (this->motors != nullptr) {
+        // get distance traveled by each motor
+        MotorGroupBuffer<pros::MotorGears> gearsetBuffer;
+        MotorGroupBuffer<double> positionBuffer;
+        const std::span<pros::MotorGears> gearsets = getGearings(*this->motors, gearsetBuffer);
+        const std::span<double> positions = getPositions(*this->motors, positionBuffer);
+        if (positions.empty()) return 0;
+        float total = 0;
+        for (std::size_t i = 0; i < positions.size(); i++)
+            total += positions[i] * (diameter * M_PI) * (rpm / cartridgeRpm(gearsets[i]));
+        return total / positions.size();
+    } else {
+        return 0;
+    }
+}
+
+float lemlib::TrackingWheel::getDistanceTraveled(std::uint32_t* timestamp) {
+    if (this->motors != nullptr) return this->getRawMotorDistance(timestamp) - this->rawMotorOffset;
+    if (timestamp != nullptr) *timestamp = pros::millis();
+    return this->getDistanceTraveled();
+}
+
+float lemlib::TrackingWheel::getDistanceTraveled(const SensorFrame& frame, std::uint32_t* timestamp) {
+    if (this->rotation != nullptr && frame.has(this->rotation->get_port())) {
+        if (timestamp != nullptr) *timestamp = frame.sampled[this->rotation->get_port() - 1];
+        return (float(frame.rotation(this->rotation->get_port()).position) * this->diameter * M_PI / 36000) /
+               this->gearRatio;
+    }
+    if (this->motors != nullptr) {
+        float total = 0;
+        std::uint32_t oldest = UINT32_MAX;
+        const std::size_t count = this->motors->size();
+        for (std::size_t i = 0; i < count; i++) {
+            const std::int8_t port = this->motors->get_port(i);
+            if (!frame.has(port)) return this->getDistanceTraveled(timestamp);
+            const MotorSample& sample = frame.motor(port);
+            const float rotations = sample.rawPosition / ticksPerRev(sample.gearing);
+            total += rotations * (diameter * M_PI) * (rpm / cartridgeRpm(sample.gearing));
+            oldest = std::min(oldest, sample.positionTime);
+        }
+        if (count == 0) return 0;
+        if (timestamp != nullptr) *timestamp = oldest;
+        return total / count - this->rawMotorOffset;
+    }
+    return this->getDistanceTraveled(timestamp);
+}
+
+float lemlib::TrackingWheel::getRawMotorDistance(std::uint32_t* timestamp) {
+    MotorGroupBuffer<pros::MotorGears> gearsetBuffer;
+    MotorGroupBuffer<std::int32_t> tickBuffer;
+    const std::span<pros::MotorGears> gearsets = getGearings(*this->motors, gearsetBuffer);
+    const std::span<std::int32_t> ticks = getRawPositions(*this->motors, tickBuffer, timestamp);
+    if (ticks.empty()) return 0;
+    float total = 0;
+    for (std::size_t i = 0; i < ticks.size(); i++) {
+        const float rotations = ticks[i] / ticksPerRev(gearsets[i]);
+        total += rotations * (diameter * M_PI) * (rpm / cartridgeRpm(gearsets[i]));
+    }
+    return total / ticks.size();
+}
+
+float lemlib::TrackingWheel::getOffset() { return this->distance; }
+
+int lemlib::TrackingWheel::getType() {
+    if (this->motors != nullptr) return 1;
+    return 0;
+}
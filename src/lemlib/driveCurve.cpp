@@ -0,0 +1,30 @@
+#include <cmath>
+#include "lemlib/driveCurve.hpp"
+
+lemlib::ExpoDriveCurve::ExpoDriveCurve(float deadband, float minOutput, float curve)
+    : deadband(deadband),
+      minOutput(minOutput),
+      curveGain(curve) {}
+
+float lemlib::ExpoDriveCurve::curve(float input) {
+    // return 0 if input is within deadzone
+    if (std::abs(input) <= deadband) return 0;
+    // g is the output of g(x) as defined in the Desmos graph
+    const float g = std::abs(input) - deadband;
+    // g127 is the output of g(127) as defined in the Desmos graph
+    const float g127 = 127 - deadband;
+    // i is the output of i(x) as defined in the Desmos graph
+    const float i = std::pow(curveGain, g - 127) * g * std::copysign(1, input);
+    // i127 is the output of i(127) as defined in the Desmos graph
+    const float i127 = std::pow(curveGain, g127 - 127) * g127;
+    return (127.0 - minOutput) / (127) * i * 127 / i127 + minOutput * std::copysign(1, input);
+}
+
+lemlib::LookupDriveCurve::LookupDriveCurve(DriveCurve& curve)
+    : table(makeCurveTable([&](float input) { return curve.curve(input); })) {}
+
+float lemlib::LookupDriveCurve::curve(float input) {
+    // round to the nearest whole input, and keep within the table
+    const int index = int(input + (input < 0 ? -0.5f : 0.5f)) + 128;
+    return table[index < 0 ? 0 : index > 255 ? 255 : index];
+}
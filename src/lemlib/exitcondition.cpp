@@ -0,0 +1,48 @@
+#include <cmath>
+#include "pros/rtos.hpp"
+#include "lemlib/exitcondition.hpp"
+
+namespace lemlib {
+ExitCondition::ExitCondition(const float range, const int time, const float settleVelocity)
+    : range(range),
+      time(time),
+      settleVelocity(settleVelocity) {}
+
+bool ExitCondition::getExit() { return done; }
+
+bool ExitCondition::update(const float input) {
+    const int curTime = pros::millis();
+    // track how fast the input changes, for settling and prediction
+    if (lastTime != -1 && curTime > lastTime) rate = (input - lastInput) / (curTime - lastTime) * 1000;
+    lastInput = input;
+    lastTime = curTime;
+
+    if (std::fabs(input) > range) startTime = -1;
+    else if (startTime == -1) startTime = curTime;
+    else if (curTime >= startTime + time) done = true;
+    return done;
+}
+
+bool ExitCondition::update(const float input, const float velocity) {
+    const bool hadRate = lastTime != -1;
+    update(input);
+    if (settleVelocity <= 0) return done;
+    // settled once stopped inside the range, checked against both the input and the measurement
+    const bool settled = hadRate && std::fabs(input) <= range && std::fabs(rate) <= settleVelocity &&
+                         std::fabs(velocity) <= settleVelocity;
+    if (!settled) settleStartTime = -1;
+    else if (settleStartTime == -1) settleStartTime = lastTime;
+    else if (lastTime >= settleStartTime + SETTLE_TIME) done = true;
+    return done;
+}
+
+float ExitCondition::predict(const float input, const int time) const { return input + rate * time / 1000; }
+
+void ExitCondition::reset() {
+    startTime = -1;
+    settleStartTime = -1;
+    lastTime = -1;
+    rate = 0;
+    done = false;
+}
+} // namespace lemlib
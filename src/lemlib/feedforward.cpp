@@ -0,0 +1,56 @@
+#include <array>
+#include <cmath>
+#include "lemlib/feedforward.hpp"
+
+namespace lemlib {
+Feedforward::Feedforward(float kS, float kV, float kA)
+    : kS(kS),
+      kV(kV),
+      kA(kA) {}
+
+float Feedforward::calculate(float velocity, float acceleration) const {
+    const float sign = velocity > 0 ? 1 : velocity < 0 ? -1 : 0;
+    return kS * sign + kV * velocity + kA * acceleration;
+}
+
+std::optional<Feedforward> fitFeedforward(std::span<const CharacterizationSample> samples, float minVelocity) {
+    // normal equations of voltage = [sign(v), v, a] . [kS, kV, kA], accumulated in double since
+    // velocity squared sums get large
+    std::array<std::array<double, 3>, 3> normal {};
+    std::array<double, 3> rhs {};
+    std::size_t used = 0;
+    for (const CharacterizationSample& sample : samples) {
+        if (std::fabs(sample.velocity) < minVelocity) continue;
+        const std::array<double, 3> row = {sample.velocity > 0 ? 1.0 : -1.0, sample.velocity, sample.acceleration};
+        for (int i = 0; i < 3; i++) {
+            for (int j = 0; j < 3; j++) normal[i][j] += row[i] * row[j];
+            rhs[i] += row[i] * sample.voltage;
+        }
+        used++;
+    }
+    if (used < 3) return std::nullopt;
+
+    // gaussian elimination with partial pivoting
+    for (int column = 0; column < 3; column++) {
+        int pivot = column;
+        for (int row = column + 1; row < 3; row++)
+            if (std::fabs(normal[row][column]) > std::fabs(normal[pivot][column])) pivot = row;
+        // relative to the diagonal, so samples in any units are judged the same
+        if (std::fabs(normal[pivot][column]) < 1e-9 * (std::fabs(normal[column][column]) + 1)) return std::nullopt;
+        std::swap(normal[pivot], normal[column]);
+        std::swap(rhs[pivot], rhs[column]);
+        for (int row = column + 1; row < 3; row++) {
+            const double factor = normal[row][column] / normal[column][column];
+            for (int k = column; k < 3; k++) normal[row][k] -= factor * normal[column][k];
+            rhs[row] -= factor * rhs[column];
+        }
+    }
+    std::array<double, 3> gains {};
+    for (int row = 2; row >= 0; row--) {
+        double sum = rhs[row];
+        for (int k = row + 1; k < 3; k++) sum -= normal[row][k] * gains[k];
+        gains[row] = sum / normal[row][row];
+    }
+    return Feedforward(gains[0], gains[1], gains[2]);
+}
+} // namespace lemlib
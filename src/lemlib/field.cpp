@@ -0,0 +1,21 @@
+#include <cmath>
+#include "lemlib/field.hpp"
+
+float lemlib::rayCast(float x, float y, float theta, std::span<const Segment> segments, float maxRange) {
+    const float dx = std::sin(theta);
+    const float dy = std::cos(theta);
+    float closest = maxRange;
+    for (const Segment& segment : segments) {
+        // solve origin + t * direction = start + u * (end - start)
+        const float ex = segment.x2 - segment.x1;
+        const float ey = segment.y2 - segment.y1;
+        const float denominator = dx * ey - dy * ex;
+        if (std::fabs(denominator) < 1e-6f) continue; // parallel
+        const float ox = segment.x1 - x;
+        const float oy = segment.y1 - y;
+        const float t = (ox * ey - oy * ex) / denominator;
+        const float u = (ox * dy - oy * dx) / denominator;
+        if (t >= 0 && t < closest && u >= 0 && u <= 1) closest = t;
+    }
+    return closest;
+}
@@ -0,0 +1,28 @@
+#include "lemlib/logger/baseSink.hpp"
+
+namespace lemlib {
+BaseSink::BaseSink(std::initializer_list<std::shared_ptr<BaseSink>> sinks)
+    : sinks(sinks) {}
+
+void BaseSink::setLowestLevel(Level level) {
+    if (!sinks.empty()) {
+        for (std::shared_ptr<BaseSink> sink : sinks) { sink->setLowestLevel(level); }
+        return;
+    }
+
+    lowestLevel = level;
+}
+
+void BaseSink::setFormat(const std::string& format) {
+    if (!sinks.empty()) {
+        for (std::shared_ptr<BaseSink> sink : sinks) { sink->setFormat(format); }
+        return;
+    }
+
+    logFormat = format;
+}
+
+void BaseSink::sendMessage(const Message&) {}
+
+fmt::dynamic_format_arg_store<fmt::format_context> BaseSink::getExtraFormattingArgs(const Message&) { return {}; }
+} // namespace lemlib
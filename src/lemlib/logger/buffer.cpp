@@ -0,0 +1,32 @@
+#include "lemlib/logger/buffer.hpp"
+
+namespace lemlib {
+Buffer::Buffer(std::function<void(const std::string&)> bufferFunc)
+    : bufferFunc(bufferFunc),
+      task([=, this] { taskLoop(); }),
+      rate(50) {}
+
+Buffer::~Buffer() { task.remove(); }
+
+void Buffer::pushToBuffer(const std::string& bufferData) {
+    mutex.take();
+    buffer.push_back(bufferData);
+    mutex.give();
+}
+
+void Buffer::taskLoop() {
+    while (true) {
+        mutex.take();
+        if (buffer.size() > 0) {
+            bufferFunc(buffer.at(0));
+            buffer.pop_front();
+        }
+        mutex.give();
+        pros::delay(rate);
+    }
+}
+
+bool Buffer::buffersEmpty() { return buffer.size() == 0; }
+
+void Buffer::setRate(uint32_t rate) { this->rate = rate; }
+} // namespace lemlib
@@ -0,0 +1,11 @@
+#include "lemlib/logger/infoSink.hpp"
+#include "lemlib/logger/stdout.hpp"
+
+namespace lemlib {
+InfoSink::InfoSink()
+    : BaseSink() {
+    setFormat("[LemLib] {level}: {message}");
+}
+
+void InfoSink::sendMessage(const Message& message) { bufferedStdout().print("{}\n", message.message); }
+} // namespace lemlib
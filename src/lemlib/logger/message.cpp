@@ -0,0 +1,12 @@
+#include "lemlib/logger/message.hpp"
+
+std::string lemlib::format_as(lemlib::Level level) {
+    switch (level) {
+        case lemlib::Level::DEBUG: return "DEBUG";
+        case lemlib::Level::INFO: return "INFO";
+        case lemlib::Level::WARN: return "WARN";
+        case lemlib::Level::ERROR: return "ERROR";
+        case lemlib::Level::FATAL: return "FATAL";
+        default: return "UNKNOWN";
+    }
+}
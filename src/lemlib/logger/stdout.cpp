@@ -0,0 +1,15 @@
+#include <iostream>
+#include "lemlib/logger/stdout.hpp"
+
+namespace lemlib {
+BufferedStdout::BufferedStdout()
+    : Buffer([](const std::string& text) { std::cout << text << std::flush; }) {
+    // the V5 serial connection drops output if it is written too quickly
+    setRate(5);
+}
+
+BufferedStdout& bufferedStdout() {
+    static BufferedStdout bufferedStdout;
+    return bufferedStdout;
+}
+} // namespace lemlib
@@ -0,0 +1,15 @@
+#include "lemlib/logger/telemetrySink.hpp"
+#include "lemlib/logger/stdout.hpp"
+
+namespace lemlib {
+TelemetrySink::TelemetrySink()
+    : BaseSink() {
+    setFormat("{message}");
+    setLowestLevel(Level::DEBUG);
+}
+
+void TelemetrySink::sendMessage(const Message& message) {
+    // wrap the message in escape codes so the terminal can tell it apart from regular output
+    bufferedStdout().print("\033[s{}\033[u\033[0J", message.message);
+}
+} // namespace lemlib
@@ -0,0 +1,44 @@
+#include <algorithm>
+#include "lemlib/motorGroup.hpp"
+
+namespace lemlib {
+namespace {
+/**
+ * @brief Call read(index) for every motor that fits in the buffer
+ */
+template <typename T, typename F> std::span<T> readEach(const pros::MotorGroup& motors, std::span<T> buffer, F read) {
+    const std::size_t count = std::min<std::size_t>(motors.size(), buffer.size());
+    for (std::size_t i = 0; i < count; i++) buffer[i] = read(i);
+    return buffer.first(count);
+}
+} // namespace
+
+std::span<double> getPositions(const pros::MotorGroup& motors, std::span<double> buffer) {
+    return readEach(motors, buffer, [&](std::uint8_t i) { return motors.get_position(i); });
+}
+
+std::span<std::int32_t> getRawPositions(const pros::MotorGroup& motors, std::span<std::int32_t> buffer,
+                                        std::uint32_t* timestamp) {
+    std::uint32_t oldest = UINT32_MAX;
+    const std::span<std::int32_t> positions = readEach(motors, buffer, [&](std::uint8_t i) {
+        std::uint32_t time;
+        const std::int32_t position = motors.get_raw_position(&time, i);
+        oldest = std::min(oldest, time);
+        return position;
+    });
+    if (timestamp != nullptr) *timestamp = positions.empty() ? 0 : oldest;
+    return positions;
+}
+
+std::span<pros::MotorGears> getGearings(const pros::MotorGroup& motors, std::span<pros::MotorGears> buffer) {
+    return readEach(motors, buffer, [&](std::uint8_t i) { return motors.get_gearing(i); });
+}
+
+std::span<double> getVelocities(const pros::MotorGroup& motors, std::span<double> buffer) {
+    return readEach(motors, buffer, [&](std::uint8_t i) { return motors.get_actual_velocity(i); });
+}
+
+std::span<std::int32_t> getVoltages(const pros::MotorGroup& motors, std::span<std::int32_t> buffer) {
+    return readEach(motors, buffer, [&](std::uint8_t i) { return motors.get_voltage(i); });
+}
+} // namespace lemlib
@@ -0,0 +1,240 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "lemlib/mpc.hpp"
+
+namespace lemlib {
+namespace {
+// ADMM step parameters, the usual defaults of OSQP
+constexpr float SIGMA = 1e-6;
+constexpr float RELAXATION = 1.6;
+constexpr float INF = std::numeric_limits<float>::infinity();
+
+float sign(float value) { return value > 0 ? 1 : value < 0 ? -1 : 0; }
+
+/**
+ * @brief Solve L * L' * x = b in place, with L the lower cholesky factor
+ */
+template <int N> void choleskySolve(const std::array<float, N * N>& factor, std::array<float, N>& b) {
+    for (int i = 0; i < N; i++) {
+        float sum = b[i];
+        for (int k = 0; k < i; k++) sum -= factor[i * N + k] * b[k];
+        b[i] = sum / factor[i * N + i];
+    }
+    for (int i = N - 1; i >= 0; i--) {
+        float sum = b[i];
+        for (int k = i + 1; k < N; k++) sum -= factor[k * N + i] * b[k];
+        b[i] = sum / factor[i * N + i];
+    }
+}
+} // namespace
+
+DriveMpc::DriveMpc(const DriveFeedforward& model, const MpcSettings& settings, float period)
+    : settings(settings),
+      period(period) {
+    // discretize kA * a = V - kS * sign(v) - kV * v over one period
+    const std::array<const Feedforward*, 2> gains = {&model.left, &model.right};
+    for (int s = 0; s < 2; s++) {
+        Side& side = sides[s];
+        const float kA = std::max(gains[s]->kA, 1e-4f);
+        const float kV = gains[s]->kV;
+        side.decay = kV > 0 ? std::exp(-kV / kA * period) : 1;
+        side.gain = kV > 0 ? (1 - side.decay) / kV : period / kA;
+        side.kS = gains[s]->kS;
+        side.response.fill(0);
+        for (int i = 0; i < HORIZON; i++)
+            for (int j = 0; j <= i; j++) side.response[i * HORIZON + j] = std::pow(side.decay, i - j) * side.gain;
+    }
+
+    // cost of velocity error and of changes between commands, as 1/2 u' * cost * u
+    for (int s = 0; s < 2; s++) {
+        const Side& side = sides[s];
+        const int o = s * HORIZON;
+        for (int j = 0; j < HORIZON; j++) {
+            for (int k = 0; k < HORIZON; k++) {
+                float sum = 0;
+                for (int i = std::max(j, k); i < HORIZON; i++)
+                    sum += side.response[i * HORIZON + j] * side.response[i * HORIZON + k];
+                cost[(o + j) * COMMANDS + o + k] = 2 * settings.velocityWeight * sum;
+            }
+            // differences between neighbouring commands, the first against the last command applied
+            cost[(o + j) * COMMANDS + o + j] += 2 * settings.smoothingWeight * (j < HORIZON - 1 ? 2 : 1);
+            if (j > 0) {
+                cost[(o + j) * COMMANDS + o + j - 1] -= 2 * settings.smoothingWeight;
+                cost[(o + j - 1) * COMMANDS + o + j] -= 2 * settings.smoothingWeight;
+            }
+        }
+    }
+
+    // voltages, then the change in velocity of each wheel over each period, then of the angular velocity
+    for (int c = 0; c < COMMANDS; c++) constraints[c * COMMANDS + c] = 1;
+    for (int s = 0; s < 2; s++) {
+        const Side& side = sides[s];
+        for (int i = 0; i < HORIZON; i++) {
+            for (int j = 0; j <= i; j++) {
+                const float change =
+                    side.response[i * HORIZON + j] - (i > 0 ? side.response[(i - 1) * HORIZON + j] : 0);
+                constraints[(COMMANDS + s * HORIZON + i) * COMMANDS + s * HORIZON + j] = change;
+                constraints[(2 * COMMANDS + i) * COMMANDS + s * HORIZON + j] =
+                    (s == 0 ? -change : change) / settings.trackWidth;
+            }
+        }
+    }
+    // scale every row to unit length, so the solver treats each constraint alike
+    for (int r = 0; r < CONSTRAINTS; r++) {
+        float norm = 0;
+        for (int c = 0; c < COMMANDS; c++) norm += constraints[r * COMMANDS + c] * constraints[r * COMMANDS + c];
+        rowScale[r] = 1 / std::sqrt(norm);
+        for (int c = 0; c < COMMANDS; c++) constraints[r * COMMANDS + c] *= rowScale[r];
+    }
+
+    // step size on the scale of the cost
+    float trace = 0;
+    for (int c = 0; c < COMMANDS; c++) trace += cost[c * COMMANDS + c];
+    rho = trace / COMMANDS;
+
+    // factor cost + sigma * I + rho * constraints' * constraints once, it never changes
+    for (int i = 0; i < COMMANDS; i++) {
+        for (int j = 0; j <= i; j++) {
+            float sum = cost[i * COMMANDS + j] + (i == j ? SIGMA : 0);
+            for (int r = 0; r < CONSTRAINTS; r++)
+                sum += rho * constraints[r * COMMANDS + i] * constraints[r * COMMANDS + j];
+            for (int k = 0; k < j; k++) sum -= factor[i * COMMANDS + k] * factor[j * COMMANDS + k];
+            factor[i * COMMANDS + j] = i == j ? std::sqrt(sum) : sum / factor[j * COMMANDS + j];
+        }
+    }
+}
+
+MpcSolution DriveMpc::solve(float leftVelocity, float rightVelocity, std::span<const float, HORIZON> leftReference,
+                            std::span<const float, HORIZON> rightReference) {
+    const std::array<float, 2> velocities = {leftVelocity, rightVelocity};
+    const std::array<std::span<const float, HORIZON>, 2> references = {leftReference, rightReference};
+
+    // start cold from the voltages the model says track the reference
+    if (!warm) {
+        for (int s = 0; s < 2; s++) {
+            const Side& side = sides[s];
+            for (int j = 0; j < HORIZON; j++) {
+                const float target = references[s][j];
+                const float previous = j > 0 ? references[s][j - 1] : velocities[s];
+                commands[s * HORIZON + j] = std::clamp(
+                    (target - side.decay * previous) / side.gain + side.kS * sign(target), -settings.maxVoltage,
+                    settings.maxVoltage);
+            }
+            lastCommand[s] = commands[s * HORIZON];
+        }
+        y.fill(0);
+    } else {
+        // shift the last solution along by one period
+        for (int block = 0; block < CONSTRAINTS / HORIZON; block++) {
+            for (int j = 0; j < HORIZON - 1; j++) {
+                if (block < 2) commands[block * HORIZON + j] = commands[block * HORIZON + j + 1];
+                y[block * HORIZON + j] = y[block * HORIZON + j + 1];
+            }
+        }
+        // the last period wasn't planned before, so start it from the model like a cold start
+        for (int s = 0; s < 2; s++) {
+            const Side& side = sides[s];
+            const float target = references[s][HORIZON - 1];
+            commands[s * HORIZON + HORIZON - 1] =
+                std::clamp((target - side.decay * references[s][HORIZON - 2]) / side.gain + side.kS * sign(target),
+                           -settings.maxVoltage, settings.maxVoltage);
+        }
+    }
+
+    // velocity each wheel would have with no voltage, and the linear cost around it
+    std::array<float, COMMANDS> linear {};
+    std::array<float, COMMANDS> change {}; // change in free velocity over each period
+    for (int s = 0; s < 2; s++) {
+        const Side& side = sides[s];
+        std::array<float, HORIZON> error;
+        float free = velocities[s];
+        for (int i = 0; i < HORIZON; i++) {
+            const float next = side.decay * free - side.gain * side.kS * sign(references[s][i]);
+            change[s * HORIZON + i] = next - free;
+            free = next;
+            error[i] = free - references[s][i];
+        }
+        for (int j = 0; j < HORIZON; j++) {
+            float sum = 0;
+            for (int i = j; i < HORIZON; i++) sum += side.response[i * HORIZON + j] * error[i];
+            linear[s * HORIZON + j] = 2 * settings.velocityWeight * sum;
+        }
+        linear[s * HORIZON] -= 2 * settings.smoothingWeight * lastCommand[s];
+    }
+
+    // bounds of each constraint row, scaled like the rows
+    std::array<float, CONSTRAINTS> lower;
+    std::array<float, CONSTRAINTS> upper;
+    const float maxChange = settings.maxAcceleration > 0 ? settings.maxAcceleration * period : INF;
+    const float maxAngularChange = settings.maxAngularAcceleration > 0 ? settings.maxAngularAcceleration * period : INF;
+    for (int c = 0; c < COMMANDS; c++) {
+        lower[c] = -settings.maxVoltage;
+        upper[c] = settings.maxVoltage;
+        lower[COMMANDS + c] = (-maxChange - change[c]) * rowScale[COMMANDS + c];
+        upper[COMMANDS + c] = (maxChange - change[c]) * rowScale[COMMANDS + c];
+    }
+    for (int i = 0; i < HORIZON; i++) {
+        const int r = 2 * COMMANDS + i;
+        const float free = (change[HORIZON + i] - change[i]) / settings.trackWidth;
+        lower[r] = (-maxAngularChange - free) * rowScale[r];
+        upper[r] = (maxAngularChange - free) * rowScale[r];
+    }
+
+    const auto multiply = [&](const std::array<float, COMMANDS>& x, std::array<float, CONSTRAINTS>& out) {
+        for (int r = 0; r < CONSTRAINTS; r++) {
+            float sum = 0;
+            for (int c = 0; c < COMMANDS; c++) sum += constraints[r * COMMANDS + c] * x[c];
+            out[r] = sum;
+        }
+    };
+    std::array<float, CONSTRAINTS> product; // constraints * commands
+    multiply(commands, product);
+    // z starts consistent with the commands. The bounds moved with the velocities, so the last z is stale
+    z = product;
+    for (int r = 0; r < CONSTRAINTS; r++) z[r] = std::clamp(z[r], lower[r], upper[r]);
+
+    // ADMM, as in OSQP
+    int iteration = 0;
+    bool converged = false;
+    while (iteration < settings.maxIterations && !converged) {
+        iteration++;
+        std::array<float, COMMANDS> rhs;
+        for (int c = 0; c < COMMANDS; c++) {
+            float sum = SIGMA * commands[c] - linear[c];
+            for (int r = 0; r < CONSTRAINTS; r++) sum += constraints[r * COMMANDS + c] * (rho * z[r] - y[r]);
+            rhs[c] = sum;
+        }
+        choleskySolve<COMMANDS>(factor, rhs);
+        std::array<float, CONSTRAINTS> tilde;
+        multiply(rhs, tilde);
+
+        float primal = 0;
+        std::array<float, CONSTRAINTS> step; // change in z, for the dual residual
+        for (int c = 0; c < COMMANDS; c++) commands[c] = RELAXATION * rhs[c] + (1 - RELAXATION) * commands[c];
+        for (int r = 0; r < CONSTRAINTS; r++) {
+            const float relaxed = RELAXATION * tilde[r] + (1 - RELAXATION) * z[r];
+            const float next = std::clamp(relaxed + y[r] / rho, lower[r], upper[r]);
+            y[r] += rho * (relaxed - next);
+            step[r] = next - z[r];
+            z[r] = next;
+            product[r] = RELAXATION * tilde[r] + (1 - RELAXATION) * product[r];
+            primal = std::max(primal, std::fabs(product[r] - z[r]));
+        }
+        float dual = 0;
+        for (int c = 0; c < COMMANDS; c++) {
+            float sum = 0;
+            for (int r = 0; r < CONSTRAINTS; r++) sum += constraints[r * COMMANDS + c] * step[r];
+            dual = std::max(dual, std::fabs(rho * sum));
+        }
+        converged = primal < settings.tolerance && dual < settings.tolerance;
+    }
+
+    warm = true;
+    lastCommand[0] = std::clamp(commands[0], -settings.maxVoltage, settings.maxVoltage);
+    lastCommand[1] = std::clamp(commands[HORIZON], -settings.maxVoltage, settings.maxVoltage);
+    return {lastCommand[0], lastCommand[1], iteration, converged};
+}
+
+void DriveMpc::reset() { warm = false; }
+} // namespace lemlib
@@ -0,0 +1,89 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include "lemlib/pathCursor.hpp"
+
+namespace lemlib {
+float circleIntersect(Pose start, Pose end, Pose center, float radius) {
+    // uses the quadratic formula to calculate intersection points
+    const Pose d = end - start;
+    const Pose f = start - center;
+    const float a = d * d;
+    const float b = 2 * (f * d);
+    const float c = (f * f) - radius * radius;
+    float discriminant = b * b - 4 * a * c;
+
+    // if a possible intersection was found
+    if (discriminant >= 0) {
+        discriminant = std::sqrt(discriminant);
+        const float t1 = (-b - discriminant) / (2 * a);
+        const float t2 = (-b + discriminant) / (2 * a);
+
+        // prioritize further down the path
+        if (t2 >= 0 && t2 <= 1) return t2;
+        else if (t1 >= 0 && t1 <= 1) return t1;
+    }
+
+    // no intersection found
+    return -1;
+}
+
+PathCursor::PathCursor(std::span<const Pose> path, float lookahead)
+    : path(path),
+      distances(path.size()),
+      lookahead(lookahead),
+      lookaheadPoint(path.empty() ? Pose(0, 0) : Pose(path[0].x, path[0].y)) {
+    for (std::size_t i = 1; i < path.size(); i++) distances[i] = distances[i - 1] + path[i].distance(path[i - 1]);
+}
+
+PathCursor::PathCursor(std::span<const TrajectorySample> samples, float lookahead)
+    : samples(samples),
+      distances(samples.size()),
+      lookahead(lookahead),
+      lookaheadPoint(samples.empty() ? Pose(0, 0) : Pose(samples[0].x, samples[0].y)) {
+    for (std::size_t i = 0; i < samples.size(); i++) distances[i] = samples[i].distance;
+}
+
+void PathCursor::update(const Pose& pose) {
+    const int last = int(distances.size()) - 1;
+    if (last < 0) return;
+
+    // the robot doesn't get a whole lookahead distance further along the path in one tick
+    const float closestWindow = distances[closest] + lookahead;
+    float closestDist = std::numeric_limits<float>::infinity();
+    for (int i = closest; i <= last && distances[i] <= closestWindow; i++) {
+        const Pose point = this->point(i);
+        const float dist = std::hypot(pose.x - point.x, pose.y - point.y);
+        if (dist < closestDist) {
+            closestDist = dist;
+            closest = i;
+        }
+    }
+
+    // the lookahead circle can't reach a point more than a lookahead distance along the path from
+    // the closest one, with the same again as slack for the robot being off the path
+    const float lookaheadWindow = distances[closest] + 2 * lookahead;
+    for (int i = std::max(closest, int(lookaheadPoint.theta)); i < last && distances[i] <= lookaheadWindow; i++) {
+        const Pose start = point(i);
+        const Pose end = point(i + 1);
+        const float t = circleIntersect(start, end, pose, lookahead);
+        if (t != -1) {
+            lookaheadPoint = start.lerp(end, t);
+            lookaheadPoint.theta = i;
+            return;
+        }
+    }
+    // robot deviated from path, keep the last lookahead point
+}
+
+int PathCursor::getClosest() const { return closest; }
+
+Pose PathCursor::getLookahead() const { return lookaheadPoint; }
+
+float PathCursor::getDistance(int index) const { return distances[index]; }
+
+Pose PathCursor::point(int index) const {
+    if (!samples.empty()) return Pose(samples[index].x, samples[index].y);
+    return Pose(path[index].x, path[index].y);
+}
+} // namespace lemlib
@@ -0,0 +1,104 @@
+#include <cmath>
+#include <utility>
+#include "lemlib/profile.hpp"
+
+namespace lemlib {
+namespace {
+/**
+ * @brief Time spent at full jerk and at full acceleration to go from rest to a velocity
+ *
+ * @return std::pair<float, float> time ramping the acceleration in (and out again), and time at
+ * the peak acceleration between the ramps
+ */
+std::pair<float, float> accelerationTimes(float velocity, const ProfileConstraints& constraints) {
+    const float maxAcceleration = constraints.maxAcceleration;
+    if (constraints.maxJerk <= 0) return {0, velocity / maxAcceleration};
+    const float jerkTime = maxAcceleration / constraints.maxJerk;
+    // too slow to reach the peak acceleration before ramping back out
+    if (velocity * constraints.maxJerk < maxAcceleration * maxAcceleration)
+        return {std::sqrt(velocity / constraints.maxJerk), 0};
+    return {jerkTime, velocity / maxAcceleration - jerkTime};
+}
+
+/**
+ * @brief Distance covered going from rest to a velocity
+ *
+ * The acceleration is symmetric about its midpoint, so the average velocity is half the final one
+ */
+float accelerationDistance(float velocity, const ProfileConstraints& constraints) {
+    const auto [jerkTime, constantTime] = accelerationTimes(velocity, constraints);
+    return velocity * (2 * jerkTime + constantTime) / 2;
+}
+} // namespace
+
+MotionProfile::MotionProfile(float distance, const ProfileConstraints& constraints)
+    : distance(distance),
+      sign(distance < 0 ? -1 : 1) {
+    const float length = std::fabs(distance);
+    // find the fastest velocity the profile can reach and still stop in time
+    float peak = constraints.maxVelocity;
+    if (2 * accelerationDistance(peak, constraints) > length) {
+        if (constraints.maxJerk <= 0) {
+            peak = std::sqrt(length * constraints.maxAcceleration);
+        } else {
+            // the acceleration distance grows with velocity, so bisect
+            float low = 0;
+            float high = peak;
+            for (int i = 0; i < 32; i++) {
+                const float middle = (low + high) / 2;
+                if (2 * accelerationDistance(middle, constraints) > length) high = middle;
+                else low = middle;
+            }
+            peak = low;
+        }
+    }
+    const auto [jerkTime, constantTime] = accelerationTimes(peak, constraints);
+    const float cruiseTime = peak > 0 ? (length - 2 * accelerationDistance(peak, constraints)) / peak : 0;
+    const float jerk = constraints.maxJerk;
+    // acceleration at the peak, which falls short of the maximum on short S-curves
+    const float acceleration = jerk > 0 ? jerk * jerkTime : constraints.maxAcceleration;
+
+    // zero length phases are skipped when sampling, so the trapezoid is the S-curve without its ramps
+    addPhase(jerkTime, 0, jerk);
+    addPhase(constantTime, acceleration, 0);
+    addPhase(jerkTime, acceleration, -jerk);
+    addPhase(cruiseTime, 0, 0);
+    addPhase(jerkTime, 0, -jerk);
+    addPhase(constantTime, -acceleration, 0);
+    addPhase(jerkTime, -acceleration, jerk);
+}
+
+void MotionProfile::addPhase(float duration, float acceleration, float jerk) {
+    Phase phase {.start = this->duration, .jerk = jerk};
+    if (phaseCount > 0) {
+        // where the previous phase ends
+        const Phase& previous = phases[phaseCount - 1];
+        const float t = phase.start - previous.start;
+        const ProfileState& state = previous.state;
+        phase.state.position = state.position + state.velocity * t + state.acceleration * t * t / 2 +
+                               previous.jerk * t * t * t / 6;
+        phase.state.velocity = state.velocity + state.acceleration * t + previous.jerk * t * t / 2;
+    }
+    phase.state.acceleration = acceleration;
+    phases[phaseCount++] = phase;
+    this->duration += duration;
+}
+
+ProfileState MotionProfile::sample(float time) const {
+    if (time >= duration) return {distance, 0, 0};
+    if (time <= 0) return {0, 0, 0};
+    // seven phases, so a linear search is as fast as anything
+    std::size_t i = 0;
+    while (i + 1 < phaseCount && phases[i + 1].start <= time) i++;
+    const Phase& phase = phases[i];
+    const float t = time - phase.start;
+    const ProfileState& state = phase.state;
+    return {sign * (state.position + state.velocity * t + state.acceleration * t * t / 2 + phase.jerk * t * t * t / 6),
+            sign * (state.velocity + state.acceleration * t + phase.jerk * t * t / 2),
+            sign * (state.acceleration + phase.jerk * t)};
+}
+
+float MotionProfile::getDuration() const { return duration; }
+
+float MotionProfile::getDistance() const { return distance; }
+} // namespace lemlib
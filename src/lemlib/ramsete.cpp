@@ -0,0 +1,25 @@
+#include <cmath>
+#include "lemlib/ramsete.hpp"
+#include "lemlib/trig.hpp"
+#include "lemlib/util.hpp"
+
+namespace lemlib {
+Ramsete::Ramsete(float b, float zeta)
+    : b(b),
+      zeta(zeta) {}
+
+std::pair<float, float> Ramsete::calculate(const Pose& pose, const Pose& reference, float velocity,
+                                           float angularVelocity) const {
+    // error in the robot's frame, x forwards and y to the left
+    const auto [sin, cos] = fastSinCos(pose.theta);
+    const float dx = reference.x - pose.x;
+    const float dy = reference.y - pose.y;
+    const float errorX = cos * dx + sin * dy;
+    const float errorY = -sin * dx + cos * dy;
+    const float errorTheta = angleError(reference.theta, pose.theta);
+
+    const float k = 2 * zeta * std::sqrt(angularVelocity * angularVelocity + b * velocity * velocity);
+    return {velocity * fastCos(errorTheta) + k * errorX,
+            angularVelocity + k * errorTheta + b * velocity * fastSinc(errorTheta) * errorY};
+}
+} // namespace lemlib
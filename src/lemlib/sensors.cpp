@@ -0,0 +1,226 @@
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include "lemlib/sensors.hpp"
+
+namespace lemlib {
+namespace {
+// how often the acquisition task wakes up, in milliseconds
+constexpr std::uint32_t TICK = 5;
+// how often each kind of device refreshes its readings, in milliseconds
+constexpr std::uint32_t MOTOR_PERIOD = 10;
+constexpr std::uint32_t IMU_PERIOD = 10;
+constexpr std::uint32_t DISTANCE_PERIOD = 30;
+// the optical sensor's default integration time, for one that can't report its own
+constexpr std::uint32_t OPTICAL_PERIOD = 100;
+constexpr std::uint32_t CONTROLLER_PERIOD = 10;
+constexpr std::uint32_t BATTERY_PERIOD = 10;
+
+/**
+ * @brief Round a period up to a whole number of ticks, and to at least one
+ */
+std::uint32_t toTicks(double period) { return std::fmax(1, std::ceil(period / TICK)) * TICK; }
+} // namespace
+
+SensorScheduler::SensorScheduler()
+    : front(SensorFrame {}) {}
+
+void SensorScheduler::add(const Source& source) {
+    if (sourceCount < MAX_SOURCES) sources[sourceCount++] = source;
+}
+
+void SensorScheduler::addMotor(pros::Motor* motor) {
+    back.motors[std::abs(motor->get_port()) - 1].gearing = motor->get_gearing();
+    add({.kind = Kind::MOTOR, .motor = motor, .port = std::uint8_t(std::abs(motor->get_port())),
+         .period = MOTOR_PERIOD});
+}
+
+void SensorScheduler::addMotors(pros::MotorGroup* motors) {
+    for (std::uint8_t i = 0; i < motors->size(); i++) {
+        const std::uint8_t port = std::abs(motors->get_port(i));
+        back.motors[port - 1].gearing = motors->get_gearing(i);
+        add({.kind = Kind::MOTOR, .motor = motors, .index = i, .port = port, .period = MOTOR_PERIOD});
+    }
+}
+
+void SensorScheduler::addImu(pros::Imu* imu) {
+    add({.kind = Kind::IMU, .imu = imu, .port = imu->get_port(), .period = IMU_PERIOD});
+}
+
+void SensorScheduler::addRotation(pros::Rotation* rotation, std::uint32_t period) {
+    period = toTicks(period);
+    rotation->set_data_rate(period);
+    add({.kind = Kind::ROTATION, .rotation = rotation, .port = rotation->get_port(), .period = period});
+}
+
+void SensorScheduler::addDistance(pros::Distance* distance) {
+    add({.kind = Kind::DISTANCE, .distance = distance, .port = distance->get_port(), .period = DISTANCE_PERIOD});
+}
+
+void SensorScheduler::addOptical(pros::Optical* optical) {
+    // PROS_ERR_F, infinity, if the sensor is unplugged or on the wrong port
+    double integrationTime = optical->get_integration_time();
+    if (!std::isfinite(integrationTime)) integrationTime = OPTICAL_PERIOD;
+    add({.kind = Kind::OPTICAL, .optical = optical, .port = optical->get_port(), .period = toTicks(integrationTime)});
+}
+
+void SensorScheduler::addController(pros::Controller* controller, pros::controller_id_e_t id) {
+    add({.kind = Kind::CONTROLLER, .controller = controller, .index = std::uint8_t(id == pros::E_CONTROLLER_PARTNER),
+         .period = CONTROLLER_PERIOD});
+}
+
+void SensorScheduler::addBattery(float timeConstant) {
+    batteryTimeConstant = timeConstant;
+    add({.kind = Kind::BATTERY, .period = BATTERY_PERIOD});
+}
+
+void SensorScheduler::start() {
+    if (task != nullptr) return;
+    // one priority above odometry, so a frame is ready by the time odometry wakes up on the same tick.
+    // Both start on a multiple of their period, so they do wake on the same ticks
+    task = new pros::Task(
+        [this] {
+            std::uint32_t now = (pros::millis() + TICK - 1) / TICK * TICK;
+            pros::delay(now - pros::millis());
+            while (true) {
+                poll(now);
+                pros::Task::delay_until(&now, TICK);
+            }
+        },
+        TASK_PRIORITY_MAX - 1, TASK_STACK_DEPTH_DEFAULT, "LemLib Sensors");
+}
+
+bool SensorScheduler::isRunning() const { return task != nullptr; }
+
+void SensorScheduler::read(Source& source, std::uint32_t time) {
+    const std::size_t i = source.port - 1;
+    switch (source.kind) {
+        case Kind::MOTOR: {
+            pros::AbstractMotor* const motor = source.motor;
+            MotorSample& sample = back.motors[i];
+            sample.rawPosition = motor->get_raw_position(&sample.positionTime, source.index);
+            sample.velocity = motor->get_actual_velocity(source.index);
+            sample.voltage = motor->get_voltage(source.index);
+            sample.current = motor->get_current_draw(source.index);
+            sample.temperature = motor->get_temperature(source.index);
+            sample.torque = motor->get_torque(source.index);
+            break;
+        }
+        case Kind::IMU: {
+            back.imus[i] = {float(source.imu->get_rotation()), float(source.imu->get_heading())};
+            break;
+        }
+        case Kind::ROTATION: {
+            back.rotations[i] = {source.rotation->get_position(), source.rotation->get_velocity()};
+            break;
+        }
+        case Kind::DISTANCE: {
+            back.distances[i] = {source.distance->get_distance(), source.distance->get_confidence()};
+            break;
+        }
+        case Kind::OPTICAL: {
+            pros::Optical* const optical = source.optical;
+            back.opticals[i] = {float(optical->get_hue()), float(optical->get_saturation()),
+                                float(optical->get_brightness()), optical->get_proximity()};
+            break;
+        }
+        case Kind::CONTROLLER: {
+            pros::Controller* const controller = source.controller;
+            ControllerSample& sample = back.controllers[source.index];
+            for (int channel = 0; channel < 4; channel++)
+                sample.analog[channel] = controller->get_analog(pros::controller_analog_e_t(channel));
+            sample.buttons = 0;
+            for (int button = pros::E_CONTROLLER_DIGITAL_L1; button <= pros::E_CONTROLLER_DIGITAL_A; button++) {
+                if (controller->get_digital(pros::controller_digital_e_t(button)))
+                    sample.buttons |= 1 << (button - pros::E_CONTROLLER_DIGITAL_L1);
+            }
+            return; // controllers don't have a port
+        }
+        case Kind::BATTERY: {
+            BatterySample& sample = back.battery;
+            const std::int32_t voltage = pros::battery::get_voltage();
+            // start the filter at the first reading instead of rising from 0
+            if (sample.voltage == 0) sample.filtered = voltage;
+            const float dt = source.read ? (time - source.lastRead) / 1000.0f : 0;
+            const float alpha = batteryTimeConstant > 0 ? 1 - std::exp(-dt / batteryTimeConstant) : 1;
+            sample.filtered += (voltage - sample.filtered) * alpha;
+            sample.voltage = voltage;
+            sample.current = pros::battery::get_current();
+            return; // the battery doesn't have a port
+        }
+    }
+    back.sampled[i] = time;
+    back.present |= 1 << i;
+}
+
+void SensorScheduler::poll(std::uint32_t time) {
+    bool changed = false;
+    for (std::size_t i = 0; i < sourceCount; i++) {
+        Source& source = sources[i];
+        if (source.read && int32_t(time - source.lastRead) < int32_t(source.period)) continue;
+        // each device is first read on a multiple of its period, so a 10 ms device is read on odometry's ticks
+        if (!source.read && time % source.period != 0) continue;
+        read(source, time);
+        source.lastRead = time;
+        source.read = true;
+        changed = true;
+    }
+    if (!changed) return;
+    back.time = time;
+    front.store(back);
+}
+
+SensorFrame SensorScheduler::getFrame() const { return front.load(); }
+
+void SensorScheduler::getFrame(SensorFrame& frame) const { front.load(frame); }
+
+template <typename U>
+U SensorScheduler::getSample(std::size_t samples, std::int8_t port, std::uint32_t* sampled) const {
+    const std::size_t i = (port < 0 ? -port : port) - 1;
+    if (sampled == nullptr) return front.loadPart<U>(samples + i * sizeof(U));
+    // the sample and its time from the same frame
+    const auto [sample, time] = front.loadParts([&](const auto& copy) {
+        std::pair<U, std::uint32_t> part;
+        copy(samples + i * sizeof(U), &part.first, sizeof(U));
+        copy(offsetof(SensorFrame, sampled) + i * sizeof(std::uint32_t), &part.second, sizeof(std::uint32_t));
+        return part;
+    });
+    *sampled = time;
+    return sample;
+}
+
+MotorSample SensorScheduler::getMotor(std::int8_t port, std::uint32_t* sampled) const {
+    return getSample<MotorSample>(offsetof(SensorFrame, motors), port, sampled);
+}
+
+ImuSample SensorScheduler::getImu(std::uint8_t port, std::uint32_t* sampled) const {
+    return getSample<ImuSample>(offsetof(SensorFrame, imus), port, sampled);
+}
+
+RotationSample SensorScheduler::getRotation(std::uint8_t port, std::uint32_t* sampled) const {
+    return getSample<RotationSample>(offsetof(SensorFrame, rotations), port, sampled);
+}
+
+DistanceSample SensorScheduler::getDistance(std::uint8_t port, std::uint32_t* sampled) const {
+    return getSample<DistanceSample>(offsetof(SensorFrame, distances), port, sampled);
+}
+
+OpticalSample SensorScheduler::getOptical(std::uint8_t port, std::uint32_t* sampled) const {
+    return getSample<OpticalSample>(offsetof(SensorFrame, opticals), port, sampled);
+}
+
+ControllerSample SensorScheduler::getController(pros::controller_id_e_t id) const {
+    return front.loadPart<ControllerSample>(offsetof(SensorFrame, controllers) +
+                                            (id == pros::E_CONTROLLER_PARTNER) * sizeof(ControllerSample));
+}
+
+BatterySample SensorScheduler::getBattery() const {
+    return front.loadPart<BatterySample>(offsetof(SensorFrame, battery));
+}
+
+bool SensorScheduler::has(std::int8_t port) const {
+    return front.loadPart<std::uint32_t>(offsetof(SensorFrame, present)) >> ((port < 0 ? -port : port) - 1) & 1;
+}
+
+std::uint32_t SensorScheduler::getVersion() const { return front.version(); }
+} // namespace lemlib
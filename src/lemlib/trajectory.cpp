@@ -0,0 +1,42 @@
+#include <cstring>
+#include "lemlib/trajectory.hpp"
+#include "lemlib/logger/logger.hpp"
+
+namespace lemlib {
+Trajectory::Trajectory(std::span<const TrajectorySample> samples)
+    : points(samples) {}
+
+std::optional<Trajectory> Trajectory::load(const asset& trajectory) {
+    if (trajectory.size < sizeof(TrajectoryHeader)) {
+        infoSink()->error("Trajectory asset is too small to have a header");
+        return std::nullopt;
+    }
+    // the header is copied, it is only a few bytes and may not be aligned
+    TrajectoryHeader header;
+    std::memcpy(&header, trajectory.buf, sizeof(header));
+    if (header.magic != TRAJECTORY_MAGIC || header.version != TRAJECTORY_VERSION ||
+        header.sampleSize != sizeof(TrajectorySample)) {
+        infoSink()->error("Asset is not a version {} trajectory, regenerate it", TRAJECTORY_VERSION);
+        return std::nullopt;
+    }
+    if (header.count == 0 || trajectory.size < sizeof(header) + header.count * sizeof(TrajectorySample)) {
+        infoSink()->error("Trajectory asset is empty or truncated");
+        return std::nullopt;
+    }
+    // the samples are read in place, and VFP loads fault on unaligned addresses. The header keeps the
+    // samples aligned as long as the asset is
+    static_assert(sizeof(TrajectoryHeader) % alignof(TrajectorySample) == 0);
+    const std::uint8_t* data = trajectory.buf + sizeof(header);
+    if (reinterpret_cast<std::uintptr_t>(trajectory.buf) % alignof(TrajectorySample) != 0) {
+        infoSink()->error("Trajectory asset is not aligned to {} bytes", alignof(TrajectorySample));
+        return std::nullopt;
+    }
+    return Trajectory({reinterpret_cast<const TrajectorySample*>(data), header.count});
+}
+
+std::span<const TrajectorySample> Trajectory::samples() const { return points; }
+
+float Trajectory::duration() const { return points.back().time; }
+
+float Trajectory::length() const { return points.back().distance; }
+} // namespace lemlib
@@ -0,0 +1,80 @@
+#include <algorithm>
+#include <cmath>
+#include "lemlib/trajectory.hpp"
+
+namespace lemlib {
+void timeParameterize(std::span<TrajectorySample> samples, const TrajectoryConstraints& constraints) {
+    if (samples.empty()) return;
+    for (TrajectorySample& sample : samples) {
+        const float k = std::fabs(sample.curvature);
+        // the outer wheel is the one that hits the velocity limit, and turning takes sideways acceleration
+        sample.velocity = constraints.maxVelocity / (1 + k * constraints.trackWidth / 2);
+        if (k > 0) sample.velocity = std::min(sample.velocity, std::sqrt(constraints.maxAcceleration / k));
+    }
+    // start and end at rest, then v^2 = u^2 + 2as both ways
+    samples.front().velocity = 0;
+    samples.back().velocity = 0;
+    for (std::size_t i = 1; i < samples.size(); i++) {
+        const float ds = samples[i].distance - samples[i - 1].distance;
+        const float u = samples[i - 1].velocity;
+        samples[i].velocity = std::min(samples[i].velocity, std::sqrt(u * u + 2 * constraints.maxAcceleration * ds));
+    }
+    for (std::size_t i = samples.size() - 1; i > 0; i--) {
+        const float ds = samples[i].distance - samples[i - 1].distance;
+        const float u = samples[i].velocity;
+        samples[i - 1].velocity =
+            std::min(samples[i - 1].velocity, std::sqrt(u * u + 2 * constraints.maxAcceleration * ds));
+    }
+
+    samples.front().time = 0;
+    for (std::size_t i = 1; i < samples.size(); i++) {
+        const float ds = samples[i].distance - samples[i - 1].distance;
+        // constant acceleration between samples, so the average velocity is the mean of the ends
+        const float average = (samples[i - 1].velocity + samples[i].velocity) / 2;
+        // a path one segment long never gets moving, accelerate for half and decelerate for half
+        samples[i].time = samples[i - 1].time +
+                          (average > 0 ? ds / average : 2 * std::sqrt(ds / constraints.maxAcceleration));
+    }
+}
+
+std::vector<TrajectorySample> generateTrajectory(const Pose& start, const Pose& end, float lead,
+                                                 const TrajectoryConstraints& constraints, int count) {
+    count = std::max(count, 2);
+    // tangents along each heading, clockwise from the y axis
+    const float length = 2 * lead * start.distance(end);
+    const float m0x = length * std::sin(start.theta);
+    const float m0y = length * std::cos(start.theta);
+    const float m1x = length * std::sin(end.theta);
+    const float m1y = length * std::cos(end.theta);
+
+    std::vector<TrajectorySample> samples(count);
+    for (int i = 0; i < count; i++) {
+        const float t = float(i) / (count - 1);
+        const float t2 = t * t;
+        const float t3 = t2 * t;
+        // hermite basis functions, and their first and second derivatives
+        const float h00 = 2 * t3 - 3 * t2 + 1, h10 = t3 - 2 * t2 + t, h01 = -2 * t3 + 3 * t2, h11 = t3 - t2;
+        const float d00 = 6 * t2 - 6 * t, d10 = 3 * t2 - 4 * t + 1, d01 = -6 * t2 + 6 * t, d11 = 3 * t2 - 2 * t;
+        const float s00 = 12 * t - 6, s10 = 6 * t - 4, s01 = -12 * t + 6, s11 = 6 * t - 2;
+        const float dx = d00 * start.x + d10 * m0x + d01 * end.x + d11 * m1x;
+        const float dy = d00 * start.y + d10 * m0y + d01 * end.y + d11 * m1y;
+        const float ddx = s00 * start.x + s10 * m0x + s01 * end.x + s11 * m1x;
+        const float ddy = s00 * start.y + s10 * m0y + s01 * end.y + s11 * m1y;
+        const float speed = std::hypot(dx, dy);
+
+        TrajectorySample& sample = samples[i];
+        sample.x = h00 * start.x + h10 * m0x + h01 * end.x + h11 * m1x;
+        sample.y = h00 * start.y + h10 * m0y + h01 * end.y + h11 * m1y;
+        // with no tangents and no distance the path is a point, keep the start heading
+        sample.heading = speed > 0 ? std::atan2(dx, dy) : start.theta;
+        // rate of change of the heading along the path, positive clockwise
+        sample.curvature = speed > 0 ? (dy * ddx - dx * ddy) / (speed * speed * speed) : 0;
+        if (i > 0) {
+            const TrajectorySample& previous = samples[i - 1];
+            sample.distance = previous.distance + std::hypot(sample.x - previous.x, sample.y - previous.y);
+        }
+    }
+    timeParameterize(samples, constraints);
+    return samples;
+}
+} // namespace lemlib
@@ -0,0 +1,40 @@
+#include <algorithm>
+#include <cmath>
+#include "lemlib/voltageCompensation.hpp"
+
+namespace lemlib {
+namespace {
+// a reading this low isn't a battery, e.g. on a field controller that doesn't report it
+constexpr float MIN_VOLTAGE = 5;
+} // namespace
+
+VoltageCompensation::VoltageCompensation(const SensorScheduler* scheduler, float nominal, float maxScale)
+    : scheduler(scheduler),
+      nominal(nominal),
+      maxScale(maxScale) {}
+
+float VoltageCompensation::getVoltage() const {
+    if (scheduler == nullptr) return nominal;
+    const float voltage = scheduler->getBattery().filtered / 1000;
+    return voltage < MIN_VOLTAGE ? nominal : voltage;
+}
+
+float VoltageCompensation::getScale() const { return std::min(nominal / getVoltage(), maxScale); }
+
+float VoltageCompensation::compensate(float command, float max) const {
+    return std::clamp(command * getScale(), -max, max);
+}
+
+std::pair<float, float> VoltageCompensation::compensateSides(float left, float right, float max) const {
+    const float scale = getScale();
+    left *= scale;
+    right *= scale;
+    // keep the ratio between the sides when either saturates
+    const float ratio = std::max(std::fabs(left), std::fabs(right)) / max;
+    if (ratio > 1) {
+        left /= ratio;
+        right /= ratio;
+    }
+    return {left, right};
+}
+} // namespace lemlib
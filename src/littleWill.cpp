@@ -1,16 +1,23 @@
 #include "main.h" // IWYU pragma: keep
 #include "littleWill.hpp"
 #include "intake.hpp"
+#include "actuators.hpp"
 
 pros::adi::DigitalOut littleWill('D', false);
 bool littleWillToggle = false;
 
+namespace {
+bool littleWillButton = false; // Y as of the last frame, to toggle on the press only
+} // namespace
+
 void setLittleWill(bool extended) {
     littleWillToggle = extended;
-    littleWill.set_value(extended);
+    actuators.set(&littleWill, extended);
 }
-void littleWillControl() {
-    if (master.get_digital_new_press(pros::E_CONTROLLER_DIGITAL_Y)) {
+void littleWillControl(const lemlib::ControllerSample& input) {
+    const bool pressed = input.held(pros::E_CONTROLLER_DIGITAL_Y);
+    if (pressed && !littleWillButton) {
         setLittleWill(!littleWillToggle);
     }
+    littleWillButton = pressed;
 }
\ No newline at end of file
@@ -3,6 +3,10 @@
 #include "intake.hpp"
 #include "littleWill.hpp"
 #include "descore.hpp"
+#include "sensors.hpp"
+#include "actuators.hpp"
+#include "blockCounter.hpp"
+#include "colorSortTask.hpp"
 #include "autons.hpp" // IWYU pragma: keep
 
 //left motor group
@@ -22,6 +26,13 @@ lemlib::Drivetrain drivetrain(&left_motor_group, // left motor group
 // imu
 pros::Imu imu(16);
 
+// sensor acquisition, started in initialize()
+lemlib::SensorScheduler sensorScheduler;
+// battery compensation for the drive and intake, from the scheduler's battery readings
+lemlib::VoltageCompensation voltageCompensation(&sensorScheduler);
+// intake and pneumatic outputs, written once per tick when they change, started in initialize()
+ActuatorCache actuators;
+
 lemlib::TrackingWheel leftTrackingWheel(&left_motor_group, lemlib::Omniwheel::NEW_325, -6, 450);
 lemlib::TrackingWheel rightTrackingWheel(&right_motor_group, lemlib::Omniwheel::NEW_325, 6, 450);
 
@@ -42,7 +53,8 @@ lemlib::ControllerSettings lateral_controller(5.8, // proportional gain (kP) //5
                                               100, // small error range timeout, in milliseconds
                                               3, // large error range, in inches
                                               500, // large error range timeout, in milliseconds
-                                              20 // maximum acceleration (slew)
+                                              20, // maximum acceleration (slew)
+                                              3 // settle velocity, in inches per second
 );
 
 // angular PID controller
@@ -54,20 +66,21 @@ lemlib::ControllerSettings angular_controller(2.0, // proportional gain (kP) 1.9
                                               100, // small error range timeout, in milliseconds
                                             3, // large error range, in degrees
                                               500, // large error range timeout, in milliseconds
-                                              0 // maximum acceleration (slew)
+                                              0, // maximum acceleration (slew)
+                                              15 // settle velocity, in degrees per second
 );
 
-// input curve for throttle input during driver control
-lemlib::ExpoDriveCurve throttle_curve(5, //joystick deadzone
-									  10, //minimum output where drivetrain will move
-									  1.02 //expo curve gain
-);
+// input curve for throttle input during driver control, an expo curve baked into a table at compile time
+constinit lemlib::LookupDriveCurve throttle_curve(lemlib::expoCurveTable(5, //joystick deadzone
+																		  10, //minimum output where drivetrain will move
+																		  1.02 //expo curve gain
+));
 
-//input curve for steer input during driver control
-lemlib::ExpoDriveCurve steer_curve(5, //joystick deadzone
-								   10, //minimum output where drivetrain will move
-								   1.015 //expo curve gain
-);
+//input curve for steer input during driver control, baked the same way
+constinit lemlib::LookupDriveCurve steer_curve(lemlib::expoCurveTable(5, //joystick deadzone
+																	   10, //minimum output where drivetrain will move
+																	   1.015 //expo curve gain
+));
 
 // create the chassis
 lemlib::Chassis chassis(drivetrain, // drivetrain settings
@@ -106,7 +119,7 @@ void rightButton() {
 void printInertialHeading() {
 	while (true) {
 		lemlib::Pose pose = chassis.getPose();
-		double heading = imu.get_heading();
+		double heading = sensorScheduler.getImu(imu.get_port()).heading;
 		std::string displayText = "X:" + std::to_string((int)pose.x) + 
 		                          " Y:" + std::to_string((int)pose.y) + 
 		                          " H:" + std::to_string((double)heading);
@@ -119,6 +132,25 @@ void printInertialHeading() {
 void initialize() {
 	pros::lcd::initialize();
 	chassis.calibrate();
+	// read every device from one task, odometry and driver control read its frames
+	sensorScheduler.addMotors(&left_motor_group);
+	sensorScheduler.addMotors(&right_motor_group);
+	sensorScheduler.addImu(&imu);
+	sensorScheduler.addMotor(&bottomIntake);
+	sensorScheduler.addMotor(&indexer);
+	sensorScheduler.addController(&master);
+	sensorScheduler.addBattery();
+	sensorScheduler.addDistance(&blockSensor);
+	sortSensor.set_integration_time(3); // the fastest the optical sensor reads
+	sortSensor.set_led_pwm(100); // light blocks the same whatever the field lighting
+	sensorScheduler.addOptical(&sortSensor);
+	sensorScheduler.start();
+	lemlib::setSensorScheduler(&sensorScheduler);
+	chassis.setVoltageCompensation(voltageCompensation);
+	actuators.start();
+	startIntakeTask(); // after the scheduler, jam detection reads its frames
+	startBlockCounter();
+	startColorSort();
 	chassis.setPose(0, 0, 0); // set initial pose to (0,0,0)
 	//pros::lcd::register_btn0_cb(centerButton);
 	//pros::lcd::register_btn1_cb(leftButton);
@@ -234,18 +266,19 @@ void opcontrol() {
 	while (true) {
 	//Controller input for driving
 		////////////////////////////////////////////////////////////
-		int leftY = master.get_analog(pros::E_CONTROLLER_ANALOG_LEFT_Y); // left joystick Y
-		int rightX = master.get_analog(pros::E_CONTROLLER_ANALOG_RIGHT_X); // right joystick X
+		const lemlib::ControllerSample input = sensorScheduler.getController(); // one read of the controller per loop
+		int leftY = input.analog[pros::E_CONTROLLER_ANALOG_LEFT_Y]; // left joystick Y
+		int rightX = input.analog[pros::E_CONTROLLER_ANALOG_RIGHT_X]; // right joystick X
 		chassis.arcade(leftY, rightX); // drive the robot with the joysticks using arcade control
 		// Intake Control
 		//////////////////////////////////////////////////////////////
-		intakeControl();
+		intakeControl(input);
 		//////////////////////////////////////////////////////////////
 		// Little Will Control
-		littleWillControl();
+		littleWillControl(input);
 		//////////////////////////////////////////////////////////////
 		// Descore Control
-		descoreControl();
+		descoreControl(input);
 		//////////////////////////////////////////////////////////////
 		
 	 pros::delay(10);                               // Run for 20 ms then update